@@ -0,0 +1,48 @@
+#include "BenchmarkRunner.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+double BenchmarkRunner::measure(const std::string& benchmarkName, const std::function<void()>& benchmarkFunction, int repetitions) {
+    double bestSeconds = std::numeric_limits<double>::max();
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        benchmarkFunction();
+        auto finish = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(finish - start).count();
+        if (seconds < bestSeconds) {
+            bestSeconds = seconds;
+        }
+    }
+    report(benchmarkName, bestSeconds * 1000.0, "ms");
+    return bestSeconds;
+}
+
+void BenchmarkRunner::report(const std::string& metricName, double value, const std::string& unit) const {
+    std::cout << "  " << std::left << std::setw(56) << metricName << std::right << std::setw(14)
+              << std::fixed << std::setprecision(3) << value << " " << unit << std::endl;
+}
+
+long BenchmarkRunner::currentResidentSetKb() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    long totalPages = 0;
+    long residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) {
+        return -1;
+    }
+    return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return -1;
+#endif
+}
+
+void BenchmarkRunner::printHeader(const std::string& groupName) const {
+    std::cout << "\033[36m" << "Benchmark group: " << groupName << "\033[0m" << std::endl;
+}
@@ -0,0 +1,1219 @@
+#include "GraphBenchmarks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BarabasiAlbertGraphGenerator.h"
+#include "BFSAlgorithm.h"
+#include "BellmanFordAlgorithm.h"
+#include "BenchmarkRunner.h"
+#include "BetweennessCentralityAlgorithm.h"
+#include "BipartiteMatchingAlgorithm.h"
+#include "DijkstraAlgorithm.h"
+#include "DirectedGraph.h"
+#include "DirectedGraphGenerator.h"
+#include "DistanceMatrix.h"
+#include "DurableGraph.h"
+#include "EdgeFileSinks.h"
+#include "EdgeSink.h"
+#include "ErdosRenyiSampler.h"
+#include "FloydWarshallAlgorithm.h"
+#include "GraphBuilder.h"
+#include "GraphColoringAlgorithm.h"
+#include "GraphLoader.h"
+#include "GridGraphGenerator.h"
+#include "JohnsonReweighting.h"
+#include "KCoreAlgorithm.h"
+#include "LouvainAlgorithm.h"
+#include "MappedGraph.h"
+#include "MaxFlowAlgorithm.h"
+#include "PageRankAlgorithm.h"
+#include "RandomGeometricGraphGenerator.h"
+#include "ReachabilityIndex.h"
+#include "RMatGraphGenerator.h"
+#include "ThreadPool.h"
+#include "TriangleCountingAlgorithm.h"
+#include "UndirectedGraph.h"
+#include "UniquePtr.h"
+#include "VersionedGraph.h"
+#include "Vertex.h"
+
+namespace graph_benchmarks {
+    // Случайный список ребер с фиксированным зерном, чтобы прогоны были сравнимы
+    std::vector<std::pair<int, int>> makeRandomEdges(int numVertices, int numEdges, unsigned seed) {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> vertexDist(0, numVertices - 1);
+        std::vector<std::pair<int, int>> edges(numEdges);
+        for (auto& edge : edges) {
+            edge.first = vertexDist(generator);
+            edge.second = vertexDist(generator);
+        }
+        return edges;
+    }
+
+    template <typename TGraph>
+    void benchmarkBuild(BenchmarkRunner& runner, const std::string& graphName, int numVertices,
+                        const std::vector<std::pair<int, int>>& edges, bool pooledVertices) {
+        std::string mode = pooledVertices ? "createVertex" : "new Vertex";
+        long rssBefore = BenchmarkRunner::currentResidentSetKb();
+        TGraph* graph = nullptr;
+
+        runner.measure(graphName + " build (" + mode + "), " + std::to_string(edges.size()) + " edges", [&]() {
+            graph = new TGraph();
+            std::vector<IVertex<int, int>*> vertices(numVertices);
+            for (int i = 0; i < numVertices; ++i) {
+                if (pooledVertices) {
+                    vertices[i] = graph->createVertex(i);
+                } else {
+                    vertices[i] = new Vertex<int, int>(i);
+                    graph->addVertex(vertices[i]);
+                }
+            }
+            for (const auto& edge : edges) {
+                graph->addEdge(vertices[edge.first], vertices[edge.second], 1);
+            }
+        });
+
+        long rssAfter = BenchmarkRunner::currentResidentSetKb();
+        if (rssBefore >= 0 && rssAfter >= 0) {
+            runner.report(graphName + " RSS growth (" + mode + ")", (rssAfter - rssBefore) / 1024.0, "MB");
+        }
+        runner.measure(graphName + " destroy (" + mode + ")", [&]() {
+            delete graph;
+        });
+    }
+
+    // Вставка ребер через типизированный API (Vertex*) и через адаптер IGraph (IVertex*)
+    template <typename TGraph>
+    void benchmarkInsertion(BenchmarkRunner& runner, const std::string& graphName, int numVertices,
+                            const std::vector<std::pair<int, int>>& edges, bool typedApi) {
+        std::string mode = typedApi ? "typed API" : "IGraph adapter";
+        TGraph graph;
+        std::vector<typename TGraph::VertexType*> vertices(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            vertices[i] = graph.createVertex(i);
+        }
+        IGraph<int, int>& adapter = graph;
+
+        double seconds = runner.measure(graphName + " edge insertion (" + mode + ")", [&]() {
+            for (const auto& edge : edges) {
+                if (typedApi) {
+                    graph.addEdge(vertices[edge.first], vertices[edge.second], 1);
+                } else {
+                    adapter.addEdge(vertices[edge.first], vertices[edge.second], 1);
+                }
+            }
+        });
+        runner.report(graphName + " insertion throughput (" + mode + ")", edges.size() / seconds / 1e6, "M edges/s");
+    }
+
+    void benchmarkEdgeInsertion() {
+        BenchmarkRunner runner;
+        runner.printHeader("Edge insertion");
+
+        const int numVertices = 1000000;
+        auto edges = makeRandomEdges(numVertices, 1000000, 44);
+        benchmarkInsertion<DirectedGraph<int, int>>(runner, "DirectedGraph", numVertices, edges, true);
+        benchmarkInsertion<DirectedGraph<int, int>>(runner, "DirectedGraph", numVertices, edges, false);
+        benchmarkInsertion<UndirectedGraph<int, int>>(runner, "UndirectedGraph", numVertices, edges, true);
+        benchmarkInsertion<UndirectedGraph<int, int>>(runner, "UndirectedGraph", numVertices, edges, false);
+    }
+
+    // Сборка целиком из списка ребер: поштучные addEdge против GraphBuilder
+    template <typename TGraph>
+    void benchmarkBuilder(BenchmarkRunner& runner, const std::string& graphName, int numVertices,
+                          const std::vector<std::pair<int, int>>& edges, bool directed) {
+        runner.measure(graphName + " incremental addEdge, " + std::to_string(edges.size()) + " edges", [&]() {
+            TGraph graph;
+            std::vector<typename TGraph::VertexType*> vertices(numVertices);
+            for (int i = 0; i < numVertices; ++i) {
+                vertices[i] = graph.createVertex(i);
+            }
+            for (const auto& edge : edges) {
+                graph.addEdge(vertices[edge.first], vertices[edge.second], 1);
+            }
+        });
+
+        std::vector<GraphBuilder<int, int>::EdgeRecord> records(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) {
+            records[i] = {edges[i].first, edges[i].second, 1};
+        }
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        runner.measure(graphName + " GraphBuilder::addEdges", [&]() {
+            builder.addEdges(records);
+        });
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            builder.setThreadPool(threads);
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            runner.measure(graphName + " GraphBuilder build (" + mode + ")", [&]() {
+                if constexpr (std::is_same_v<TGraph, DirectedGraph<int, int>>) {
+                    auto graph = builder.buildDirected();
+                } else {
+                    auto graph = builder.buildUndirected();
+                }
+            });
+            runner.measure(graphName + " GraphBuilder compressed snapshot (" + mode + ")", [&]() {
+                auto snapshot = builder.buildCompressed(directed);
+            });
+        }
+    }
+
+    // Проверка и удаление ребер у вершины-хаба, как в графах со степенным распределением
+    template <typename TGraph>
+    void benchmarkHub(BenchmarkRunner& runner, const std::string& graphName, int degree) {
+        TGraph graph;
+        auto hub = graph.createVertex(0);
+        std::vector<typename TGraph::VertexType*> neighbors(degree);
+        for (int i = 0; i < degree; ++i) {
+            neighbors[i] = graph.createVertex(i + 1);
+            graph.addEdge(hub, neighbors[i], 1);
+        }
+        std::vector<int> queries(degree);
+        std::mt19937 generator(47);
+        std::uniform_int_distribution<int> neighborDist(0, degree - 1);
+        for (auto& query : queries) {
+            query = neighborDist(generator);
+        }
+
+        int found = 0;
+        double seconds = runner.measure(graphName + " hasEdge on hub of degree " + std::to_string(degree), [&]() {
+            for (int query : queries) {
+                found += graph.hasEdge(hub, neighbors[query]) ? 1 : 0;
+            }
+        });
+        runner.report(graphName + " hasEdge throughput", queries.size() / seconds / 1e6, "M queries/s");
+
+        seconds = runner.measure(graphName + " removeEdge of all hub edges", [&]() {
+            for (int i = 0; i < degree; ++i) {
+                graph.removeEdge(hub, neighbors[i]);
+            }
+        });
+        runner.report(graphName + " removeEdge throughput", degree / seconds / 1e6, "M edges/s");
+        if (found != degree || graph.hasEdge(hub, neighbors[0])) {
+            runner.report(graphName + " unexpected hub state", found, "edges");
+        }
+
+        std::vector<typename TGraph::EdgeType*> batch;
+        for (int i = 0; i < degree; ++i) {
+            graph.addEdge(neighbors[i], hub, 1);
+            batch.push_back(static_cast<typename TGraph::EdgeType*>(neighbors[i]->findOutgoingEdge(0)));
+        }
+        runner.measure(graphName + " removeEdges batch of " + std::to_string(degree), [&]() {
+            graph.removeEdges(batch);
+        });
+
+        for (int i = 0; i < degree; ++i) {
+            graph.addEdge(hub, neighbors[i], 1);
+            graph.addEdge(neighbors[i], hub, 1);
+        }
+        runner.measure(graphName + " removeVertex of hub with " + std::to_string(2 * degree) + " edges", [&]() {
+            graph.removeVertex(hub);
+        });
+    }
+
+    void benchmarkHubEdges() {
+        BenchmarkRunner runner;
+        runner.printHeader("Hub vertex edge queries");
+
+        benchmarkHub<DirectedGraph<int, int>>(runner, "DirectedGraph", 100000);
+        benchmarkHub<UndirectedGraph<int, int>>(runner, "UndirectedGraph", 100000);
+    }
+
+    // Обход в ширину из нескольких источников; TEPS - пройденные дуги (исходящие дуги достигнутых вершин) в секунду
+    void benchmarkBFS() {
+        BenchmarkRunner runner;
+        runner.printHeader("Breadth-first search");
+
+        const int numVertices = 1 << 19;
+        const int numEdges = numVertices * 16;
+        auto edges = makeRandomEdges(numVertices, numEdges, 48);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            builder.addEdge(edge.first, edge.second, 1);
+        }
+        auto graph = builder.buildCompressed(true);
+
+        std::vector<int> sources;
+        std::mt19937 generator(49);
+        std::uniform_int_distribution<int> vertexDist(0, numVertices - 1);
+        while (sources.size() < 8) {
+            int source = vertexDist(generator);
+            if (graph.getOutDegree(source) > 0) {
+                sources.push_back(source);
+            }
+        }
+
+        auto traversedArcs = [&](const std::vector<int>& distances) {
+            size_t arcs = 0;
+            for (int v = 0; v < numVertices; ++v) {
+                if (distances[v] != -1) arcs += graph.getOutDegree(v);
+            }
+            return arcs;
+        };
+
+        // Обычная очередь сверху вниз для сравнения
+        size_t arcs = 0;
+        double seconds = runner.measure("Queue BFS, " + std::to_string(sources.size()) + " sources", [&]() {
+            arcs = 0;
+            for (int source : sources) {
+                std::vector<int> distances(numVertices, -1);
+                std::vector<int> queue{source};
+                distances[source] = 0;
+                for (size_t head = 0; head < queue.size(); ++head) {
+                    for (int neighbor : graph.getOutNeighbors(queue[head])) {
+                        if (distances[neighbor] == -1) {
+                            distances[neighbor] = distances[queue[head]] + 1;
+                            queue.push_back(neighbor);
+                        }
+                    }
+                }
+                arcs += traversedArcs(distances);
+            }
+        });
+        runner.report("Queue BFS", arcs / seconds / 1e9, "GTEPS");
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            BFSAlgorithm<int, int> bfs(threads);
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            int topDownSteps = 0;
+            int bottomUpSteps = 0;
+            seconds = runner.measure("Direction-optimizing BFS (" + mode + ")", [&]() {
+                arcs = 0;
+                topDownSteps = bottomUpSteps = 0;
+                for (int source : sources) {
+                    BFSResult result = bfs.run(graph, source);
+                    arcs += traversedArcs(result.distances);
+                    topDownSteps += result.topDownSteps;
+                    bottomUpSteps += result.bottomUpSteps;
+                }
+            });
+            runner.report("Direction-optimizing BFS (" + mode + ")", arcs / seconds / 1e9, "GTEPS");
+            runner.report("Top-down steps", topDownSteps, "steps");
+            runner.report("Bottom-up steps", bottomUpSteps, "steps");
+        }
+    }
+
+    // Фиксированное число итераций PageRank: проталкивание по списку дуг против вытягивания по входящим дугам CSR
+    void benchmarkPageRank() {
+        BenchmarkRunner runner;
+        runner.printHeader("PageRank");
+
+        const int numVertices = 1 << 19;
+        const int numEdges = numVertices * 16;
+        const int iterations = 20;
+        const double damping = 0.85;
+        auto edges = makeRandomEdges(numVertices, numEdges, 50);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            builder.addEdge(edge.first, edge.second, 1);
+        }
+        auto graph = builder.buildCompressed(true);
+
+        std::vector<int> outDegree(numVertices, 0);
+        for (const auto& edge : edges) {
+            ++outDegree[edge.first];
+        }
+        std::vector<double> pushRanks;
+        double seconds = runner.measure("Edge-list push, " + std::to_string(iterations) + " iterations", [&]() {
+            std::vector<double> rank(numVertices, 1.0 / numVertices);
+            std::vector<double> next(numVertices);
+            for (int iteration = 0; iteration < iterations; ++iteration) {
+                double danglingMass = 0;
+                for (int v = 0; v < numVertices; ++v) {
+                    if (outDegree[v] == 0) danglingMass += rank[v];
+                }
+                std::fill(next.begin(), next.end(), (1.0 - damping + damping * danglingMass) / numVertices);
+                for (const auto& edge : edges) {
+                    next[edge.second] += damping * rank[edge.first] / outDegree[edge.first];
+                }
+                rank.swap(next);
+            }
+            pushRanks = std::move(rank);
+        });
+        runner.report("Edge-list push", double(numEdges) * iterations / seconds / 1e6, "M edges/s");
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            PageRankAlgorithm<int, int> pageRank(threads);
+            pageRank.setTolerance(1e-300);
+            pageRank.setMaxIterations(iterations);
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            PageRankResult result;
+            seconds = runner.measure("CSR pull (" + mode + ")", [&]() {
+                result = pageRank.run(graph);
+            });
+            runner.report("CSR pull (" + mode + ")", double(numEdges) * iterations / seconds / 1e6, "M edges/s");
+
+            double difference = 0;
+            for (int v = 0; v < numVertices; ++v) {
+                difference = std::max(difference, std::abs(result.ranks[graph.getIndex(v)] - pushRanks[v]));
+            }
+            runner.report("Max difference from push", difference, "");
+        }
+    }
+
+    // Подсчет треугольников на случайном графе с хабами: пересечение полных списков соседей против ориентации по степени
+    void benchmarkTriangleCounting() {
+        BenchmarkRunner runner;
+        runner.printHeader("Triangle counting");
+
+        const int numVertices = 1 << 18;
+        auto edges = makeRandomEdges(numVertices, 2000000, 51);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            builder.addEdge(edge.first, edge.second, 1);
+        }
+        for (int hub = 0; hub < 4; ++hub) {
+            for (int v = hub + 1; v < numVertices; v += 16) {
+                builder.addEdge(hub, v, 1);
+            }
+        }
+        auto graph = builder.buildCompressed(false);
+        using Counter = TriangleCountingAlgorithm<int, int>;
+
+        Counter::NeighborView view(graph, nullptr);
+        runner.measure("Sorted neighbor view", [&]() {
+            Counter::NeighborView rebuilt(graph, nullptr);
+        });
+
+        long long naiveTriangles = 0;
+        double seconds = runner.measure("Unoriented merge intersection", [&]() {
+            long long corners = 0;
+            for (int v = 0; v < numVertices; ++v) {
+                auto a = view.getNeighbors(v);
+                for (int u : a) {
+                    if (u < v) continue;
+                    auto b = view.getNeighbors(u);
+                    size_t i = 0;
+                    size_t j = 0;
+                    while (i < a.size() && j < b.size()) {
+                        if (a[i] < b[j]) ++i;
+                        else if (b[j] < a[i]) ++j;
+                        else { ++corners; ++i; ++j; }
+                    }
+                }
+            }
+            naiveTriangles = corners / 3;
+        });
+        runner.report("Unoriented merge", graph.getEdgeCount() / seconds / 1e6, "M edges/s");
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            Counter counter(threads);
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            TriangleCountResult result;
+            seconds = runner.measure("Degree-oriented count with view build (" + mode + ")", [&]() {
+                result = counter.run(graph);
+            });
+            runner.report("Degree-oriented (" + mode + ")", graph.getEdgeCount() / seconds / 1e6, "M edges/s");
+            if (result.totalTriangles != naiveTriangles) {
+                runner.report("Triangle count mismatch", double(result.totalTriangles - naiveTriangles), "triangles");
+            }
+        }
+        runner.report("Triangles", double(naiveTriangles), "");
+    }
+
+    // Ядерное разложение: корзины Батагеля-Заверсника против поуровневого параллельного снятия
+    void benchmarkKCore() {
+        BenchmarkRunner runner;
+        runner.printHeader("k-core decomposition");
+
+        const int numVertices = 1 << 19;
+        auto edges = makeRandomEdges(numVertices, 4000000, 52);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            builder.addEdge(edge.first, edge.second, 1);
+        }
+        auto graph = builder.buildCompressed(false);
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            KCoreAlgorithm<int, int> kCore(threads);
+            std::string mode = threads ? "level-synchronous, " + std::to_string(pool.getThreadCount()) + " threads"
+                                       : "bucket peeling";
+            KCoreResult result;
+            double seconds = runner.measure("KCoreAlgorithm (" + mode + ")", [&]() {
+                result = kCore.run(graph);
+            });
+            runner.report("KCoreAlgorithm (" + mode + ")", graph.getEdgeCount() / seconds / 1e6, "M edges/s");
+            runner.report("Max core", result.maxCore, "");
+            runner.report("Max core size", double(result.maxCoreVertices.size()), "vertices");
+        }
+    }
+
+    // Точная центральность по посредничеству на малом графе и оценка по выборке источников на большом
+    void benchmarkBetweenness() {
+        BenchmarkRunner runner;
+        runner.printHeader("Betweenness centrality");
+
+        auto makeGraph = [](int numVertices, int numEdges, bool weighted, unsigned seed) {
+            auto edges = makeRandomEdges(numVertices, numEdges, seed);
+            GraphBuilder<int, int> builder(numVertices);
+            for (int i = 0; i < numVertices; ++i) {
+                builder.addVertex(i);
+            }
+            for (size_t i = 0; i < edges.size(); ++i) {
+                builder.addEdge(edges[i].first, edges[i].second, weighted ? 1 + static_cast<int>(i % 7) : 1);
+            }
+            return builder.buildCompressed(false);
+        };
+
+        ThreadPool& pool = ThreadPool::global();
+        for (bool weighted : {false, true}) {
+            auto graph = makeGraph(4096, 32768, weighted, 53);
+            std::string kind = weighted ? "Dijkstra" : "BFS";
+            BetweennessResult exact;
+            for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+                BetweennessCentralityAlgorithm<int, int> betweenness(threads);
+                std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+                double seconds = runner.measure("Exact " + kind + " Brandes, 4096 vertices (" + mode + ")", [&]() {
+                    exact = betweenness.run(graph);
+                });
+                runner.report("Exact " + kind + " Brandes (" + mode + ")", exact.sourceCount / seconds, "sources/s");
+            }
+
+            BetweennessCentralityAlgorithm<int, int> sampler(&pool);
+            sampler.setSampleCount(256);
+            BetweennessResult approximate;
+            runner.measure("Sampled " + kind + " Brandes, 256 sources", [&]() {
+                approximate = sampler.run(graph);
+            });
+            double maxError = 0;
+            for (size_t v = 0; v < exact.centrality.size(); ++v) {
+                maxError = std::max(maxError, std::abs(exact.centrality[v] - approximate.centrality[v]));
+            }
+            runner.report("Sampled " + kind + " max error", maxError, "");
+            runner.report("Sampled " + kind + " error bound (95%)", approximate.errorBound, "");
+        }
+
+        auto large = makeGraph(1 << 20, 1 << 23, false, 54);
+        BetweennessCentralityAlgorithm<int, int> sampler(&pool);
+        sampler.setSampleCount(32);
+        double seconds = runner.measure("Sampled BFS Brandes, 1M vertices, 32 sources", [&]() {
+            sampler.run(large);
+        });
+        runner.report("Sampled BFS Brandes, 1M vertices", 32 / seconds, "sources/s");
+    }
+
+    // Все пары кратчайших расстояний на плотном графе: Дейкстра из каждой вершины, простой и блочный Флойд-Уоршелл
+    void benchmarkAllPairs() {
+        BenchmarkRunner runner;
+        runner.printHeader("All-pairs shortest paths");
+
+        auto makeGraph = [](int numVertices, int numEdges, unsigned seed) {
+            auto edges = makeRandomEdges(numVertices, numEdges, seed);
+            GraphBuilder<int, int> builder(numVertices);
+            for (int i = 0; i < numVertices; ++i) {
+                builder.addVertex(i);
+            }
+            for (size_t i = 0; i < edges.size(); ++i) {
+                builder.addEdge(edges[i].first, edges[i].second, 1 + static_cast<int>(i % 100));
+            }
+            return builder;
+        };
+
+        auto small = makeGraph(256, 256 * 32, 55);
+        auto graph = small.buildDirected();
+        auto vertices = graph.getVertices();
+        DijkstraAlgorithm<int, int> dijkstra;
+        runner.measure("DijkstraAlgorithm from every vertex, 256 vertices", [&]() {
+            for (int i = 0; i < vertices.getLength(); ++i) {
+                dijkstra.execute(&graph, vertices.get(i));
+            }
+        });
+        auto smallSnapshot = small.buildCompressed(true);
+        runner.measure("Blocked Floyd-Warshall, 256 vertices", [&]() {
+            FloydWarshallAlgorithm<int, int>().run(smallSnapshot);
+        });
+
+        const int numVertices = 1536;
+        auto snapshot = makeGraph(numVertices, numVertices * 32, 56).buildCompressed(true);
+        double seconds = runner.measure("Naive Floyd-Warshall, " + std::to_string(numVertices) + " vertices", [&]() {
+            DistanceMatrix<int> matrix(numVertices);
+            for (int u = 0; u < numVertices; ++u) {
+                auto neighbors = snapshot.getOutNeighbors(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    matrix.row(u)[neighbors[i]] = std::min(matrix.row(u)[neighbors[i]], snapshot.getOutWeights(u)[i]);
+                }
+            }
+            for (int k = 0; k < numVertices; ++k) {
+                for (int i = 0; i < numVertices; ++i) {
+                    int through = matrix.row(i)[k];
+                    if (through >= DistanceMatrix<int>::infinity()) continue;
+                    for (int j = 0; j < numVertices; ++j) {
+                        matrix.row(i)[j] = std::min(matrix.row(i)[j], through + matrix.row(k)[j]);
+                    }
+                }
+            }
+        });
+        double relaxations = double(numVertices) * numVertices * numVertices;
+        runner.report("Naive Floyd-Warshall", relaxations / seconds / 1e9, "G relaxations/s");
+
+#ifdef __AVX2__
+        std::string kernel = "AVX2";
+#else
+        std::string kernel = "scalar";
+#endif
+        ThreadPool& pool = ThreadPool::global();
+        DistanceMatrix<int> matrix;
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            FloydWarshallAlgorithm<int, int> floydWarshall(threads);
+            std::string mode = kernel + ", " + (threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential");
+            seconds = runner.measure("Blocked Floyd-Warshall (" + mode + ")", [&]() {
+                matrix = floydWarshall.run(snapshot);
+            });
+            runner.report("Blocked Floyd-Warshall (" + mode + ")", relaxations / seconds / 1e9, "G relaxations/s");
+        }
+
+        std::string path = (std::filesystem::temp_directory_path() / "apsp_benchmark.bin").string();
+        runner.measure("Binary export of " + std::to_string(numVertices) + "x" + std::to_string(numVertices) + " matrix", [&]() {
+            matrix.writeBinary(path);
+        });
+        std::filesystem::remove(path);
+    }
+
+    // Кратчайшие пути при отрицательных весах: Беллман-Форд, SPFA и повторные запросы через перевзвешивание Джонсона
+    void benchmarkNegativeWeights() {
+        BenchmarkRunner runner;
+        runner.printHeader("Shortest paths with negative weights");
+
+        // Вес w + p(v) - p(u) отрицателен примерно у трети ребер, отрицательных циклов нет
+        const int numVertices = 200000;
+        auto edges = makeRandomEdges(numVertices, numVertices * 10, 57);
+        std::mt19937 generator(58);
+        std::uniform_int_distribution<int> weightDist(1, 100);
+        std::vector<int> potential(numVertices);
+        for (int& value : potential) {
+            value = weightDist(generator);
+        }
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& [u, v] : edges) {
+            builder.addEdge(u, v, weightDist(generator) + potential[v] - potential[u]);
+        }
+        auto snapshot = builder.buildCompressed(true);
+
+        using BellmanFord = BellmanFordAlgorithm<int, int>;
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            BellmanFord bellmanFord(threads);
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            BellmanFordResult<int, int> result;
+            double seconds = runner.measure("Bellman-Ford (" + mode + ")", [&]() {
+                result = bellmanFord.run(snapshot, 0);
+            });
+            runner.report("Bellman-Ford (" + mode + "), " + std::to_string(result.rounds) + " rounds",
+                          result.relaxations / seconds / 1e6, "M relaxations/s");
+        }
+
+        BellmanFord spfa;
+        spfa.setMode(BellmanFord::Mode::Spfa);
+        BellmanFordResult<int, int> result;
+        double seconds = runner.measure("SPFA with SLF/LLL", [&]() {
+            result = spfa.run(snapshot, 0);
+        });
+        runner.report("SPFA with SLF/LLL", result.relaxations / seconds / 1e6, "M relaxations/s");
+
+        // Повторные запросы: один Беллман-Форд на потенциалы, дальше только Дейкстра
+        const int queries = 8;
+        runner.measure("Bellman-Ford, " + std::to_string(queries) + " sources", [&]() {
+            BellmanFord bellmanFord;
+            for (int source = 0; source < queries; ++source) {
+                bellmanFord.run(snapshot, source);
+            }
+        });
+        std::optional<JohnsonReweighting<int, int>> johnson;
+        runner.measure("Johnson reweighting", [&]() {
+            johnson.emplace(snapshot);
+        });
+        runner.measure("Dijkstra on reweighted graph, " + std::to_string(queries) + " sources", [&]() {
+            for (int source = 0; source < queries; ++source) {
+                johnson->distancesFrom(source);
+            }
+        });
+    }
+
+    // Максимальный поток на слоистой сети: исток -> слой 0 -> ... -> последний слой -> сток
+    void benchmarkMaxFlow() {
+        BenchmarkRunner runner;
+        runner.printHeader("Max flow (push-relabel)");
+
+        const int layers = 64;
+        const int width = 4096;
+        const int fanOut = 8;
+        std::mt19937 generator(59);
+        std::uniform_int_distribution<int> vertexDist(0, width - 1);
+        std::uniform_int_distribution<int> capacityDist(1, 100);
+        int source = layers * width;
+        int sink = source + 1;
+        GraphBuilder<int, int> builder(sink + 1);
+        for (int v = 0; v <= sink; ++v) {
+            builder.addVertex(v);
+        }
+        for (int i = 0; i < width; ++i) {
+            builder.addEdge(source, i, 1000);
+            builder.addEdge((layers - 1) * width + i, sink, 1000);
+        }
+        for (int layer = 0; layer + 1 < layers; ++layer) {
+            for (int i = 0; i < width; ++i) {
+                for (int j = 0; j < fanOut; ++j) {
+                    builder.addEdge(layer * width + i, (layer + 1) * width + vertexDist(generator), capacityDist(generator));
+                }
+            }
+        }
+        auto snapshot = builder.buildCompressed(true);
+
+        for (double frequency : {0.5, 0.0}) {
+            MaxFlowAlgorithm<int, int> maxFlow;
+            maxFlow.setGlobalRelabelFrequency(frequency);
+            std::string mode = frequency > 0 ? "global relabel + gap" : "gap only";
+            MaxFlowResult<int> result;
+            double seconds = runner.measure("Push-relabel, 64 layers x 4096 (" + mode + ")", [&]() {
+                result = maxFlow.run(snapshot, snapshot.getIndex(source), snapshot.getIndex(sink));
+            });
+            runner.report("Pushes (" + mode + ")", result.pushes / 1e6, "M");
+            runner.report("Relabels (" + mode + ")", result.relabels / 1e6, "M");
+            runner.report("Throughput (" + mode + ")", snapshot.getArcCount() / seconds / 1e6, "M arcs/s");
+        }
+    }
+
+    // Паросочетание на случайном двудольном графе с 10^6 ребрами
+    void benchmarkBipartiteMatching() {
+        BenchmarkRunner runner;
+        runner.printHeader("Bipartite matching (Hopcroft-Karp)");
+
+        const int sideSize = 250000;
+        const int numEdges = 1000000;
+        std::mt19937 generator(60);
+        std::uniform_int_distribution<int> sideDist(0, sideSize - 1);
+        GraphBuilder<int, int> builder(2 * sideSize);
+        for (int v = 0; v < 2 * sideSize; ++v) {
+            builder.addVertex(v);
+        }
+        for (int i = 0; i < numEdges; ++i) {
+            builder.addEdge(sideDist(generator), sideSize + sideDist(generator), 1);
+        }
+        auto snapshot = builder.buildCompressed(false);
+
+        for (bool greedy : {true, false}) {
+            BipartiteMatchingAlgorithm<int, int> matching;
+            matching.setGreedyInitialization(greedy);
+            std::string mode = greedy ? "greedy start" : "empty start";
+            BipartiteMatchingResult result;
+            double seconds = runner.measure("Hopcroft-Karp, 500k vertices, 1M edges (" + mode + ")", [&]() {
+                result = matching.run(snapshot);
+            });
+            runner.report("Matching size (" + mode + ")", result.matchingSize, "edges");
+            runner.report("Phases (" + mode + ")", result.phases, "");
+            runner.report("Throughput (" + mode + ")", numEdges / seconds / 1e6, "M edges/s");
+        }
+    }
+
+    // Раскраска случайного графа: качество (число цветов) и скорость каждой стратегии
+    void benchmarkColoring() {
+        BenchmarkRunner runner;
+        runner.printHeader("Graph coloring");
+
+        const int numVertices = 1 << 19;
+        auto edges = makeRandomEdges(numVertices, 4000000, 61);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            builder.addEdge(edge.first, edge.second, 1);
+        }
+        auto graph = builder.buildCompressed(false);
+
+        using Coloring = GraphColoringAlgorithm<int, int>;
+        ThreadPool& pool = ThreadPool::global();
+        std::string threads = std::to_string(pool.getThreadCount()) + " threads";
+        const std::vector<std::pair<Coloring::Strategy, std::string>> strategies = {
+            {Coloring::Strategy::LargestFirst, "largest-first"},
+            {Coloring::Strategy::SmallestLast, "smallest-last"},
+            {Coloring::Strategy::Dsatur, "DSATUR"},
+            {Coloring::Strategy::Speculative, "speculative, " + threads},
+            {Coloring::Strategy::JonesPlassmann, "Jones-Plassmann, " + threads},
+        };
+        for (const auto& [strategy, name] : strategies) {
+            bool parallel = strategy == Coloring::Strategy::Speculative || strategy == Coloring::Strategy::JonesPlassmann;
+            Coloring coloring(parallel ? &pool : nullptr);
+            coloring.setStrategy(strategy);
+            ColoringResult result;
+            double seconds = runner.measure("Coloring (" + name + ")", [&]() {
+                result = coloring.run(graph);
+            });
+            runner.report("Colors (" + name + ")", result.colorCount, "");
+            runner.report("Rounds (" + name + ")", result.rounds, "");
+            runner.report("Throughput (" + name + ")", graph.getEdgeCount() / seconds / 1e6, "M edges/s");
+        }
+    }
+
+    void benchmarkLouvain() {
+        BenchmarkRunner runner;
+        runner.printHeader("Louvain community detection");
+
+        // Сообщества по 64 вершины: 8 случайных ребер на вершину внутри сообщества и 2 - наружу
+        const int numVertices = 1 << 18;
+        const int groupSize = 64;
+        std::mt19937 generator(67);
+        std::uniform_int_distribution<int> vertexDist(0, numVertices - 1);
+        std::uniform_int_distribution<int> memberDist(0, groupSize - 1);
+        std::uniform_real_distribution<double> weightDist(1.0, 2.0);
+        GraphBuilder<double, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (int u = 0; u < numVertices; ++u) {
+            int group = u / groupSize * groupSize;
+            for (int k = 0; k < 4; ++k) {
+                builder.addEdge(u, group + memberDist(generator), weightDist(generator));
+            }
+            if (u % 2 == 0) {
+                builder.addEdge(u, vertexDist(generator), weightDist(generator));
+            }
+        }
+        auto graph = builder.buildCompressed(false);
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            LouvainAlgorithm<double, int> louvain(threads);
+            LouvainResult result;
+            double seconds = runner.measure("Louvain (" + mode + ")", [&]() {
+                result = louvain.run(graph);
+            });
+            runner.report("Levels (" + mode + ")", static_cast<double>(result.levels.size()), "");
+            runner.report("Communities (" + mode + ")", result.communityCount, "");
+            runner.report("Modularity (" + mode + ")", result.modularity, "");
+            runner.report("Throughput (" + mode + ")", graph.getEdgeCount() / seconds / 1e6, "M edges/s");
+        }
+    }
+
+    void benchmarkReachability() {
+        BenchmarkRunner runner;
+        runner.printHeader("Reachability index");
+
+        // Почти ацикличный граф: ребра в основном от меньшего номера к большему, 0.2% обратных дают циклы
+        const int numVertices = 1 << 20;
+        auto edges = makeRandomEdges(numVertices, 12 * numVertices, 71);
+        GraphBuilder<int, int> builder(numVertices);
+        for (int i = 0; i < numVertices; ++i) {
+            builder.addVertex(i);
+        }
+        for (size_t i = 0; i < edges.size(); ++i) {
+            auto [a, b] = edges[i];
+            if ((a < b) == (i % 500 != 0)) {
+                builder.addEdge(a, b, 1);
+            }
+        }
+        auto graph = builder.buildCompressed(true);
+
+        const int numQueries = 200000;
+        std::mt19937 generator(73);
+        std::uniform_int_distribution<int> vertexDist(0, numVertices - 1);
+        std::vector<std::pair<int, int>> queries(numQueries);
+        for (auto& query : queries) {
+            query = {vertexDist(generator), vertexDist(generator)};
+        }
+
+        for (int labelings : {1, 3, 5}) {
+            std::string mode = std::to_string(labelings) + " labelings";
+            std::optional<ReachabilityIndex<int, int>> index;
+            runner.measure("Build (" + mode + ")", [&]() {
+                index.emplace(graph, labelings);
+            });
+            runner.report("Index size (" + mode + ")", index->getIndexSize() / double(1 << 20), "MB");
+
+            size_t reachable = 0;
+            double seconds = runner.measure("Queries (" + mode + ")", [&]() {
+                for (const auto& [from, to] : queries) {
+                    reachable += index->reaches(from, to);
+                }
+            });
+            const auto& statistics = index->getStatistics();
+            runner.report("Components (" + mode + ")", index->getComponentCount(), "");
+            runner.report("Reachable pairs (" + mode + ")", 100.0 * reachable / statistics.queries, "%");
+            runner.report("Answered by labels (" + mode + ")", 100.0 * statistics.labelAnswers / statistics.queries, "%");
+            runner.report("Visits per search (" + mode + ")",
+                          statistics.searches ? double(statistics.searchVisits) / statistics.searches : 0.0, "");
+            runner.report("Query time (" + mode + ")", seconds / numQueries * 1e6, "us");
+        }
+    }
+
+    void benchmarkGeneration() {
+        BenchmarkRunner runner;
+        runner.printHeader("Graph generation");
+
+        // G(n, p) со средней степенью 10: перебор всех пар занял бы 10^12 бросков
+        const size_t numVertices = 1000000;
+        const double probability = 10.0 / numVertices;
+        ErdosRenyiSampler<int> sampler(numVertices, probability, true, 79);
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            size_t edgeCount = 0;
+            double seconds = runner.measure("Sampling 10^6 vertices (" + mode + ")", [&]() {
+                edgeCount = 0;
+                for (const auto& chunk : sampler.sample(threads)) {
+                    edgeCount += chunk.size();
+                }
+            });
+            runner.report("Edges (" + mode + ")", edgeCount / 1e6, "M");
+            runner.report("Throughput (" + mode + ")", edgeCount / seconds / 1e6, "M edges/s");
+        }
+
+        DirectedGraphGenerator<int, int> generator(100000, 10.0 / 100000, 83);
+        IGraph<int, int>* graph = nullptr;
+        runner.measure("DirectedGraphGenerator, 10^5 vertices", [&]() {
+            graph = generator.generate();
+        });
+        delete graph;
+
+        // Остальные генераторы - сразу в CompressedGraph через пакетный сборщик, около 4 * 10^6 ребер каждый
+        auto measureCompressed = [&](const std::string& name, IGraphGenerator<int, int>& source) {
+            size_t arcCount = 0;
+            double seconds = runner.measure(name, [&]() {
+                arcCount = source.generateCompressed().getArcCount();
+            });
+            runner.report(name + " throughput", arcCount / seconds / 1e6, "M arcs/s");
+        };
+        RMatGraphGenerator<int, int> rmat(18, 16, 89);
+        rmat.setThreadPool(&pool);
+        measureCompressed("R-MAT, scale 18, edge factor 16", rmat);
+        BarabasiAlbertGraphGenerator<int, int> barabasiAlbert(1000000, 4, 97);
+        measureCompressed("Barabasi-Albert, 10^6 vertices, m = 4", barabasiAlbert);
+        GridGraphGenerator<int, int> grid(1000, 1000, 1, 101);
+        measureCompressed("Grid 1000 x 1000", grid);
+        RandomGeometricGraphGenerator<int, int> geometric(1000000, std::sqrt(8.0 / (3.14159265 * 1000000)), 2, 103);
+        measureCompressed("Random geometric, 10^6 vertices, degree 8", geometric);
+    }
+
+    void benchmarkStreaming() {
+        BenchmarkRunner runner;
+        runner.printHeader("Streaming generation");
+
+        // 10^7 ребер G(n, p) сразу в приемник: граф не строится, память - буфер и разбиение на блоки
+        const size_t numVertices = 1000000;
+        DirectedGraphGenerator<int, int> generator(numVertices, 10.0 / numVertices, 107);
+        ThreadPool& pool = ThreadPool::global();
+        std::filesystem::path directory = std::filesystem::temp_directory_path();
+
+        size_t edgeCount = 0;
+        CallbackEdgeSink<int> counter([&](std::span<const GeneratedEdge<int>> chunk) { edgeCount += chunk.size(); });
+        long rssBefore = BenchmarkRunner::currentResidentSetKb();
+        double seconds = runner.measure("Callback sink, 10^6 vertices", [&]() {
+            edgeCount = 0;
+            generator.generateTo(counter);
+        });
+        runner.report("Edges", edgeCount / 1e6, "M");
+        runner.report("Callback throughput", edgeCount / seconds / 1e6, "M edges/s");
+
+        auto measureFile = [&](const std::string& name, const std::string& path, auto makeSink) {
+            double fileSeconds = runner.measure(name, [&]() {
+                auto sink = makeSink(path);
+                generator.generateTo(sink);
+            });
+            double megabytes = std::filesystem::file_size(path) / 1e6;
+            std::filesystem::remove(path);
+            runner.report(name + " size", megabytes, "MB");
+            runner.report(name + " throughput", megabytes / fileSeconds, "MB/s");
+        };
+        measureFile("Binary edge file", (directory / "stream_benchmark.bin").string(),
+                    [](const std::string& path) { return BinaryEdgeSink<int>(path); });
+        measureFile("Text edge list", (directory / "stream_benchmark.txt").string(),
+                    [](const std::string& path) { return TextEdgeListSink<int>(path); });
+
+        // Писатель на поток, каждый в свой файл
+        size_t writers = pool.getThreadCount();
+        auto shardPath = [&](size_t writer) {
+            return (directory / ("stream_benchmark_" + std::to_string(writer) + ".bin")).string();
+        };
+        double shardedSeconds = runner.measure("Sharded binary files, " + std::to_string(writers) + " writers", [&]() {
+            generator.generateSharded(writers, [&](size_t writer) {
+                return UniquePtr<IEdgeSink<int>>(new BinaryEdgeSink<int>(shardPath(writer)));
+            }, &pool);
+        });
+        double megabytes = 0;
+        for (size_t writer = 0; writer < writers; ++writer) {
+            megabytes += std::filesystem::file_size(shardPath(writer)) / 1e6;
+            std::filesystem::remove(shardPath(writer));
+        }
+        runner.report("Sharded throughput", megabytes / shardedSeconds, "MB/s");
+        runner.report("Resident memory growth", (BenchmarkRunner::currentResidentSetKb() - rssBefore) / 1024.0, "MB");
+    }
+
+    void benchmarkGraphFile() {
+        BenchmarkRunner runner;
+        runner.printHeader("Mapped graph file");
+
+        // R-MAT с 2^20 вершинами и 8 * 2^20 дугами; построение снимка - то, что заменяет загрузка файла
+        RMatGraphGenerator<int, int> generator(20, 8, 109);
+        CompressedGraph<int, int> graph;
+        runner.measure("Build snapshot through GraphBuilder", [&]() {
+            graph = generator.generateCompressed();
+        });
+        std::string path = (std::filesystem::temp_directory_path() / "graph_benchmark.csr").string();
+        double writeSeconds = runner.measure("Write graph file", [&]() {
+            MappedGraph<int, int>::write(graph, path);
+        });
+        double megabytes = std::filesystem::file_size(path) / 1e6;
+        runner.report("File size", megabytes, "MB");
+        runner.report("Write throughput", megabytes / writeSeconds, "MB/s");
+
+        // Файл уже в страничном кэше: это время открытия во втором процессе, а не холодное чтение с диска
+        runner.measure("Open mapped file", [&]() {
+            auto mapped = MappedGraph<int, int>::open(path);
+        });
+        double verifySeconds = runner.measure("Open with checksum verification", [&]() {
+            auto mapped = MappedGraph<int, int>::open(path, true);
+        });
+        runner.report("Checksum throughput", megabytes / verifySeconds, "MB/s");
+
+        auto mapped = MappedGraph<int, int>::open(path);
+        long long weightSum = 0;
+        runner.measure("Full pass over mapped arcs", [&]() {
+            weightSum = 0;
+            for (int v = 0; v < mapped.getVertexCount(); ++v) {
+                for (int weight : mapped.getOutWeights(v)) {
+                    weightSum += weight;
+                }
+            }
+        });
+        runner.measure("Copy mapped graph to CompressedGraph", [&]() {
+            graph = mapped.toCompressed();
+        });
+        runner.report("Weight sum", weightSum / 1e6, "M");
+        std::filesystem::remove(path);
+    }
+
+    void benchmarkGraphLoading() {
+        BenchmarkRunner runner;
+        runner.printHeader("Text graph loading");
+
+        // Список ребер R-MAT: 2^20 вершин, 8 * 2^20 строк "from to weight"
+        std::string path = (std::filesystem::temp_directory_path() / "loader_benchmark.txt").string();
+        RMatGraphGenerator<int, int> generator(20, 8, 113);
+        TextEdgeListSink<int> sink(path);
+        generator.generateTo(sink);
+        double megabytes = std::filesystem::file_size(path) / 1e6;
+        runner.report("File size", megabytes, "MB");
+
+        ThreadPool& pool = ThreadPool::global();
+        for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+            std::string mode = threads ? std::to_string(pool.getThreadCount()) + " threads" : "sequential";
+            GraphLoader<int, int> loader(threads);
+            double readSeconds = runner.measure("Parse into GraphBuilder (" + mode + ")", [&]() {
+                GraphBuilder<int, int> builder;
+                loader.read(path, GraphLoader<int, int>::Format::EdgeList, builder);
+            });
+            runner.report("Parse throughput (" + mode + ")", megabytes / readSeconds, "MB/s");
+            size_t arcCount = 0;
+            double loadSeconds = runner.measure("Load CompressedGraph (" + mode + ")", [&]() {
+                arcCount = loader.load(path, GraphLoader<int, int>::Format::EdgeList).getArcCount();
+            });
+            runner.report("Load throughput (" + mode + ")", megabytes / loadSeconds, "MB/s");
+            runner.report("Arcs (" + mode + ")", arcCount / 1e6, "M");
+        }
+        std::filesystem::remove(path);
+    }
+
+    void benchmarkDurableGraph() {
+        BenchmarkRunner runner;
+        runner.printHeader("Durable graph (write-ahead log and snapshots)");
+
+        const int numVertices = 100000;
+        const int numEdges = 1000000;
+        auto edges = makeRandomEdges(numVertices, numEdges, 47);
+        std::string directory = (std::filesystem::temp_directory_path() / "durable_graph_benchmark").string();
+
+        double plainSeconds = runner.measure("DirectedGraph without log", [&]() {
+            DirectedGraph<int, int> graph;
+            for (const auto& edge : edges) {
+                graph.addEdge(graph.createVertex(edge.first), graph.createVertex(edge.second), 1);
+            }
+        });
+        runner.report("Per mutation (no log)", plainSeconds / numEdges * 1e9, "ns");
+
+        // Цена изменения с журналом при разных политиках; count - число изменений прогона
+        auto logged = [&](const std::string& name, SyncPolicy policy, size_t groupSize, int count) {
+            std::filesystem::remove_all(directory);
+            double seconds = runner.measure(name, [&]() {
+                DurableGraph<int, int> graph(directory, policy);
+                graph.setGroupSize(groupSize);
+                for (int i = 0; i < count; ++i) {
+                    graph.addEdge(edges[i].first, edges[i].second, 1);
+                }
+                graph.commit();
+            });
+            runner.report("Per mutation (" + name + ")", seconds / count * 1e9, "ns");
+        };
+        logged("fsync per mutation", SyncPolicy::EveryCommit, 1, 2000);
+        logged("fsync per group of 256", SyncPolicy::EveryCommit, 256, numEdges);
+        logged("fsync every 10 ms, group 1", SyncPolicy::Interval, 1, numEdges);
+        logged("no fsync, group 256", SyncPolicy::None, 256, numEdges);
+
+        // Восстановление только из журнала последнего прогона: 10^6 записей
+        size_t replayed = 0;
+        double replaySeconds = runner.measure("Recover from log", [&]() {
+            DurableGraph<int, int> graph(directory);
+            replayed = graph.getRecoveryInfo().replayedRecords;
+        });
+        runner.report("Log replay rate", replayed / replaySeconds / 1e6, "M records/s");
+
+        // Снимок и хвост журнала из 10^5 записей поверх него
+        {
+            DurableGraph<int, int> graph(directory);
+            runner.measure("Checkpoint of 10^6 edges", [&]() { graph.checkpoint(); });
+            graph.setGroupSize(256);
+            for (int i = 0; i < numEdges / 10; ++i) {
+                graph.removeEdge(edges[i].first, edges[i].second);
+            }
+        }
+        runner.measure("Recover from snapshot and log tail", [&]() { DurableGraph<int, int> graph(directory); });
+        std::filesystem::remove_all(directory);
+    }
+
+    void benchmarkVersionedGraph() {
+        BenchmarkRunner runner;
+        runner.printHeader("Versioned graph (copy-on-write snapshots)");
+
+        const int numVertices = 100000;
+        const int numEdges = 1000000;
+        auto edges = makeRandomEdges(numVertices, numEdges, 48);
+
+        VersionedGraph<int, int> graph;
+        double buildSeconds = runner.measure("Insert 10^6 edges, commit every 10^4", [&]() {
+            for (int i = 0; i < numEdges; ++i) {
+                graph.addEdge(edges[i].first, edges[i].second, 1);
+                if ((i + 1) % 10000 == 0) {
+                    graph.commit();
+                }
+            }
+        });
+        runner.report("Per inserted edge", buildSeconds / numEdges * 1e9, "ns");
+
+        // Цена commit не зависит от размера графа: копируются только измененные пути
+        std::mt19937 random(49);
+        for (int batch : {1, 100}) {
+            const int commits = 2000;
+            double seconds = runner.measure("Commits of " + std::to_string(batch) + " edge changes", [&]() {
+                for (int c = 0; c < commits; ++c) {
+                    for (int i = 0; i < batch; ++i) {
+                        const auto& edge = edges[random() % numEdges];
+                        graph.removeEdge(edge.first, edge.second);
+                        graph.addEdge(edge.first, edge.second, 2);
+                    }
+                    graph.commit();
+                }
+            });
+            runner.report("Per commit of " + std::to_string(batch), seconds / commits * 1e6, "us");
+        }
+
+        auto snapshot = graph.snapshot();
+        runner.measure("Full copy of a version (toCompressed)", [&]() { snapshot.toCompressed(); });
+        auto compressed = snapshot.toCompressed();
+        long long snapshotSum = 0;
+        long long compressedSum = 0;
+        double snapshotScan = runner.measure("Scan all arcs of a snapshot", [&]() {
+            for (int v = 0; v < snapshot.getIndexBound(); ++v) {
+                snapshot.forEachOutArc(v, [&](int, int weight) { snapshotSum += weight; });
+            }
+        });
+        double compressedScan = runner.measure("Scan all arcs of CompressedGraph", [&]() {
+            for (int v = 0; v < compressed.getVertexCount(); ++v) {
+                for (int weight : compressed.getOutWeights(v)) compressedSum += weight;
+            }
+        });
+        runner.report("Snapshot scan slowdown", snapshotScan / compressedScan, "x");
+        if (snapshotSum != compressedSum) {
+            runner.report("Weight sums differ by", static_cast<double>(snapshotSum - compressedSum), "");
+        }
+
+        // Читатель обходит закрепленные версии, пока писатель публикует новые
+        std::atomic<bool> done{false};
+        std::atomic<size_t> scans{0};
+        std::atomic<size_t> inconsistent{0};
+        std::thread reader([&]() {
+            while (!done.load()) {
+                auto pinned = graph.snapshot();
+                size_t arcs = 0;
+                for (int v = 0; v < pinned.getIndexBound(); ++v) arcs += pinned.getOutDegree(v);
+                inconsistent.fetch_add(arcs != pinned.getEdgeCount());
+                scans.fetch_add(1);
+            }
+        });
+        const int commits = 2000;
+        double concurrentSeconds = runner.measure("Commits of 100 edge changes with a reader", [&]() {
+            for (int c = 0; c < commits; ++c) {
+                for (int i = 0; i < 100; ++i) {
+                    const auto& edge = edges[random() % numEdges];
+                    graph.removeEdge(edge.first, edge.second);
+                    graph.addEdge(edge.first, edge.second, 3);
+                }
+                graph.commit();
+            }
+        });
+        done.store(true);
+        reader.join();
+        runner.report("Per commit with a reader", concurrentSeconds / commits * 1e6, "us");
+        runner.report("Reader scans during commits", static_cast<double>(scans.load()), "scans");
+        runner.report("Inconsistent reader scans", static_cast<double>(inconsistent.load()), "scans");
+    }
+
+    void benchmarkBulkBuild() {
+        BenchmarkRunner runner;
+        runner.printHeader("Bulk graph build");
+
+        const int numVertices = 200000;
+        auto edges = makeRandomEdges(numVertices, 2000000, 45);
+        benchmarkBuilder<DirectedGraph<int, int>>(runner, "DirectedGraph", numVertices, edges, true);
+
+        auto undirectedEdges = makeRandomEdges(numVertices, 1000000, 46);
+        benchmarkBuilder<UndirectedGraph<int, int>>(runner, "UndirectedGraph", numVertices, undirectedEdges, false);
+    }
+
+    void benchmarkGraphConstruction() {
+        BenchmarkRunner runner;
+        runner.printHeader("Graph construction");
+
+        const int numVertices = 100000;
+        auto edges = makeRandomEdges(numVertices, 1000000, 42);
+        benchmarkBuild<DirectedGraph<int, int>>(runner, "DirectedGraph", numVertices, edges, true);
+        benchmarkBuild<DirectedGraph<int, int>>(runner, "DirectedGraph", numVertices, edges, false);
+
+        auto undirectedEdges = makeRandomEdges(numVertices, 500000, 43);
+        benchmarkBuild<UndirectedGraph<int, int>>(runner, "UndirectedGraph", numVertices, undirectedEdges, true);
+        benchmarkBuild<UndirectedGraph<int, int>>(runner, "UndirectedGraph", numVertices, undirectedEdges, false);
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+class BenchmarkRunner {
+public:
+    // Выполняет функцию repetitions раз и печатает лучшее время, возвращает его в секундах
+    double measure(const std::string& benchmarkName, const std::function<void()>& benchmarkFunction, int repetitions = 1);
+    void report(const std::string& metricName, double value, const std::string& unit) const;
+
+    // Текущий размер резидентной памяти процесса в килобайтах, -1 если платформа не поддерживается
+    static long currentResidentSetKb();
+
+    void printHeader(const std::string& groupName) const;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace graph_benchmarks {
+    void benchmarkGraphConstruction();
+    void benchmarkEdgeInsertion();
+    void benchmarkBulkBuild();
+    void benchmarkHubEdges();
+    void benchmarkBFS();
+    void benchmarkPageRank();
+    void benchmarkTriangleCounting();
+    void benchmarkKCore();
+    void benchmarkBetweenness();
+    void benchmarkAllPairs();
+    void benchmarkNegativeWeights();
+    void benchmarkMaxFlow();
+    void benchmarkBipartiteMatching();
+    void benchmarkColoring();
+    void benchmarkLouvain();
+    void benchmarkReachability();
+    void benchmarkGeneration();
+    void benchmarkStreaming();
+    void benchmarkGraphFile();
+    void benchmarkGraphLoading();
+    void benchmarkDurableGraph();
+    void benchmarkVersionedGraph();
+}
@@ -12,6 +12,10 @@ private:
     IVertex<TWeight, TIdentifier>* from_;
     IVertex<TWeight, TIdentifier>* to_;
     TWeight weight_;
+    // Позиции ребра в списке исходящих начала и в списке входящих конца.
+    // Их поддерживает AdjacencyList, по ним ребро отсоединяется за O(1)
+    int outgoingSlot_ = -1;
+    int incomingSlot_ = -1;
 
 public:
     Edge(IVertex<TWeight, TIdentifier>* from, IVertex<TWeight, TIdentifier>* to, TWeight weight)
@@ -21,6 +25,9 @@ public:
     IVertex<TWeight, TIdentifier>* getFrom() const override { return from_; }
     IVertex<TWeight, TIdentifier>* getTo() const override { return to_; }
     TWeight getWeight() const override { return weight_; }
+
+    int getSlot(bool outgoing) const { return outgoing ? outgoingSlot_ : incomingSlot_; }
+    void setSlot(bool outgoing, int slot) { (outgoing ? outgoingSlot_ : incomingSlot_) = slot; }
 };
 
 #endif // EDGE_H
\ No newline at end of file
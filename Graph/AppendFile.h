@@ -0,0 +1,153 @@
+#ifndef APPENDFILE_H
+#define APPENDFILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define APPENDFILE_USE_POSIX 1
+#endif
+
+// Файл только для дописывания в конец с явной синхронизацией на диск (fsync).
+// Без POSIX sync сводится к fflush: данные уходят в ОС, но не обязательно на диск.
+class AppendFile {
+private:
+#ifdef APPENDFILE_USE_POSIX
+    int descriptor_ = -1;
+#else
+    std::FILE* file_ = nullptr;
+#endif
+    std::string path_;
+    size_t size_ = 0;
+
+public:
+    AppendFile() = default;
+
+    explicit AppendFile(const std::string& path) : path_(path) {
+#ifdef APPENDFILE_USE_POSIX
+        descriptor_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (descriptor_ < 0) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        off_t end = lseek(descriptor_, 0, SEEK_END);
+        size_ = end > 0 ? static_cast<size_t>(end) : 0;
+#else
+        file_ = std::fopen(path.c_str(), "ab");
+        if (!file_) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        std::fseek(file_, 0, SEEK_END);
+        size_ = static_cast<size_t>(std::ftell(file_));
+#endif
+    }
+
+    AppendFile(AppendFile&& other) noexcept : path_(std::move(other.path_)), size_(other.size_) {
+#ifdef APPENDFILE_USE_POSIX
+        descriptor_ = other.descriptor_;
+        other.descriptor_ = -1;
+#else
+        file_ = other.file_;
+        other.file_ = nullptr;
+#endif
+    }
+
+    AppendFile& operator=(AppendFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            size_ = other.size_;
+#ifdef APPENDFILE_USE_POSIX
+            descriptor_ = other.descriptor_;
+            other.descriptor_ = -1;
+#else
+            file_ = other.file_;
+            other.file_ = nullptr;
+#endif
+        }
+        return *this;
+    }
+
+    AppendFile(const AppendFile&) = delete;
+    AppendFile& operator=(const AppendFile&) = delete;
+
+    ~AppendFile() {
+        close();
+    }
+
+    bool isOpen() const {
+#ifdef APPENDFILE_USE_POSIX
+        return descriptor_ >= 0;
+#else
+        return file_ != nullptr;
+#endif
+    }
+
+    size_t size() const { return size_; }
+
+    void append(const char* data, size_t size) {
+#ifdef APPENDFILE_USE_POSIX
+        while (size > 0) {
+            ssize_t written = ::write(descriptor_, data, size);
+            if (written < 0) {
+                throw std::runtime_error("Failed to write file: " + path_);
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+            size_ += static_cast<size_t>(written);
+        }
+#else
+        if (std::fwrite(data, 1, size, file_) != size) {
+            throw std::runtime_error("Failed to write file: " + path_);
+        }
+        size_ += size;
+#endif
+    }
+
+    void sync() {
+#ifdef APPENDFILE_USE_POSIX
+        if (fsync(descriptor_) != 0) {
+            throw std::runtime_error("Failed to sync file: " + path_);
+        }
+#else
+        if (std::fflush(file_) != 0) {
+            throw std::runtime_error("Failed to sync file: " + path_);
+        }
+#endif
+    }
+
+    void close() {
+#ifdef APPENDFILE_USE_POSIX
+        if (descriptor_ >= 0) {
+            ::close(descriptor_);
+            descriptor_ = -1;
+        }
+#else
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+#endif
+    }
+
+    // Синхронизация уже записанного файла или каталога (после переименования)
+    static void syncPath(const std::string& path) {
+#ifdef APPENDFILE_USE_POSIX
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        int result = fsync(descriptor);
+        ::close(descriptor);
+        if (result != 0) {
+            throw std::runtime_error("Failed to sync file: " + path);
+        }
+#endif
+    }
+};
+
+#endif // APPENDFILE_H
@@ -0,0 +1,169 @@
+#ifndef COMPRESSEDGRAPH_H
+#define COMPRESSEDGRAPH_H
+
+#include "IGraph.h"
+#include "HashTableDictionary.h"
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Неизменяемый снимок графа в формате CSR (compressed sparse row).
+// Вершины пронумерованы плотно от 0 до getVertexCount() - 1, соседи вершины v лежат
+// в targets[offsets[v] .. offsets[v + 1]). Для ориентированного графа хранятся и исходящие,
+// и входящие дуги; неориентированное ребро хранится двумя дугами, входящие совпадают с исходящими.
+template <typename TWeight, typename TIdentifier>
+class CompressedGraph {
+private:
+    bool directed_ = true;
+    std::vector<TIdentifier> ids_;                  // индекс -> идентификатор
+    HashTableDictionary<TIdentifier, int> indexById_; // идентификатор -> индекс
+
+    std::vector<size_t> outOffsets_;
+    std::vector<int> outTargets_;
+    std::vector<TWeight> outWeights_;
+
+    std::vector<size_t> inOffsets_;
+    std::vector<int> inSources_;
+    std::vector<TWeight> inWeights_;
+
+    void buildIndex() {
+        indexById_ = HashTableDictionary<TIdentifier, int>(static_cast<int>(ids_.size()) * 2 + 1);
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            indexById_.add(ids_[i], static_cast<int>(i));
+        }
+    }
+
+    void checkIndex(int vertex) const {
+        if (vertex < 0 || vertex >= getVertexCount()) {
+            throw std::out_of_range("Vertex index is out of range.");
+        }
+    }
+
+public:
+    CompressedGraph() : outOffsets_(1, 0) {}
+
+    // Массивы смежности должны быть согласованы: offsets размера V + 1, targets и weights размера offsets[V].
+    // Для неориентированного графа входящие массивы не передаются.
+    CompressedGraph(bool directed, std::vector<TIdentifier> ids,
+                    std::vector<size_t> outOffsets, std::vector<int> outTargets, std::vector<TWeight> outWeights,
+                    std::vector<size_t> inOffsets = {}, std::vector<int> inSources = {}, std::vector<TWeight> inWeights = {})
+        : directed_(directed), ids_(std::move(ids)),
+          outOffsets_(std::move(outOffsets)), outTargets_(std::move(outTargets)), outWeights_(std::move(outWeights)),
+          inOffsets_(std::move(inOffsets)), inSources_(std::move(inSources)), inWeights_(std::move(inWeights)) {
+        if (outOffsets_.size() != ids_.size() + 1 || outTargets_.size() != outOffsets_.back() ||
+            outWeights_.size() != outTargets_.size()) {
+            throw std::invalid_argument("Inconsistent outgoing adjacency arrays.");
+        }
+        if (directed_ && (inOffsets_.size() != ids_.size() + 1 || inSources_.size() != inOffsets_.back() ||
+                          inWeights_.size() != inSources_.size())) {
+            throw std::invalid_argument("Inconsistent incoming adjacency arrays.");
+        }
+        buildIndex();
+    }
+
+    // Снимок произвольного графа; вершины нумеруются в порядке getVertices()
+    static CompressedGraph fromGraph(const IGraph<TWeight, TIdentifier>* graph) {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        auto vertices = graph->getVertices();
+        int vertexCount = vertices.getLength();
+        std::vector<TIdentifier> ids(vertexCount);
+        HashTableDictionary<TIdentifier, int> indexById(vertexCount * 2 + 1);
+        for (int i = 0; i < vertexCount; ++i) {
+            ids[i] = vertices.get(i)->getId();
+            indexById.add(ids[i], i);
+        }
+
+        // Для неориентированного графа исходящие дуги вершины - это все инцидентные ей ребра
+        std::vector<size_t> outOffsets(vertexCount + 1, 0);
+        std::vector<int> outTargets;
+        std::vector<TWeight> outWeights;
+        std::vector<size_t> inOffsets;
+        std::vector<int> inSources;
+        std::vector<TWeight> inWeights;
+        for (int i = 0; i < vertexCount; ++i) {
+            auto edges = vertices.get(i)->getOutgoingEdges();
+            for (int j = 0; j < edges.getLength(); ++j) {
+                outTargets.push_back(indexById.get(edges.get(j)->getTo()->getId()));
+                outWeights.push_back(edges.get(j)->getWeight());
+            }
+            outOffsets[i + 1] = outTargets.size();
+        }
+        if (graph->isDirected()) {
+            inOffsets.assign(vertexCount + 1, 0);
+            for (int i = 0; i < vertexCount; ++i) {
+                auto edges = vertices.get(i)->getIncomingEdges();
+                for (int j = 0; j < edges.getLength(); ++j) {
+                    inSources.push_back(indexById.get(edges.get(j)->getFrom()->getId()));
+                    inWeights.push_back(edges.get(j)->getWeight());
+                }
+                inOffsets[i + 1] = inSources.size();
+            }
+        }
+
+        return CompressedGraph(graph->isDirected(), std::move(ids), std::move(outOffsets), std::move(outTargets),
+                               std::move(outWeights), std::move(inOffsets), std::move(inSources), std::move(inWeights));
+    }
+
+    bool isDirected() const { return directed_; }
+    int getVertexCount() const { return static_cast<int>(ids_.size()); }
+
+    // Число хранимых дуг; неориентированное ребро дает две дуги
+    size_t getArcCount() const { return outTargets_.size(); }
+    size_t getEdgeCount() const { return directed_ ? outTargets_.size() : outTargets_.size() / 2; }
+
+    TIdentifier getId(int vertex) const {
+        checkIndex(vertex);
+        return ids_[vertex];
+    }
+
+    bool hasVertex(TIdentifier id) const {
+        return indexById_.containsKey(id);
+    }
+
+    int getIndex(TIdentifier id) const {
+        if (!indexById_.containsKey(id)) {
+            throw std::invalid_argument("Vertex does not exist in the graph.");
+        }
+        return indexById_.get(id);
+    }
+
+    size_t getOutDegree(int vertex) const {
+        return outOffsets_[vertex + 1] - outOffsets_[vertex];
+    }
+
+    size_t getInDegree(int vertex) const {
+        const auto& offsets = getInOffsets();
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    std::span<const int> getOutNeighbors(int vertex) const {
+        return {outTargets_.data() + outOffsets_[vertex], getOutDegree(vertex)};
+    }
+
+    std::span<const TWeight> getOutWeights(int vertex) const {
+        return {outWeights_.data() + outOffsets_[vertex], getOutDegree(vertex)};
+    }
+
+    std::span<const int> getInNeighbors(int vertex) const {
+        return {getInSources().data() + getInOffsets()[vertex], getInDegree(vertex)};
+    }
+
+    std::span<const TWeight> getInWeights(int vertex) const {
+        const auto& weights = directed_ ? inWeights_ : outWeights_;
+        return {weights.data() + getInOffsets()[vertex], getInDegree(vertex)};
+    }
+
+    // Сырые массивы для алгоритмов, которым нужен последовательный проход по всем дугам
+    const std::vector<size_t>& getOutOffsets() const { return outOffsets_; }
+    const std::vector<int>& getOutTargets() const { return outTargets_; }
+    const std::vector<TWeight>& getOutWeights() const { return outWeights_; }
+    const std::vector<size_t>& getInOffsets() const { return directed_ ? inOffsets_ : outOffsets_; }
+    const std::vector<int>& getInSources() const { return directed_ ? inSources_ : outTargets_; }
+    const std::vector<TWeight>& getInWeights() const { return directed_ ? inWeights_ : outWeights_; }
+};
+
+#endif // COMPRESSEDGRAPH_H
@@ -1,7 +1,7 @@
 #ifndef DIRECTEDGRAPH_H
 #define DIRECTEDGRAPH_H
 
-#include "IGraph.h"
+#include "GraphBase.h"
 #include "iostream"
 #include "HashTableDictionary.h"
 #include "MutableArraySequence.h"
@@ -9,10 +9,14 @@
 #include "Edge.h"
 
 template <typename TWeight, typename TIdentifier>
-class DirectedGraph : public IGraph<TWeight, TIdentifier> {
+class DirectedGraph : public GraphBase<DirectedGraph<TWeight, TIdentifier>, TWeight, TIdentifier> {
+public:
+    using VertexType = Vertex<TWeight, TIdentifier>;
+    using EdgeType = Edge<TWeight, TIdentifier>;
+
 private:
-    using VertexMap = HashTableDictionary<TIdentifier, IVertex<TWeight, TIdentifier>*>;
-    VertexMap vertexMap_;
+    using Base = GraphBase<DirectedGraph<TWeight, TIdentifier>, TWeight, TIdentifier>;
+    friend Base;
 
     void fillOrder(IVertex<TWeight, TIdentifier>* vertex, HashTableDictionary<TIdentifier, bool>& visited,
                    MutableArraySequence<IVertex<TWeight, TIdentifier>*>& stack) const;
@@ -22,18 +26,19 @@ private:
     void dfs(IVertex<TWeight, TIdentifier>* vertex, HashTableDictionary<TIdentifier, bool>& visited,
              MutableArraySequence<IVertex<TWeight, TIdentifier>*>& component) const;
 
+    // Точки расширения GraphBase
+    void linkEdge(VertexType* fromVertex, VertexType* toVertex, TWeight weight);
+    void unlinkEdge(VertexType* fromVertex, VertexType* toVertex);
+    void unlinkEdge(EdgeType* edge);
+    bool containsEdge(const VertexType* fromVertex, const VertexType* toVertex) const;
+
 public:
-    ~DirectedGraph() override;
+    DirectedGraph() = default;
+    DirectedGraph(DirectedGraph&& other) noexcept = default;
+    ~DirectedGraph() override = default;
 
-    void addVertex(IVertex<TWeight, TIdentifier>* vertex) override;
-    void removeVertex(IVertex<TWeight, TIdentifier>* vertex) override;
-    void addEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex, TWeight weight) override;
-    void removeEdge(IVertex<TWeight, TIdentifier>* from, IVertex<TWeight, TIdentifier>* to) override;
-    MutableArraySequence<IVertex<TWeight, TIdentifier>*> getVertices() const override;
     MutableArraySequence<IEdge<TWeight, TIdentifier>*> getEdges(IVertex<TWeight, TIdentifier>* vertex) const override;
-    IVertex<TWeight, TIdentifier>* getVertexById(TIdentifier vertexId) const override;
-    bool hasVertex(IVertex<TWeight, TIdentifier>* vertex) const override;
-    bool hasEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) const override;
+    bool isDirected() const override { return true; }
 };
 
 template <typename TWeight, typename TIdentifier>
@@ -55,9 +60,9 @@ void DirectedGraph<TWeight, TIdentifier>::fillOrder(IVertex<TWeight, TIdentifier
 template <typename TWeight, typename TIdentifier>
 DirectedGraph<TWeight, TIdentifier> DirectedGraph<TWeight, TIdentifier>::getTransposedGraph() const {
     DirectedGraph<TWeight, TIdentifier> transposedGraph;
-    auto vertices = getVertices();
+    auto vertices = this->getVertices();
     for (size_t i = 0; i < vertices.getLength(); ++i) {
-        transposedGraph.addVertex(new Vertex<TWeight, TIdentifier>(vertices.get(i)->getId())); //  Добавляем верш.
+        transposedGraph.createVertex(vertices.get(i)->getId()); //  Добавляем верш.
     }
     for (size_t i = 0; i < vertices.getLength(); ++i) {
         IVertex<TWeight, TIdentifier>* vertex = vertices.get(i);
@@ -73,14 +78,6 @@ DirectedGraph<TWeight, TIdentifier> DirectedGraph<TWeight, TIdentifier>::getTran
 }
 
 
-template <typename TWeight, typename TIdentifier>
-DirectedGraph<TWeight, TIdentifier>::~DirectedGraph() {
-    auto vertices = getVertices();
-    for (size_t i = 0; i < vertices.getLength(); ++i) {
-        delete vertices.get(i); // Удаляем вершины!
-    }
-}
-
 template <typename TWeight, typename TIdentifier>
 void DirectedGraph<TWeight, TIdentifier>::dfs(IVertex<TWeight, TIdentifier>* vertex, HashTableDictionary<TIdentifier, bool>& visited,
                            MutableArraySequence<IVertex<TWeight, TIdentifier>*>& component) const {
@@ -98,87 +95,27 @@ void DirectedGraph<TWeight, TIdentifier>::dfs(IVertex<TWeight, TIdentifier>* ver
 }
 
 template <typename TWeight, typename TIdentifier>
-void DirectedGraph<TWeight, TIdentifier>::addVertex(IVertex<TWeight, TIdentifier>* vertex) {
-    if (!vertex) return;
-
-    if (!vertexMap_.containsKey(vertex->getId())) {
-        vertexMap_.add(vertex->getId(), vertex);
-    }
+void DirectedGraph<TWeight, TIdentifier>::unlinkEdge(EdgeType* edge) {
+    Base::asVertex(edge->getFrom())->removeOutgoingEdge(edge);
+    Base::asVertex(edge->getTo())->removeIncomingEdge(edge);
+    this->edgePool_.destroy(edge);
 }
 
 template <typename TWeight, typename TIdentifier>
-void DirectedGraph<TWeight, TIdentifier>::removeVertex(IVertex<TWeight, TIdentifier>* vertex) {
-    if (!vertex || !vertexMap_.containsKey(vertex->getId())) {
-        return;
-    }
+void DirectedGraph<TWeight, TIdentifier>::linkEdge(VertexType* fromVertex, VertexType* toVertex, TWeight weight) {
+    auto edge = this->edgePool_.create(fromVertex, toVertex, weight);
 
-    // Удаляем входящие ребра
-    auto incomingEdges = vertex->getIncomingEdges();
-    while(incomingEdges.getLength() > 0) {
-      auto edge = incomingEdges.get(0);
-        removeEdge(edge->getFrom(), vertex);
-    }
-
-    // Удаляем исходящие ребра
-    auto outgoingEdges = vertex->getOutgoingEdges();
-
-    while(outgoingEdges.getLength() > 0) {
-       auto edge = outgoingEdges.get(0);
-        removeEdge(vertex, edge->getTo());
-    }
-
-
-    vertexMap_.remove(vertex->getId());
-     // delete vertex;  //  Удалять должен тот, кто создал
+    fromVertex->addOutgoingEdge(edge);
+    toVertex->addIncomingEdge(edge); // Добавляем ТОЛЬКО входящее!
 }
 
-
 template <typename TWeight, typename TIdentifier>
-void DirectedGraph<TWeight, TIdentifier>::addEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex, TWeight weight) {
-    if (!fromVertex || !toVertex) return;
-
-    if (!vertexMap_.containsKey(fromVertex->getId())) {
-        addVertex(fromVertex);
-    }
-    if (!vertexMap_.containsKey(toVertex->getId())) {
-        addVertex(toVertex);
+void DirectedGraph<TWeight, TIdentifier>::unlinkEdge(VertexType* fromVertex, VertexType* toVertex) {
+    // Поиск по индексу соседей, без копирования и прохода по списку
+    auto edge = fromVertex->findOutgoingEdge(toVertex->getId());
+    if (edge) {
+        unlinkEdge(Base::asEdge(edge));
     }
-
-    auto edge = new Edge<TWeight, TIdentifier>(fromVertex, toVertex, weight);
-
-    dynamic_cast<Vertex<TWeight, TIdentifier>*>(fromVertex)->addOutgoingEdge(edge);
-    dynamic_cast<Vertex<TWeight, TIdentifier>*>(toVertex)->addIncomingEdge(edge); // Добавляем ТОЛЬКО входящее!
-}
-
-template <typename TWeight, typename TIdentifier>
-void DirectedGraph<TWeight, TIdentifier>::removeEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) {
- if (!fromVertex || !toVertex || !hasEdge(fromVertex, toVertex)) {
-        return;
-    }
-
-    auto fromVertexOutgoingEdges = dynamic_cast<Vertex<TWeight, TIdentifier>*>(fromVertex)->getOutgoingEdges();
-
-	 for (size_t i = 0; i < fromVertexOutgoingEdges.getLength(); i++)
-	 {
-		  auto edge = fromVertexOutgoingEdges.get(i);
-		  if(edge->getTo() == toVertex)
-		  {
-            dynamic_cast<Vertex<TWeight, TIdentifier>*>(fromVertex)->removeOutgoingEdge(edge);
-            dynamic_cast<Vertex<TWeight, TIdentifier>*>(toVertex)->removeIncomingEdge(edge);
-				delete edge;
-				return;
-		  }
-	 }
-}
-
-template <typename TWeight, typename TIdentifier>
-MutableArraySequence<IVertex<TWeight, TIdentifier>*> DirectedGraph<TWeight, TIdentifier>::getVertices() const {
-    auto items = vertexMap_.getAllItems();
-    MutableArraySequence<IVertex<TWeight, TIdentifier>*> result;
-    for (size_t i = 0; i < items->getLength(); ++i) {
-        result.append(items->get(i).second);
-    }
-    return result;
 }
 
 template <typename TWeight, typename TIdentifier>
@@ -198,30 +135,8 @@ MutableArraySequence<IEdge<TWeight, TIdentifier>*> DirectedGraph<TWeight, TIdent
 }
 
 template <typename TWeight, typename TIdentifier>
-IVertex<TWeight, TIdentifier>* DirectedGraph<TWeight, TIdentifier>::getVertexById(TIdentifier vertexId) const {
-    if (vertexMap_.containsKey(vertexId)) {
-        return vertexMap_.get(vertexId);
-    }
-    return nullptr;
-}
-
-template <typename TWeight, typename TIdentifier>
-bool DirectedGraph<TWeight, TIdentifier>::hasVertex(IVertex<TWeight, TIdentifier>* vertex) const {
-     if (!vertex) return false;
-    return vertexMap_.containsKey(vertex->getId());
-}
-
-template <typename TWeight, typename TIdentifier>
-bool DirectedGraph<TWeight, TIdentifier>::hasEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) const {
-    if (!fromVertex || !toVertex) return false;
-
-    auto outgoingEdges = fromVertex->getOutgoingEdges();
-    for (size_t i = 0; i < outgoingEdges.getLength(); ++i) {
-        if (outgoingEdges.get(i)->getTo()->getId() == toVertex->getId()) {
-            return true;
-        }
-    }
-    return false;
+bool DirectedGraph<TWeight, TIdentifier>::containsEdge(const VertexType* fromVertex, const VertexType* toVertex) const {
+    return fromVertex->findOutgoingEdge(toVertex->getId()) != nullptr;
 }
 
 #endif
\ No newline at end of file
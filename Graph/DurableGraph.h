@@ -0,0 +1,299 @@
+#ifndef DURABLEGRAPH_H
+#define DURABLEGRAPH_H
+
+#include "AppendFile.h"
+#include "CompressedGraph.h"
+#include "DirectedGraph.h"
+#include "GraphBuilder.h"
+#include "MappedGraph.h"
+#include "MutationLog.h"
+#include "UniquePtr.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Ориентированный граф с сохранением на диск: каждое изменение сначала пишется в журнал
+// (MutationLog), затем применяется к графу в памяти. checkpoint сохраняет компактный снимок
+// (файл MappedGraph) и начинает новый журнал; старые снимки и журналы удаляются.
+// При открытии каталога граф восстанавливается: последний корректный снимок плюс записи журналов
+// после него. Оборванный при падении хвост журнала отбрасывается.
+//
+// Файлы каталога: snapshot-<N>.csr - граф после изменений 1..N, log-<M>.wal - изменения начиная с M.
+// Изменения в одной группе журнала (setGroupSize) становятся надежными только после commit.
+template <typename TWeight, typename TIdentifier>
+class DurableGraph {
+public:
+    using Graph = DirectedGraph<TWeight, TIdentifier>;
+    using Log = MutationLog<TWeight, TIdentifier>;
+    using Record = typename Log::Record;
+    using Operation = typename Log::Operation;
+
+    struct RecoveryInfo {
+        uint64_t snapshotSequence = 0; // 0 - граф восстановлен только из журналов
+        size_t replayedRecords = 0;
+        size_t logFiles = 0;
+        bool tornTail = false;         // хвост журнала был оборван и отброшен
+        double seconds = 0.0;
+    };
+
+private:
+    std::filesystem::path directory_;
+    SyncPolicy policy_;
+    UniquePtr<Graph> graph_;
+    UniquePtr<Log> log_;
+    uint64_t sequence_ = 0; // номер последнего примененного изменения
+    size_t groupSize_ = 1;
+    std::chrono::steady_clock::duration syncInterval_ = std::chrono::milliseconds(10);
+    size_t snapshotInterval_ = 0;
+    size_t sinceSnapshot_ = 0;
+    RecoveryInfo recovery_;
+
+    static constexpr const char* kSnapshotPrefix = "snapshot-";
+    static constexpr const char* kSnapshotSuffix = ".csr";
+    static constexpr const char* kLogPrefix = "log-";
+    static constexpr const char* kLogSuffix = ".wal";
+
+    std::filesystem::path fileName(const char* prefix, uint64_t sequence, const char* suffix) const {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%020llu", static_cast<unsigned long long>(sequence));
+        return directory_ / (std::string(prefix) + number + suffix);
+    }
+
+    // Номера файлов каталога с данным префиксом и суффиксом, по возрастанию.
+    // Посторонние файлы, у которых вместо номера не 20 цифр, пропускаются.
+    std::vector<uint64_t> listFiles(const std::string& prefix, const std::string& suffix) const {
+        std::vector<uint64_t> sequences;
+        for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() != prefix.size() + 20 + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+                name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue;
+            }
+            std::string number = name.substr(prefix.size(), 20);
+            if (!std::all_of(number.begin(), number.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+                continue;
+            }
+            sequences.push_back(std::stoull(number));
+        }
+        std::sort(sequences.begin(), sequences.end());
+        return sequences;
+    }
+
+    void apply(const Record& record) {
+        switch (record.operation) {
+            case Operation::AddVertex:
+                graph_->createVertex(record.from);
+                break;
+            case Operation::AddEdge:
+                graph_->addEdge(graph_->createVertex(record.from), graph_->createVertex(record.to), record.weight);
+                break;
+            case Operation::RemoveEdge:
+                graph_->removeEdge(graph_->findVertex(record.from), graph_->findVertex(record.to));
+                break;
+            case Operation::RemoveVertex:
+                graph_->removeVertex(graph_->findVertex(record.from));
+                break;
+        }
+    }
+
+    void mutate(Operation operation, TIdentifier from, TIdentifier to, TWeight weight) {
+        Record record{sequence_ + 1, operation, from, to, weight};
+        log_->append(record);
+        apply(record);
+        ++sequence_;
+        if (snapshotInterval_ > 0 && ++sinceSnapshot_ >= snapshotInterval_) {
+            checkpoint();
+        }
+    }
+
+    // Новый журнал. Синхронизируется и каталог: иначе после сбоя может пропасть сама запись
+    // о файле журнала вместе с уже подтвержденными изменениями в нем
+    void startLog() {
+        log_.reset();
+        log_ = UniquePtr<Log>(new Log(fileName(kLogPrefix, sequence_ + 1, kLogSuffix).string(), sequence_ + 1, policy_));
+        log_->setGroupSize(groupSize_);
+        log_->setSyncInterval(syncInterval_);
+        AppendFile::syncPath(directory_.string());
+    }
+
+    // Снимок читается через отображение в память и собирается пакетно, без поштучных вставок
+    void loadSnapshot(const MappedGraph<TWeight, TIdentifier>& snapshot) {
+        GraphBuilder<TWeight, TIdentifier> builder(snapshot.getVertexCount());
+        builder.reserveEdges(snapshot.getArcCount());
+        for (int v = 0; v < snapshot.getVertexCount(); ++v) {
+            builder.addVertex(snapshot.getId(v));
+        }
+        for (int v = 0; v < snapshot.getVertexCount(); ++v) {
+            auto targets = snapshot.getOutNeighbors(v);
+            auto weights = snapshot.getOutWeights(v);
+            for (size_t i = 0; i < targets.size(); ++i) {
+                builder.addEdge(snapshot.getId(v), snapshot.getId(targets[i]), weights[i]);
+            }
+        }
+        graph_ = UniquePtr<Graph>(new Graph(builder.buildDirected()));
+    }
+
+    void recover() {
+        auto start = std::chrono::steady_clock::now();
+        recovery_ = RecoveryInfo();
+        graph_ = UniquePtr<Graph>(new Graph());
+        sequence_ = 0;
+
+        // Снимки перебираются от нового к старому: испорченный снимок (например, недописанный
+        // при сбое диска) пропускается, если журналы после более старого снимка еще целы
+        std::vector<uint64_t> snapshots = listFiles(kSnapshotPrefix, kSnapshotSuffix);
+        bool loaded = snapshots.empty();
+        for (auto it = snapshots.rbegin(); it != snapshots.rend() && !loaded; ++it) {
+            try {
+                auto snapshot = MappedGraph<TWeight, TIdentifier>::open(fileName(kSnapshotPrefix, *it, kSnapshotSuffix).string(), true);
+                if (!snapshot.isDirected()) {
+                    continue;
+                }
+                loadSnapshot(snapshot);
+                sequence_ = *it;
+                recovery_.snapshotSequence = *it;
+                loaded = true;
+            } catch (const std::runtime_error&) {
+            }
+        }
+        if (!loaded) {
+            throw std::runtime_error("No valid snapshot in " + directory_.string());
+        }
+
+        for (uint64_t first : listFiles(kLogPrefix, kLogSuffix)) {
+            std::string path = fileName(kLogPrefix, first, kLogSuffix).string();
+            if (first > sequence_ + 1) {
+                throw std::runtime_error("Mutation log is missing records before " + path);
+            }
+            // Журнал, оборванный до конца заголовка, не содержит ни одной записи
+            if (std::filesystem::file_size(path) < Log::kHeaderSize) {
+                std::filesystem::remove(path);
+                recovery_.tornTail = true;
+                continue;
+            }
+            if (Log::readFirstSequence(path) != first) {
+                throw std::runtime_error("Mutation log is corrupted: " + path);
+            }
+            auto result = Log::replay(path, sequence_ + 1, [&](const Record& record) { apply(record); });
+            sequence_ = result.nextSequence - 1;
+            recovery_.replayedRecords += result.applied;
+            ++recovery_.logFiles;
+            if (!result.complete) {
+                // Отрезаем оборванный хвост, чтобы он не мешал следующим восстановлениям
+                std::filesystem::resize_file(path, result.validBytes);
+                AppendFile::syncPath(path);
+                recovery_.tornTail = true;
+            }
+        }
+        sinceSnapshot_ = sequence_ - recovery_.snapshotSequence;
+
+        startLog();
+        recovery_.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+public:
+    // Открывает каталог (создает, если его нет) и восстанавливает граф
+    explicit DurableGraph(const std::string& directory, SyncPolicy policy = SyncPolicy::EveryCommit)
+        : directory_(directory), policy_(policy) {
+        std::filesystem::create_directories(directory_);
+        recover();
+    }
+
+    DurableGraph(const DurableGraph&) = delete;
+    DurableGraph& operator=(const DurableGraph&) = delete;
+
+    const Graph& getGraph() const { return *graph_; }
+    uint64_t getSequence() const { return sequence_; }
+    const RecoveryInfo& getRecoveryInfo() const { return recovery_; }
+
+    // Изменения группируются по records записей на одну запись в файл и одну синхронизацию
+    void setGroupSize(size_t records) {
+        log_->setGroupSize(records);
+        groupSize_ = records;
+    }
+
+    void setSyncInterval(std::chrono::steady_clock::duration interval) {
+        syncInterval_ = interval;
+        log_->setSyncInterval(interval);
+    }
+
+    // Автоматический снимок каждые records изменений; 0 - только явный checkpoint
+    void setSnapshotInterval(size_t records) {
+        snapshotInterval_ = records;
+    }
+
+    // Добавляет вершину; false, если она уже есть (тогда в журнал ничего не пишется)
+    bool addVertex(TIdentifier id) {
+        if (graph_->findVertex(id)) {
+            return false;
+        }
+        mutate(Operation::AddVertex, id, id, TWeight());
+        return true;
+    }
+
+    // Недостающие концы ребра создаются, как в GraphBuilder
+    void addEdge(TIdentifier from, TIdentifier to, TWeight weight) {
+        mutate(Operation::AddEdge, from, to, weight);
+    }
+
+    bool removeEdge(TIdentifier from, TIdentifier to) {
+        if (!graph_->hasEdge(graph_->findVertex(from), graph_->findVertex(to))) {
+            return false;
+        }
+        mutate(Operation::RemoveEdge, from, to, TWeight());
+        return true;
+    }
+
+    bool removeVertex(TIdentifier id) {
+        if (!graph_->findVertex(id)) {
+            return false;
+        }
+        mutate(Operation::RemoveVertex, id, id, TWeight());
+        return true;
+    }
+
+    // Записывает накопленную группу изменений и синхронизирует ее по политике
+    void commit() {
+        log_->commit();
+    }
+
+    // Фиксирует все изменения и синхронизирует журнал независимо от политики
+    void sync() {
+        log_->sync();
+    }
+
+    // Снимок текущего графа. Порядок шагов такой, что сбой на любом из них оставляет
+    // восстановимое состояние: снимок пишется во временный файл и атомарно переименовывается,
+    // и только потом удаляются покрытые им журналы и старые снимки.
+    void checkpoint() {
+        log_->sync();
+        std::filesystem::path temporary = directory_ / "snapshot.tmp";
+        MappedGraph<TWeight, TIdentifier>::write(CompressedGraph<TWeight, TIdentifier>::fromGraph(graph_.get()),
+                                                 temporary.string());
+        AppendFile::syncPath(temporary.string());
+        std::filesystem::rename(temporary, fileName(kSnapshotPrefix, sequence_, kSnapshotSuffix));
+        AppendFile::syncPath(directory_.string());
+
+        startLog();
+        for (uint64_t sequence : listFiles(kSnapshotPrefix, kSnapshotSuffix)) {
+            if (sequence < sequence_) {
+                std::filesystem::remove(fileName(kSnapshotPrefix, sequence, kSnapshotSuffix));
+            }
+        }
+        for (uint64_t first : listFiles(kLogPrefix, kLogSuffix)) {
+            if (first <= sequence_) {
+                std::filesystem::remove(fileName(kLogPrefix, first, kLogSuffix));
+            }
+        }
+        AppendFile::syncPath(directory_.string());
+        sinceSnapshot_ = 0;
+    }
+};
+
+#endif // DURABLEGRAPH_H
@@ -0,0 +1,257 @@
+#ifndef GRAPHBASE_H
+#define GRAPHBASE_H
+
+#include "IGraph.h"
+#include "HashTableDictionary.h"
+#include "MutableArraySequence.h"
+#include "ObjectPool.h"
+#include "Vertex.h"
+#include "Edge.h"
+#include <cstddef>
+#include <span>
+#include <utility>
+
+template <typename TWeight, typename TIdentifier>
+class GraphBuilder;
+
+// Общая часть DirectedGraph и UndirectedGraph (CRTP).
+// Типизированный API работает с конкретными Vertex/Edge и вызывает точки расширения
+// наследника статически, без виртуальных вызовов и RTTI:
+//     void linkEdge(VertexType* from, VertexType* to, TWeight weight);
+//     void unlinkEdge(VertexType* from, VertexType* to);     // если ребра нет, ничего не делает
+//     void unlinkEdge(EdgeType* edge);                        // ребро принадлежит графу
+//     bool containsEdge(const VertexType* from, const VertexType* to) const;
+// Реализация IGraph остается адаптером поверх типизированного API для алгоритмов и GUI.
+// Все вершины графа имеют тип Vertex (создаются через createVertex или передаются как new Vertex),
+// поэтому адаптер приводит IVertex* к Vertex* статически.
+template <typename Derived, typename TWeight, typename TIdentifier>
+class GraphBase : public IGraph<TWeight, TIdentifier> {
+public:
+    using VertexType = Vertex<TWeight, TIdentifier>;
+    using EdgeType = Edge<TWeight, TIdentifier>;
+
+protected:
+    using VertexMap = HashTableDictionary<TIdentifier, VertexType*>;
+    VertexMap vertexMap_;
+    // Вершины, созданные через createVertex, и все ребра графа живут в пулах графа
+    ObjectPool<VertexType> vertexPool_;
+    ObjectPool<EdgeType> edgePool_;
+
+    GraphBase() = default;
+    GraphBase(GraphBase&& other) noexcept;
+    ~GraphBase() override;
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    static VertexType* asVertex(IVertex<TWeight, TIdentifier>* vertex) {
+        return static_cast<VertexType*>(vertex);
+    }
+
+    static EdgeType* asEdge(IEdge<TWeight, TIdentifier>* edge) {
+        return static_cast<EdgeType*>(edge);
+    }
+
+    bool containsVertex(const VertexType* vertex) const {
+        return vertexMap_.containsKey(vertex->getId());
+    }
+
+    // Пакетная сборка заранее знает размеры графа и заполняет смежность напрямую
+    friend class GraphBuilder<TWeight, TIdentifier>;
+
+    void reserveStorage(int vertexCount, size_t edgeCount) {
+        if (vertexMap_.getCount() == 0) {
+            vertexMap_ = VertexMap(vertexCount * 2 + 1);
+        }
+        vertexPool_.reserve(vertexCount);
+        edgePool_.reserve(edgeCount);
+    }
+
+public:
+    GraphBase(const GraphBase&) = delete;
+    GraphBase& operator=(const GraphBase&) = delete;
+
+    // Типизированный API
+    VertexType* createVertex(TIdentifier vertexId);
+    VertexType* findVertex(TIdentifier vertexId) const;
+    void addVertex(VertexType* vertex);
+    void addEdge(VertexType* fromVertex, VertexType* toVertex, TWeight weight);
+    void removeVertex(VertexType* vertex);
+    void removeEdge(VertexType* fromVertex, VertexType* toVertex);
+    // Пакетное удаление: каждое ребро отсоединяется по своим ячейкам за O(1).
+    // Ребра должны принадлежать графу и не повторяться (у неориентированного - одна дуга на ребро)
+    void removeEdges(std::span<EdgeType* const> edges);
+    void removeEdges(std::span<const std::pair<VertexType*, VertexType*>> endpoints);
+    bool hasEdge(const VertexType* fromVertex, const VertexType* toVertex) const;
+    int getVertexCount() const { return vertexMap_.getCount(); }
+
+    // Адаптер IGraph
+    void addVertex(IVertex<TWeight, TIdentifier>* vertex) final { addVertex(asVertex(vertex)); }
+    void addEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex, TWeight weight) final {
+        addEdge(asVertex(fromVertex), asVertex(toVertex), weight);
+    }
+    void removeVertex(IVertex<TWeight, TIdentifier>* vertex) final { removeVertex(asVertex(vertex)); }
+    void removeEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) final {
+        removeEdge(asVertex(fromVertex), asVertex(toVertex));
+    }
+    bool hasEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) const final {
+        return hasEdge(static_cast<const VertexType*>(asVertex(fromVertex)), static_cast<const VertexType*>(asVertex(toVertex)));
+    }
+    MutableArraySequence<IVertex<TWeight, TIdentifier>*> getVertices() const final;
+    IVertex<TWeight, TIdentifier>* getVertexById(TIdentifier vertexId) const final { return findVertex(vertexId); }
+    bool hasVertex(IVertex<TWeight, TIdentifier>* vertex) const final;
+};
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+GraphBase<Derived, TWeight, TIdentifier>::GraphBase(GraphBase&& other) noexcept
+    : vertexPool_(std::move(other.vertexPool_)), edgePool_(std::move(other.edgePool_)) {
+    // Таблица вершин забирается обменом с пустой, без копирования
+    vertexMap_.swap(other.vertexMap_);
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+GraphBase<Derived, TWeight, TIdentifier>::~GraphBase() {
+    for (auto it = vertexMap_.begin(); it != vertexMap_.end(); ++it) {
+        VertexType* vertex = (*it).second;
+        if (vertex->isPooled()) {
+            vertexPool_.destroy(vertex);
+        } else {
+            delete vertex; // Удаляем вершины!
+        }
+    }
+    // Ребра освобождаются разом вместе с edgePool_
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+typename GraphBase<Derived, TWeight, TIdentifier>::VertexType*
+GraphBase<Derived, TWeight, TIdentifier>::createVertex(TIdentifier vertexId) {
+    if (vertexMap_.containsKey(vertexId)) {
+        return vertexMap_.get(vertexId);
+    }
+    VertexType* vertex = vertexPool_.create(vertexId);
+    vertex->markPooled();
+    vertexMap_.add(vertexId, vertex);
+    return vertex;
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+typename GraphBase<Derived, TWeight, TIdentifier>::VertexType*
+GraphBase<Derived, TWeight, TIdentifier>::findVertex(TIdentifier vertexId) const {
+    if (vertexMap_.containsKey(vertexId)) {
+        return vertexMap_.get(vertexId);
+    }
+    return nullptr;
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::addVertex(VertexType* vertex) {
+    if (!vertex) return;
+
+    if (!vertexMap_.containsKey(vertex->getId())) {
+        vertexMap_.add(vertex->getId(), vertex);
+    }
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::addEdge(VertexType* fromVertex, VertexType* toVertex, TWeight weight) {
+    if (!fromVertex || !toVertex) return;
+
+    if (!containsVertex(fromVertex)) {
+        addVertex(fromVertex);
+    }
+    if (!containsVertex(toVertex)) {
+        addVertex(toVertex);
+    }
+    derived().linkEdge(fromVertex, toVertex, weight);
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::removeVertex(VertexType* vertex) {
+    if (!vertex || !containsVertex(vertex)) {
+        return;
+    }
+
+    // Все инцидентные ребра отсоединяются за один проход: у соседа ребро удаляется по своей
+    // ячейке за O(1), а собственные списки вершины сбрасываются целиком.
+    // Неориентированный граф хранит встречную дугу во входящих, поэтому обход тот же.
+    const auto& outgoing = vertex->getOutgoingList().getEdges();
+    const auto& incoming = vertex->getIncomingList().getEdges();
+    for (int i = 0; i < outgoing.getLength(); ++i) {
+        auto to = asVertex(outgoing.get(i)->getTo());
+        if (to != vertex) {
+            to->removeIncomingEdge(outgoing.get(i));
+        }
+    }
+    for (int i = 0; i < incoming.getLength(); ++i) {
+        auto from = asVertex(incoming.get(i)->getFrom());
+        if (from != vertex) {
+            from->removeOutgoingEdge(incoming.get(i));
+        }
+    }
+
+    // Петли лежат в обоих списках, освобождаем их вместе с исходящими
+    for (int i = 0; i < incoming.getLength(); ++i) {
+        if (incoming.get(i)->getFrom() != vertex) {
+            edgePool_.destroy(asEdge(incoming.get(i)));
+        }
+    }
+    for (int i = 0; i < outgoing.getLength(); ++i) {
+        edgePool_.destroy(asEdge(outgoing.get(i)));
+    }
+    vertex->clearEdges();
+
+    vertexMap_.remove(vertex->getId());
+    // Удалять должен тот, кто создал: вершины из createVertex создал граф
+    if (vertex->isPooled()) {
+        vertexPool_.destroy(vertex);
+    }
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::removeEdge(VertexType* fromVertex, VertexType* toVertex) {
+    if (!fromVertex || !toVertex) {
+        return;
+    }
+    // Наследник сам ищет ребро и ничего не делает, если его нет
+    derived().unlinkEdge(fromVertex, toVertex);
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::removeEdges(std::span<EdgeType* const> edges) {
+    for (EdgeType* edge : edges) {
+        if (edge) {
+            derived().unlinkEdge(edge);
+        }
+    }
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+void GraphBase<Derived, TWeight, TIdentifier>::removeEdges(std::span<const std::pair<VertexType*, VertexType*>> endpoints) {
+    for (const auto& endpoint : endpoints) {
+        removeEdge(endpoint.first, endpoint.second);
+    }
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+bool GraphBase<Derived, TWeight, TIdentifier>::hasEdge(const VertexType* fromVertex, const VertexType* toVertex) const {
+    if (!fromVertex || !toVertex) return false;
+    return derived().containsEdge(fromVertex, toVertex);
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+MutableArraySequence<IVertex<TWeight, TIdentifier>*> GraphBase<Derived, TWeight, TIdentifier>::getVertices() const {
+    auto items = vertexMap_.getAllItems();
+    MutableArraySequence<IVertex<TWeight, TIdentifier>*> result;
+    for (int i = 0; i < items->getLength(); ++i) {
+        result.append(items->get(i).second);
+    }
+    return result;
+}
+
+template <typename Derived, typename TWeight, typename TIdentifier>
+bool GraphBase<Derived, TWeight, TIdentifier>::hasVertex(IVertex<TWeight, TIdentifier>* vertex) const {
+    if (!vertex) return false;
+    return vertexMap_.containsKey(vertex->getId());
+}
+
+#endif // GRAPHBASE_H
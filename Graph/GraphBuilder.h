@@ -0,0 +1,272 @@
+#ifndef GRAPHBUILDER_H
+#define GRAPHBUILDER_H
+
+#include "CompressedGraph.h"
+#include "DirectedGraph.h"
+#include "HashTableDictionary.h"
+#include "ThreadPool.h"
+#include "UndirectedGraph.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Пакетная сборка графа из списка ребер.
+// Ребра накапливаются в плоских массивах плотных индексов, затем при сборке сортируются
+// подсчетом по началу (и по концу для входящих дуг). Это дает точные степени, поэтому массивы
+// смежности вершин выделяются один раз нужного размера, без проверок containsKey на каждое ребро.
+// С пулом потоков (setThreadPool) сортировка подсчетом и заполнение смежности идут параллельно;
+// результат совпадает с последовательной сборкой, порядок соседей - порядок добавления ребер.
+template <typename TWeight, typename TIdentifier>
+class GraphBuilder {
+public:
+    struct EdgeRecord {
+        TIdentifier from;
+        TIdentifier to;
+        TWeight weight;
+    };
+
+private:
+    // Ниже этого числа дуг параллельная сортировка не окупает накладные расходы
+    static constexpr size_t kParallelThreshold = size_t(1) << 16;
+
+    std::vector<TIdentifier> ids_;
+    HashTableDictionary<TIdentifier, int> indexById_;
+    std::vector<int> sources_;
+    std::vector<int> targets_;
+    std::vector<TWeight> weights_;
+    ThreadPool* pool_ = nullptr;
+
+    // Дуги сборки: для ориентированного графа совпадают с ребрами,
+    // неориентированное ребро e дает дугу 2e (from -> to) и дугу 2e + 1 (to -> from)
+    struct Arcs {
+        const int* sources;
+        const int* targets;
+        size_t count;
+        bool doubled;
+
+        int source(size_t arc) const { return doubled ? (arc % 2 ? targets[arc / 2] : sources[arc / 2]) : sources[arc]; }
+        int target(size_t arc) const { return doubled ? (arc % 2 ? sources[arc / 2] : targets[arc / 2]) : targets[arc]; }
+        size_t edge(size_t arc) const { return doubled ? arc / 2 : arc; }
+    };
+
+    // Результат сортировки подсчетом: дуги вершины v - order[offsets[v] .. offsets[v + 1])
+    struct Grouping {
+        std::vector<size_t> offsets;
+        std::vector<size_t> order;
+    };
+
+    Arcs makeArcs(bool directed) const {
+        return Arcs{sources_.data(), targets_.data(), directed ? sources_.size() : sources_.size() * 2, !directed};
+    }
+
+    // Устойчивая сортировка дуг подсчетом по key(arc): возвращает offsets размера V + 1
+    // и для каждой дуги вызывает place(arc, position) с ее позицией в отсортированном порядке
+    template <typename KeyFunction, typename PlaceFunction>
+    std::vector<size_t> groupBy(size_t count, KeyFunction key, PlaceFunction place) const {
+        int vertexCount = getVertexCount();
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+
+        size_t chunks = pool_ && count >= kParallelThreshold ? pool_->getThreadCount() : 1;
+        if (chunks <= 1) {
+            for (size_t arc = 0; arc < count; ++arc) {
+                ++offsets[key(arc) + 1];
+            }
+            for (int v = 0; v < vertexCount; ++v) {
+                offsets[v + 1] += offsets[v];
+            }
+            std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t arc = 0; arc < count; ++arc) {
+                place(arc, cursor[key(arc)]++);
+            }
+            return offsets;
+        }
+
+        // Каждый поток считает свою гистограмму по своему куску дуг, затем раскладывает
+        // дуги со своих позиций; куски идут по порядку, поэтому сортировка устойчивая
+        size_t chunkSize = (count + chunks - 1) / chunks;
+        std::vector<size_t> counts(chunks * vertexCount, 0);
+        pool_->parallelFor(0, chunks, [&](size_t lo, size_t hi) {
+            for (size_t chunk = lo; chunk < hi; ++chunk) {
+                size_t* chunkCounts = counts.data() + chunk * vertexCount;
+                for (size_t arc = chunk * chunkSize; arc < std::min(count, (chunk + 1) * chunkSize); ++arc) {
+                    ++chunkCounts[key(arc)];
+                }
+            }
+        });
+        pool_->parallelFor(0, vertexCount, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                size_t running = 0;
+                for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                    size_t chunkCount = counts[chunk * vertexCount + v];
+                    counts[chunk * vertexCount + v] = running;
+                    running += chunkCount;
+                }
+                offsets[v + 1] = running;
+            }
+        }, 1024);
+        for (int v = 0; v < vertexCount; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        pool_->parallelFor(0, chunks, [&](size_t lo, size_t hi) {
+            for (size_t chunk = lo; chunk < hi; ++chunk) {
+                size_t* chunkCursor = counts.data() + chunk * vertexCount;
+                for (size_t arc = chunk * chunkSize; arc < std::min(count, (chunk + 1) * chunkSize); ++arc) {
+                    int v = key(arc);
+                    place(arc, offsets[v] + chunkCursor[v]++);
+                }
+            }
+        });
+        return offsets;
+    }
+
+    template <typename KeyFunction>
+    Grouping groupArcs(size_t count, KeyFunction key) const {
+        Grouping grouping;
+        grouping.order.resize(count);
+        grouping.offsets = groupBy(count, key, [&](size_t arc, size_t position) { grouping.order[position] = arc; });
+        return grouping;
+    }
+
+    void forEachVertex(const std::function<void(size_t, size_t)>& body) const {
+        if (pool_) {
+            pool_->parallelFor(0, getVertexCount(), body, 256);
+        } else {
+            body(0, getVertexCount());
+        }
+    }
+
+    template <typename TGraph>
+    TGraph buildGraph(bool directed) const {
+        Arcs arcs = makeArcs(directed);
+        Grouping outgoing = groupArcs(arcs.count, [&](size_t arc) { return arcs.source(arc); });
+        Grouping incoming = groupArcs(arcs.count, [&](size_t arc) { return arcs.target(arc); });
+
+        TGraph graph;
+        graph.reserveStorage(getVertexCount(), arcs.count);
+        std::vector<typename TGraph::VertexType*> vertices(getVertexCount());
+        for (int v = 0; v < getVertexCount(); ++v) {
+            vertices[v] = graph.createVertex(ids_[v]);
+        }
+
+        // Пул ребер не потокобезопасен, поэтому сами ребра создаются последовательно
+        std::vector<typename TGraph::EdgeType*> edges(arcs.count);
+        for (size_t arc = 0; arc < arcs.count; ++arc) {
+            edges[arc] = graph.edgePool_.create(vertices[arcs.source(arc)], vertices[arcs.target(arc)],
+                                                weights_[arcs.edge(arc)]);
+        }
+
+        forEachVertex([&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                auto vertex = vertices[v];
+                vertex->reserveOutgoingEdges(static_cast<int>(outgoing.offsets[v + 1] - outgoing.offsets[v]));
+                for (size_t i = outgoing.offsets[v]; i < outgoing.offsets[v + 1]; ++i) {
+                    vertex->addOutgoingEdge(edges[outgoing.order[i]]);
+                }
+                vertex->reserveIncomingEdges(static_cast<int>(incoming.offsets[v + 1] - incoming.offsets[v]));
+                for (size_t i = incoming.offsets[v]; i < incoming.offsets[v + 1]; ++i) {
+                    vertex->addIncomingEdge(edges[incoming.order[i]]);
+                }
+            }
+        });
+        return graph;
+    }
+
+public:
+    explicit GraphBuilder(int vertexCountHint = 0) : indexById_(vertexCountHint * 2 + 1) {
+        if (vertexCountHint < 0) {
+            throw std::invalid_argument("Vertex count hint must be non-negative.");
+        }
+        ids_.reserve(vertexCountHint);
+    }
+
+    // nullptr - последовательная сборка
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    void reserveEdges(size_t edgeCount) {
+        sources_.reserve(edgeCount);
+        targets_.reserve(edgeCount);
+        weights_.reserve(edgeCount);
+    }
+
+    // Добавляет вершину (в том числе изолированную), возвращает ее плотный индекс
+    int addVertex(TIdentifier id) {
+        if (const int* index = indexById_.find(id)) {
+            return *index;
+        }
+        int index = static_cast<int>(ids_.size());
+        ids_.push_back(id);
+        indexById_.add(id, index);
+        return index;
+    }
+
+    void addEdge(TIdentifier from, TIdentifier to, TWeight weight) {
+        int fromIndex = addVertex(from);
+        int toIndex = addVertex(to);
+        sources_.push_back(fromIndex);
+        targets_.push_back(toIndex);
+        weights_.push_back(weight);
+    }
+
+    void addEdges(std::span<const EdgeRecord> edges) {
+        reserveEdges(sources_.size() + edges.size());
+        for (const auto& edge : edges) {
+            addEdge(edge.from, edge.to, edge.weight);
+        }
+    }
+
+    int getVertexCount() const { return static_cast<int>(ids_.size()); }
+    size_t getEdgeCount() const { return sources_.size(); }
+
+    DirectedGraph<TWeight, TIdentifier> buildDirected() const {
+        return buildGraph<DirectedGraph<TWeight, TIdentifier>>(true);
+    }
+
+    UndirectedGraph<TWeight, TIdentifier> buildUndirected() const {
+        return buildGraph<UndirectedGraph<TWeight, TIdentifier>>(false);
+    }
+
+    CompressedGraph<TWeight, TIdentifier> buildCompressed(bool directed = true) const {
+        Arcs arcs = makeArcs(directed);
+        // Дуги раскладываются сразу в массивы соседей и весов, без промежуточной перестановки
+        std::vector<int> outTargets(arcs.count);
+        std::vector<TWeight> outWeights(arcs.count);
+        std::vector<size_t> outOffsets = groupBy(arcs.count, [&](size_t arc) { return arcs.source(arc); },
+                                                 [&](size_t arc, size_t position) {
+                                                     outTargets[position] = arcs.target(arc);
+                                                     outWeights[position] = weights_[arcs.edge(arc)];
+                                                 });
+
+        std::vector<size_t> inOffsets;
+        std::vector<int> inSources;
+        std::vector<TWeight> inWeights;
+        if (directed) {
+            inSources.resize(arcs.count);
+            inWeights.resize(arcs.count);
+            inOffsets = groupBy(arcs.count, [&](size_t arc) { return arcs.target(arc); },
+                                [&](size_t arc, size_t position) {
+                                    inSources[position] = arcs.source(arc);
+                                    inWeights[position] = weights_[arcs.edge(arc)];
+                                });
+        }
+
+        return CompressedGraph<TWeight, TIdentifier>(directed, ids_, std::move(outOffsets), std::move(outTargets),
+                                                     std::move(outWeights), std::move(inOffsets), std::move(inSources),
+                                                     std::move(inWeights));
+    }
+
+    void clear() {
+        ids_.clear();
+        indexById_ = HashTableDictionary<TIdentifier, int>();
+        sources_.clear();
+        targets_.clear();
+        weights_.clear();
+    }
+};
+
+#endif // GRAPHBUILDER_H
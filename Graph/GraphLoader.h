@@ -0,0 +1,456 @@
+#ifndef GRAPHLOADER_H
+#define GRAPHLOADER_H
+
+#include "CompressedGraph.h"
+#include "GraphBuilder.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Чтение графов из текстовых форматов:
+//   EdgeList     - строки "from to [weight]", комментарии с '#' или '%', вес по умолчанию 1;
+//   Dimacs       - DIMACS shortest path (.gr): "p sp n m", дуги "a u v w", комментарии "c";
+//   MatrixMarket - coordinate real | integer | pattern, general (ориентированный) или symmetric (неориентированный);
+//   Metis        - заголовок "n m [fmt [ncon]]", строка i - соседи вершины i (ребро записано у обоих концов).
+// Файл отображается в память и режется на куски по границам строк; куски разбираются параллельно через
+// from_chars без iostream, затем ребра в порядке файла передаются в GraphBuilder. Вершины DIMACS,
+// Matrix Market и METIS - номера 1 .. n, все они добавляются в граф, включая изолированные.
+template <typename TWeight, typename TIdentifier>
+class GraphLoader {
+    static_assert(std::is_integral_v<TIdentifier>, "Text graph formats use integer vertex identifiers.");
+
+public:
+    enum class Format { EdgeList, Dimacs, MatrixMarket, Metis };
+
+    using Builder = GraphBuilder<TWeight, TIdentifier>;
+    using EdgeRecord = typename Builder::EdgeRecord;
+
+    static constexpr size_t kDefaultChunkBytes = size_t(1) << 22;
+
+private:
+    ThreadPool* pool_;
+    size_t chunkBytes_ = kDefaultChunkBytes;
+
+    // Ошибка в позиции position; номер строки считается только при выдаче сообщения
+    struct ParseError {
+        const char* position;
+        const char* message;
+    };
+
+    struct Cursor {
+        const char* position;
+        const char* end;
+
+        void skipBlanks() {
+            while (position < end && (*position == ' ' || *position == '\t' || *position == '\r')) {
+                ++position;
+            }
+        }
+
+        bool atLineEnd() {
+            skipBlanks();
+            return position == end || *position == '\n';
+        }
+
+        // Строка, начинающаяся с символа comment, или пустая
+        bool skippable(char comment, char otherComment = '\0') {
+            if (atLineEnd()) return true;
+            return *position == comment || (otherComment && *position == otherComment);
+        }
+
+        void nextLine() {
+            const void* newline = std::memchr(position, '\n', end - position);
+            position = newline ? static_cast<const char*>(newline) + 1 : end;
+        }
+
+        template <typename T>
+        T read(const char* message) {
+            skipBlanks();
+            T value{};
+            auto [next, error] = std::from_chars(position, end, value);
+            if (error != std::errc()) {
+                throw ParseError{position, message};
+            }
+            position = next;
+            return value;
+        }
+
+        TWeight readWeight() {
+            skipBlanks();
+            TWeight value{};
+            auto [next, error] = std::from_chars(position, end, value);
+            if constexpr (std::is_integral_v<TWeight>) {
+                // Целый вес в вещественной записи: "2.0", "1e3". Дробный или не помещающийся в TWeight
+                // вес - ошибка, а не молчаливое округление
+                if (error == std::errc() && next < end && (*next == '.' || *next == 'e' || *next == 'E')) {
+                    double real = 0;
+                    auto parsed = std::from_chars(position, end, real);
+                    // max() + 1 - степень двойки и точно представима в double, в отличие от самого max()
+                    double limit = 2.0 * static_cast<double>(std::numeric_limits<TWeight>::max() / 2 + 1);
+                    if (parsed.ec == std::errc() &&
+                        (real != std::trunc(real) || real < static_cast<double>(std::numeric_limits<TWeight>::min()) ||
+                         real >= limit)) {
+                        throw ParseError{position, "Weight is not an integer"};
+                    }
+                    next = parsed.ptr;
+                    error = parsed.ec;
+                    value = static_cast<TWeight>(real);
+                }
+            }
+            if (error != std::errc()) {
+                throw ParseError{position, "Invalid weight"};
+            }
+            position = next;
+            return value;
+        }
+
+        std::string_view readWord() {
+            skipBlanks();
+            const char* start = position;
+            while (position < end && !std::isspace(static_cast<unsigned char>(*position))) {
+                ++position;
+            }
+            return {start, static_cast<size_t>(position - start)};
+        }
+
+        void expectLineEnd() {
+            if (!atLineEnd()) {
+                throw ParseError{position, "Unexpected text at end of line"};
+            }
+            nextLine();
+        }
+    };
+
+    using Chunks = std::vector<std::vector<EdgeRecord>>;
+
+    // Границы кусков: кусок i - [bounds[i], bounds[i + 1]), каждый начинается с начала строки
+    std::vector<const char*> split(const char* begin, const char* end) const {
+        size_t size = static_cast<size_t>(end - begin);
+        size_t pieces = std::max<size_t>(1, (size + chunkBytes_ - 1) / chunkBytes_);
+        std::vector<const char*> bounds{begin};
+        for (size_t i = 1; i < pieces; ++i) {
+            Cursor cursor{begin + size * i / pieces, end};
+            if (cursor.position[-1] != '\n') {
+                cursor.nextLine();
+            }
+            bounds.push_back(std::max(bounds.back(), cursor.position));
+        }
+        bounds.push_back(end);
+        return bounds;
+    }
+
+    template <typename Body>
+    void forEachChunk(size_t count, Body body) const {
+        auto run = [&](size_t first, size_t last) {
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                body(chunk);
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, count, run, 1);
+        } else {
+            run(0, count);
+        }
+    }
+
+    static size_t feed(Builder& builder, const Chunks& chunks) {
+        size_t count = 0;
+        for (const auto& chunk : chunks) {
+            count += chunk.size();
+        }
+        builder.reserveEdges(builder.getEdgeCount() + count);
+        for (const auto& chunk : chunks) {
+            builder.addEdges(chunk);
+        }
+        return count;
+    }
+
+    static void addVertices(Builder& builder, size_t count) {
+        for (size_t id = 1; id <= count; ++id) {
+            builder.addVertex(static_cast<TIdentifier>(id));
+        }
+    }
+
+    // Номер вершины 1 .. count
+    static TIdentifier readVertex(Cursor& cursor, size_t count) {
+        const char* start = cursor.position;
+        long long id = cursor.template read<long long>("Invalid vertex");
+        if (id < 1 || static_cast<size_t>(id) > count) {
+            throw ParseError{start, "Vertex is out of range"};
+        }
+        return static_cast<TIdentifier>(id);
+    }
+
+    bool readEdgeList(const char* begin, const char* end, Builder& builder, bool directed) const {
+        auto bounds = split(begin, end);
+        Chunks chunks(bounds.size() - 1);
+        forEachChunk(chunks.size(), [&](size_t chunk) {
+            Cursor cursor{bounds[chunk], bounds[chunk + 1]};
+            while (cursor.position < cursor.end) {
+                if (cursor.skippable('#', '%')) {
+                    cursor.nextLine();
+                    continue;
+                }
+                TIdentifier from = cursor.template read<TIdentifier>("Invalid vertex");
+                TIdentifier to = cursor.template read<TIdentifier>("Invalid vertex");
+                TWeight weight = cursor.atLineEnd() ? TWeight(1) : cursor.readWeight();
+                cursor.expectLineEnd();
+                chunks[chunk].push_back({from, to, weight});
+            }
+        });
+        feed(builder, chunks);
+        return directed;
+    }
+
+    bool readDimacs(const char* begin, const char* end, Builder& builder, const std::string& path) const {
+        Cursor header{begin, end};
+        while (header.position < end && header.skippable('c')) {
+            header.nextLine();
+        }
+        if (header.readWord() != "p" || header.readWord() != "sp") {
+            throw ParseError{header.position, "Expected problem line \"p sp n m\""};
+        }
+        size_t n = header.template read<size_t>("Invalid vertex count");
+        size_t m = header.template read<size_t>("Invalid arc count");
+        header.expectLineEnd();
+
+        auto bounds = split(header.position, end);
+        Chunks chunks(bounds.size() - 1);
+        forEachChunk(chunks.size(), [&](size_t chunk) {
+            Cursor cursor{bounds[chunk], bounds[chunk + 1]};
+            while (cursor.position < cursor.end) {
+                if (cursor.skippable('c')) {
+                    cursor.nextLine();
+                    continue;
+                }
+                if (*cursor.position != 'a') {
+                    throw ParseError{cursor.position, "Expected arc line \"a u v w\""};
+                }
+                ++cursor.position;
+                TIdentifier from = readVertex(cursor, n);
+                TIdentifier to = readVertex(cursor, n);
+                TWeight weight = cursor.readWeight();
+                cursor.expectLineEnd();
+                chunks[chunk].push_back({from, to, weight});
+            }
+        });
+        addVertices(builder, n);
+        if (feed(builder, chunks) != m) {
+            throw std::runtime_error("Arc count does not match the problem line: " + path);
+        }
+        return true;
+    }
+
+    bool readMatrixMarket(const char* begin, const char* end, Builder& builder, const std::string& path) const {
+        Cursor header{begin, end};
+        auto lower = [](std::string_view word) {
+            std::string result(word);
+            for (char& c : result) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return result;
+        };
+        if (header.readWord() != "%%MatrixMarket" || lower(header.readWord()) != "matrix") {
+            throw std::runtime_error("Not a Matrix Market file: " + path);
+        }
+        std::string layout = lower(header.readWord());
+        std::string field = lower(header.readWord());
+        std::string symmetry = lower(header.readWord());
+        if (layout != "coordinate" || (field != "real" && field != "integer" && field != "pattern") ||
+            (symmetry != "general" && symmetry != "symmetric")) {
+            throw std::runtime_error("Unsupported Matrix Market format: " + path);
+        }
+        header.nextLine();
+        while (header.position < end && header.skippable('%')) {
+            header.nextLine();
+        }
+        size_t rows = header.template read<size_t>("Invalid row count");
+        size_t columns = header.template read<size_t>("Invalid column count");
+        size_t entries = header.template read<size_t>("Invalid entry count");
+        header.expectLineEnd();
+        bool pattern = field == "pattern";
+
+        auto bounds = split(header.position, end);
+        Chunks chunks(bounds.size() - 1);
+        forEachChunk(chunks.size(), [&](size_t chunk) {
+            Cursor cursor{bounds[chunk], bounds[chunk + 1]};
+            while (cursor.position < cursor.end) {
+                if (cursor.skippable('%')) {
+                    cursor.nextLine();
+                    continue;
+                }
+                TIdentifier row = readVertex(cursor, rows);
+                TIdentifier column = readVertex(cursor, columns);
+                TWeight weight = pattern ? TWeight(1) : cursor.readWeight();
+                cursor.expectLineEnd();
+                chunks[chunk].push_back({row, column, weight});
+            }
+        });
+        addVertices(builder, std::max(rows, columns));
+        if (feed(builder, chunks) != entries) {
+            throw std::runtime_error("Entry count does not match the size line: " + path);
+        }
+        return symmetry == "general";
+    }
+
+    bool readMetis(const char* begin, const char* end, Builder& builder, const std::string& path) const {
+        Cursor header{begin, end};
+        while (header.position < end && *header.position == '%') {
+            header.nextLine();
+        }
+        size_t n = header.template read<size_t>("Invalid vertex count");
+        size_t m = header.template read<size_t>("Invalid edge count");
+        std::string_view format = header.atLineEnd() ? std::string_view("0") : header.readWord();
+        size_t constraints = header.atLineEnd() ? 1 : header.template read<size_t>("Invalid constraint count");
+        header.expectLineEnd();
+        if (format.size() > 3 || format.find_first_not_of("01") != std::string_view::npos) {
+            throw std::runtime_error("Unsupported METIS format code: " + path);
+        }
+        // Цифры fmt справа налево: веса ребер, веса вершин, размеры вершин
+        auto flag = [&](size_t digit) { return format.size() > digit && format[format.size() - 1 - digit] == '1'; };
+        bool edgeWeights = flag(0);
+        size_t vertexValues = (flag(1) ? constraints : 0) + (flag(2) ? 1 : 0);
+
+        // Строка = вершина, поэтому сначала число строк в каждом куске; комментарии не считаются
+        auto bounds = split(header.position, end);
+        size_t chunkCount = bounds.size() - 1;
+        std::vector<size_t> firstVertex(chunkCount + 1, 0);
+        forEachChunk(chunkCount, [&](size_t chunk) {
+            Cursor cursor{bounds[chunk], bounds[chunk + 1]};
+            size_t lines = 0;
+            while (cursor.position < cursor.end) {
+                lines += *cursor.position != '%';
+                cursor.nextLine();
+            }
+            firstVertex[chunk + 1] = lines;
+        });
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            firstVertex[chunk + 1] += firstVertex[chunk];
+        }
+        if (firstVertex[chunkCount] < n) {
+            throw std::runtime_error("METIS file has fewer adjacency lines than vertices: " + path);
+        }
+
+        Chunks chunks(chunkCount);
+        forEachChunk(chunkCount, [&](size_t chunk) {
+            Cursor cursor{bounds[chunk], bounds[chunk + 1]};
+            size_t vertex = firstVertex[chunk];
+            while (cursor.position < cursor.end) {
+                if (*cursor.position == '%') {
+                    cursor.nextLine();
+                    continue;
+                }
+                ++vertex;
+                if (vertex > n) {
+                    if (!cursor.atLineEnd()) {
+                        throw ParseError{cursor.position, "More adjacency lines than vertices"};
+                    }
+                    cursor.nextLine();
+                    continue;
+                }
+                for (size_t i = 0; i < vertexValues; ++i) {
+                    cursor.template read<long long>("Invalid vertex weight");
+                }
+                while (!cursor.atLineEnd()) {
+                    TIdentifier neighbor = readVertex(cursor, n);
+                    TWeight weight = edgeWeights ? cursor.readWeight() : TWeight(1);
+                    // Ребро записано у обоих концов; берется запись у меньшего
+                    if (static_cast<size_t>(neighbor) > vertex) {
+                        chunks[chunk].push_back({static_cast<TIdentifier>(vertex), neighbor, weight});
+                    }
+                }
+                cursor.nextLine();
+            }
+        });
+        addVertices(builder, n);
+        if (feed(builder, chunks) != m) {
+            throw std::runtime_error("Edge count does not match the header: " + path);
+        }
+        return false;
+    }
+
+public:
+    explicit GraphLoader(ThreadPool* pool = nullptr) : pool_(pool) {}
+
+    // nullptr - последовательный разбор
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // Примерный размер куска текста на одну задачу разбора
+    void setChunkBytes(size_t bytes) {
+        if (bytes == 0) {
+            throw std::invalid_argument("Chunk size must be greater than 0.");
+        }
+        chunkBytes_ = bytes;
+    }
+
+    // Формат по расширению: .gr, .mtx, .graph / .metis; остальное - список ребер
+    static Format detectFormat(const std::string& path) {
+        std::string extension = std::filesystem::path(path).extension().string();
+        for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (extension == ".gr") return Format::Dimacs;
+        if (extension == ".mtx") return Format::MatrixMarket;
+        if (extension == ".graph" || extension == ".metis") return Format::Metis;
+        return Format::EdgeList;
+    }
+
+    // Ребра файла в builder; возвращает ориентированность графа по формату
+    // (для списка ребер она задается edgeListDirected)
+    bool read(const std::string& path, Format format, Builder& builder, bool edgeListDirected = true) const {
+        MappedFile file(path);
+        file.adviseSequential();
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+        if (begin == end) {
+            if (format != Format::EdgeList) {
+                throw std::runtime_error("Graph file is empty: " + path);
+            }
+            return edgeListDirected;
+        }
+        try {
+            switch (format) {
+                case Format::Dimacs:
+                    return readDimacs(begin, end, builder, path);
+                case Format::MatrixMarket:
+                    return readMatrixMarket(begin, end, builder, path);
+                case Format::Metis:
+                    return readMetis(begin, end, builder, path);
+                default:
+                    return readEdgeList(begin, end, builder, edgeListDirected);
+            }
+        } catch (const ParseError& error) {
+            size_t line = 1 + static_cast<size_t>(std::count(begin, error.position, '\n'));
+            const char* lineStart = error.position;
+            while (lineStart > begin && lineStart[-1] != '\n') {
+                --lineStart;
+            }
+            size_t column = 1 + static_cast<size_t>(error.position - lineStart);
+            throw std::runtime_error(std::string(error.message) + " at line " + std::to_string(line) + ", column " +
+                                     std::to_string(column) + ": " + path);
+        }
+    }
+
+    CompressedGraph<TWeight, TIdentifier> load(const std::string& path, Format format, bool edgeListDirected = true) const {
+        Builder builder;
+        builder.setThreadPool(pool_);
+        bool directed = read(path, format, builder, edgeListDirected);
+        return builder.buildCompressed(directed);
+    }
+
+    CompressedGraph<TWeight, TIdentifier> load(const std::string& path) const {
+        return load(path, detectFormat(path));
+    }
+};
+
+#endif // GRAPHLOADER_H
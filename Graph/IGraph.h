@@ -21,6 +21,7 @@ public:
     virtual IVertex<TWeight, TIdentifier>* getVertexById(TIdentifier vertexId) const = 0;
     virtual bool hasVertex(IVertex<TWeight, TIdentifier>* vertex) const = 0;
     virtual bool hasEdge(IVertex<TWeight, TIdentifier>* fromVertex, IVertex<TWeight, TIdentifier>* toVertex) const = 0;
+    virtual bool isDirected() const = 0;
 };
 
 #endif // IGRAPH_H
\ No newline at end of file
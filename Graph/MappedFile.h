@@ -0,0 +1,125 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPEDFILE_USE_MMAP 1
+#endif
+
+// Файл, отображенный в память только для чтения. Страницы подгружаются по обращению и делятся
+// между процессами через страничный кэш. Без mmap файл читается в выровненный буфер.
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint64_t> buffer_; // запасной вариант без mmap
+
+    void release() {
+#ifdef MAPPEDFILE_USE_MMAP
+        if (mapped_) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+    }
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+#ifdef MAPPEDFILE_USE_MMAP
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        struct stat info {};
+        if (fstat(descriptor, &info) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+            if (address == MAP_FAILED) {
+                ::close(descriptor);
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            data_ = static_cast<const char*>(address);
+            mapped_ = true;
+        }
+        // Отображение остается действительным и после закрытия дескриптора
+        ::close(descriptor);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        size_ = static_cast<size_t>(in.tellg());
+        buffer_.resize((size_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer_.data()), size_);
+        if (!in) {
+            throw std::runtime_error("Cannot read file: " + path);
+        }
+        data_ = reinterpret_cast<const char*>(buffer_.data());
+#endif
+    }
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(other.data_), size_(other.size_), mapped_(other.mapped_), buffer_(std::move(other.buffer_)) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            buffer_ = std::move(other.buffer_);
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        release();
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isMapped() const { return mapped_; }
+
+    // Подсказка ядру о порядке чтения: весь файл будет прочитан подряд
+    void adviseSequential() const {
+#ifdef MAPPEDFILE_USE_MMAP
+        if (mapped_) {
+            madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+        }
+#endif
+    }
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,346 @@
+#ifndef MAPPEDGRAPH_H
+#define MAPPEDGRAPH_H
+
+#include "CompressedGraph.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Двоичный формат снимка CompressedGraph (версия 1, порядок байтов машины):
+//   заголовок Header: сигнатура "CSRG", версия, коды и размеры типов веса и идентификатора,
+//   флаги (бит 0 - ориентированный), число вершин и дуг, таблица секций {смещение, размер, контрольная сумма}
+//   и контрольная сумма самого заголовка;
+//   секции, каждая с границы kSectionAlignment байт:
+//     ids       - идентификаторы вершин по индексам,
+//     idOrder   - индексы int32, упорядоченные по идентификатору (поиск индекса по идентификатору),
+//     outOffsets, outTargets, outWeights - исходящие дуги (смещения uint64, концы int32),
+//     inOffsets, inSources, inWeights    - входящие дуги, пустые у неориентированного графа.
+// Файл читается через mmap без разбора и копирования: массивы секций используются на месте.
+class GraphFileFormat {
+public:
+    static constexpr char kMagic[4] = {'C', 'S', 'R', 'G'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kSectionAlignment = 64;
+    static constexpr uint32_t kDirectedFlag = 1;
+
+    enum SectionId { kIds, kIdOrder, kOutOffsets, kOutTargets, kOutWeights, kInOffsets, kInSources, kInWeights,
+                     kSectionCount };
+
+    struct Section {
+        uint64_t offset;
+        uint64_t size;     // в байтах
+        uint64_t checksum;
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t weightType;
+        uint32_t weightSize;
+        uint32_t idType;
+        uint32_t idSize;
+        uint32_t flags;
+        uint32_t sectionCount;
+        uint64_t vertexCount;
+        uint64_t arcCount;
+        Section sections[kSectionCount];
+        uint64_t headerChecksum; // по всем предыдущим байтам заголовка
+    };
+
+    // Код типа: 1 - целое со знаком, 2 - беззнаковое, 3 - с плавающей точкой
+    template <typename T>
+    static constexpr uint32_t typeCode() {
+        if constexpr (std::is_floating_point_v<T>) {
+            return 3;
+        } else if constexpr (std::is_signed_v<T>) {
+            return 1;
+        } else {
+            return 2;
+        }
+    }
+
+    // 64-битная контрольная сумма: четыре независимые цепочки по 8-байтовым словам, около байта за такт
+    static uint64_t checksum(const char* data, size_t size) {
+        constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+        auto round = [](uint64_t state, uint64_t word) {
+            state += word * kPrime2;
+            state = (state << 31) | (state >> 33);
+            return state * kPrime1;
+        };
+        uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+        size_t position = 0;
+        for (; position + 32 <= size; position += 32) {
+            for (int lane = 0; lane < 4; ++lane) {
+                uint64_t word;
+                std::memcpy(&word, data + position + 8 * lane, sizeof(word));
+                lanes[lane] = round(lanes[lane], word);
+            }
+        }
+        uint64_t hash = size;
+        for (int lane = 0; lane < 4; ++lane) {
+            hash = round(hash ^ lanes[lane], lane + 1);
+        }
+        for (; position < size; position += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, data + position, std::min<size_t>(8, size - position));
+            hash = round(hash, word);
+        }
+        hash ^= hash >> 29;
+        hash *= kPrime1;
+        return hash ^ (hash >> 32);
+    }
+};
+
+// Неизменяемое представление графа прямо в отображенном файле. Интерфейс чтения повторяет CompressedGraph,
+// но массивы - std::span поверх страниц файла; toCompressed копирует их в обычный снимок для алгоритмов.
+template <typename TWeight, typename TIdentifier>
+class MappedGraph {
+    static_assert(std::is_trivially_copyable_v<TWeight> && std::is_trivially_copyable_v<TIdentifier>,
+                  "Graph file stores weights and identifiers as raw bytes.");
+    static_assert(sizeof(int) == 4 && sizeof(size_t) == 8, "Graph file requires 32-bit int and 64-bit size_t.");
+
+private:
+    using Format = GraphFileFormat;
+
+    MappedFile file_;
+    bool directed_ = true;
+    std::span<const TIdentifier> ids_;
+    std::span<const int> idOrder_;
+    std::span<const size_t> outOffsets_;
+    std::span<const int> outTargets_;
+    std::span<const TWeight> outWeights_;
+    std::span<const size_t> inOffsets_;
+    std::span<const int> inSources_;
+    std::span<const TWeight> inWeights_;
+
+    const Format::Header& header() const {
+        return *reinterpret_cast<const Format::Header*>(file_.data());
+    }
+
+    template <typename T>
+    std::span<const T> section(Format::SectionId id) const {
+        const auto& entry = header().sections[id];
+        return {reinterpret_cast<const T*>(file_.data() + entry.offset), static_cast<size_t>(entry.size / sizeof(T))};
+    }
+
+    void checkIndex(int vertex) const {
+        if (vertex < 0 || vertex >= getVertexCount()) {
+            throw std::out_of_range("Vertex index is out of range.");
+        }
+    }
+
+    MappedGraph(MappedFile file, const std::string& path, bool verify) : file_(std::move(file)) {
+        if (file_.size() < sizeof(Format::Header) ||
+            std::memcmp(file_.data(), Format::kMagic, sizeof(Format::kMagic)) != 0) {
+            throw std::runtime_error("Not a graph file: " + path);
+        }
+        const auto& head = header();
+        if (head.version != Format::kVersion || head.sectionCount != Format::kSectionCount ||
+            head.weightType != Format::typeCode<TWeight>() || head.weightSize != sizeof(TWeight) ||
+            head.idType != Format::typeCode<TIdentifier>() || head.idSize != sizeof(TIdentifier) ||
+            head.vertexCount > INT_MAX) {
+            throw std::runtime_error("Unsupported graph file format: " + path);
+        }
+        if (head.headerChecksum != Format::checksum(file_.data(), offsetof(Format::Header, headerChecksum))) {
+            throw std::runtime_error("Graph file is corrupted: " + path);
+        }
+
+        directed_ = (head.flags & Format::kDirectedFlag) != 0;
+        uint64_t v = head.vertexCount;
+        uint64_t arcs = head.arcCount;
+        uint64_t inArcs = directed_ ? arcs : 0;
+        uint64_t inVertices = directed_ ? v + 1 : 0;
+        const uint64_t expected[Format::kSectionCount] = {
+            v * sizeof(TIdentifier), v * sizeof(int), (v + 1) * sizeof(size_t), arcs * sizeof(int),
+            arcs * sizeof(TWeight), inVertices * sizeof(size_t), inArcs * sizeof(int), inArcs * sizeof(TWeight)};
+        for (int id = 0; id < Format::kSectionCount; ++id) {
+            const auto& entry = head.sections[id];
+            if (entry.size != expected[id] || entry.offset % Format::kSectionAlignment != 0) {
+                throw std::runtime_error("Unsupported graph file format: " + path);
+            }
+            if (entry.offset > file_.size() || entry.size > file_.size() - entry.offset) {
+                throw std::runtime_error("Graph file is truncated: " + path);
+            }
+        }
+
+        ids_ = section<TIdentifier>(Format::kIds);
+        idOrder_ = section<int>(Format::kIdOrder);
+        outOffsets_ = section<size_t>(Format::kOutOffsets);
+        outTargets_ = section<int>(Format::kOutTargets);
+        outWeights_ = section<TWeight>(Format::kOutWeights);
+        inOffsets_ = section<size_t>(Format::kInOffsets);
+        inSources_ = section<int>(Format::kInSources);
+        inWeights_ = section<TWeight>(Format::kInWeights);
+        if (outOffsets_.front() != 0 || outOffsets_.back() != arcs || (directed_ && inOffsets_.back() != arcs)) {
+            throw std::runtime_error("Graph file is corrupted: " + path);
+        }
+        if (verify) {
+            verifyChecksums();
+        }
+    }
+
+public:
+    // Запись снимка; массивы пишутся как есть, порядок индексов по идентификатору вычисляется здесь
+    static void write(const CompressedGraph<TWeight, TIdentifier>& graph, const std::string& path) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        size_t v = static_cast<size_t>(graph.getVertexCount());
+        std::vector<TIdentifier> ids(v);
+        for (size_t i = 0; i < v; ++i) {
+            ids[i] = graph.getId(static_cast<int>(i));
+        }
+        std::vector<int> idOrder(v);
+        std::iota(idOrder.begin(), idOrder.end(), 0);
+        std::sort(idOrder.begin(), idOrder.end(), [&](int a, int b) { return ids[a] < ids[b]; });
+
+        // У пустого снимка по умолчанию входящие смещения не заполнены
+        const std::vector<size_t> emptyOffsets(1, 0);
+        const auto& inOffsets = graph.getInOffsets().empty() ? emptyOffsets : graph.getInOffsets();
+
+        const char* data[Format::kSectionCount] = {
+            reinterpret_cast<const char*>(ids.data()),
+            reinterpret_cast<const char*>(idOrder.data()),
+            reinterpret_cast<const char*>(graph.getOutOffsets().data()),
+            reinterpret_cast<const char*>(graph.getOutTargets().data()),
+            reinterpret_cast<const char*>(graph.getOutWeights().data()),
+            reinterpret_cast<const char*>(inOffsets.data()),
+            reinterpret_cast<const char*>(graph.getInSources().data()),
+            reinterpret_cast<const char*>(graph.getInWeights().data())};
+        size_t arcs = graph.getArcCount();
+        size_t inArcs = graph.isDirected() ? arcs : 0;
+        size_t inVertices = graph.isDirected() ? v + 1 : 0;
+        const uint64_t sizes[Format::kSectionCount] = {
+            v * sizeof(TIdentifier), v * sizeof(int), (v + 1) * sizeof(size_t), arcs * sizeof(int),
+            arcs * sizeof(TWeight), inVertices * sizeof(size_t), inArcs * sizeof(int), inArcs * sizeof(TWeight)};
+
+        auto align = [](uint64_t offset) {
+            return (offset + Format::kSectionAlignment - 1) / Format::kSectionAlignment * Format::kSectionAlignment;
+        };
+        Format::Header head{};
+        std::memcpy(head.magic, Format::kMagic, sizeof(Format::kMagic));
+        head.version = Format::kVersion;
+        head.weightType = Format::typeCode<TWeight>();
+        head.weightSize = sizeof(TWeight);
+        head.idType = Format::typeCode<TIdentifier>();
+        head.idSize = sizeof(TIdentifier);
+        head.flags = graph.isDirected() ? Format::kDirectedFlag : 0;
+        head.sectionCount = Format::kSectionCount;
+        head.vertexCount = v;
+        head.arcCount = arcs;
+        uint64_t offset = align(sizeof(Format::Header));
+        for (int id = 0; id < Format::kSectionCount; ++id) {
+            head.sections[id] = {offset, sizes[id], Format::checksum(data[id], sizes[id])};
+            offset = align(offset + sizes[id]);
+        }
+        head.headerChecksum = Format::checksum(reinterpret_cast<const char*>(&head), offsetof(Format::Header, headerChecksum));
+
+        const char padding[Format::kSectionAlignment] = {};
+        out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+        uint64_t written = sizeof(head);
+        for (int id = 0; id < Format::kSectionCount; ++id) {
+            out.write(padding, head.sections[id].offset - written);
+            out.write(data[id], sizes[id]);
+            written = head.sections[id].offset + sizes[id];
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write graph file: " + path);
+        }
+    }
+
+    // Отображение файла; заголовок и размеры секций проверяются всегда, контрольные суммы секций -
+    // только при verify, так как это полный проход по файлу
+    static MappedGraph open(const std::string& path, bool verify = false) {
+        return MappedGraph(MappedFile(path), path, verify);
+    }
+
+    void verifyChecksums() const {
+        for (int id = 0; id < Format::kSectionCount; ++id) {
+            const auto& entry = header().sections[id];
+            if (Format::checksum(file_.data() + entry.offset, entry.size) != entry.checksum) {
+                throw std::runtime_error("Graph file checksum mismatch.");
+            }
+        }
+    }
+
+    // Копия в обычный снимок для алгоритмов, принимающих CompressedGraph
+    CompressedGraph<TWeight, TIdentifier> toCompressed() const {
+        auto copy = [](auto span) { return std::vector<typename decltype(span)::value_type>(span.begin(), span.end()); };
+        return CompressedGraph<TWeight, TIdentifier>(directed_, copy(ids_), copy(outOffsets_), copy(outTargets_),
+                                                     copy(outWeights_), copy(inOffsets_), copy(inSources_),
+                                                     copy(inWeights_));
+    }
+
+    bool isDirected() const { return directed_; }
+    int getVertexCount() const { return static_cast<int>(ids_.size()); }
+    size_t getArcCount() const { return outTargets_.size(); }
+    size_t getEdgeCount() const { return directed_ ? outTargets_.size() : outTargets_.size() / 2; }
+    size_t getFileSize() const { return file_.size(); }
+
+    TIdentifier getId(int vertex) const {
+        checkIndex(vertex);
+        return ids_[vertex];
+    }
+
+    // Двоичный поиск по idOrder: O(log V) без построения хеш-таблицы при открытии
+    bool hasVertex(TIdentifier id) const {
+        auto it = std::lower_bound(idOrder_.begin(), idOrder_.end(), id,
+                                   [&](int index, const TIdentifier& key) { return ids_[index] < key; });
+        return it != idOrder_.end() && !(id < ids_[*it]);
+    }
+
+    int getIndex(TIdentifier id) const {
+        auto it = std::lower_bound(idOrder_.begin(), idOrder_.end(), id,
+                                   [&](int index, const TIdentifier& key) { return ids_[index] < key; });
+        if (it == idOrder_.end() || id < ids_[*it]) {
+            throw std::invalid_argument("Vertex does not exist in the graph.");
+        }
+        return *it;
+    }
+
+    size_t getOutDegree(int vertex) const {
+        return outOffsets_[vertex + 1] - outOffsets_[vertex];
+    }
+
+    size_t getInDegree(int vertex) const {
+        auto offsets = getInOffsets();
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    std::span<const int> getOutNeighbors(int vertex) const {
+        return outTargets_.subspan(outOffsets_[vertex], getOutDegree(vertex));
+    }
+
+    std::span<const TWeight> getOutWeights(int vertex) const {
+        return outWeights_.subspan(outOffsets_[vertex], getOutDegree(vertex));
+    }
+
+    std::span<const int> getInNeighbors(int vertex) const {
+        return getInSources().subspan(getInOffsets()[vertex], getInDegree(vertex));
+    }
+
+    std::span<const TWeight> getInWeights(int vertex) const {
+        return getInWeights().subspan(getInOffsets()[vertex], getInDegree(vertex));
+    }
+
+    std::span<const size_t> getOutOffsets() const { return outOffsets_; }
+    std::span<const int> getOutTargets() const { return outTargets_; }
+    std::span<const TWeight> getOutWeights() const { return outWeights_; }
+    std::span<const size_t> getInOffsets() const { return directed_ ? inOffsets_ : outOffsets_; }
+    std::span<const int> getInSources() const { return directed_ ? inSources_ : outTargets_; }
+    std::span<const TWeight> getInWeights() const { return directed_ ? inWeights_ : outWeights_; }
+};
+
+#endif // MAPPEDGRAPH_H
@@ -0,0 +1,234 @@
+#ifndef MUTATIONLOG_H
+#define MUTATIONLOG_H
+
+#include "AppendFile.h"
+#include "MappedFile.h"
+#include "MappedGraph.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Когда записанные в журнал изменения синхронизируются на диск:
+//   None        - никогда явно, данные попадают на диск, когда решит ОС (переживают падение процесса,
+//                 но не системы);
+//   EveryCommit - при каждой фиксации группы;
+//   Interval    - при фиксации, если с прошлой синхронизации прошло не меньше заданного интервала.
+enum class SyncPolicy { None, EveryCommit, Interval };
+
+// Журнал изменений графа (write-ahead log): заголовок "GWAL" с версией, кодами и размерами типов
+// и номером первой записи, затем записи фиксированного размера
+// {uint64 номер, uint32 операция, uint32 контрольная сумма, from, to, weight}.
+// Записи копятся в буфере и пишутся группой (group commit) одним вызовом write: при заполнении
+// группы из groupSize записей или при явном commit. Оборванный при падении хвост распознается
+// по размеру и контрольной сумме записи; чтение останавливается на первой неполной записи.
+template <typename TWeight, typename TIdentifier>
+class MutationLog {
+    static_assert(std::is_trivially_copyable_v<TWeight> && std::is_trivially_copyable_v<TIdentifier>,
+                  "Mutation log stores weights and identifiers as raw bytes.");
+
+public:
+    enum class Operation : uint32_t { AddVertex = 1, AddEdge = 2, RemoveEdge = 3, RemoveVertex = 4 };
+
+    struct Record {
+        uint64_t sequence;
+        Operation operation;
+        TIdentifier from;
+        TIdentifier to;
+        TWeight weight;
+    };
+
+    // Итог чтения журнала: номер следующей ожидаемой записи и причина остановки
+    struct ReplayResult {
+        uint64_t nextSequence;
+        size_t applied;
+        bool complete;     // false - хвост оборван или испорчен
+        size_t validBytes; // длина корректного префикса файла
+    };
+
+    static constexpr char kMagic[4] = {'G', 'W', 'A', 'L'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = sizeof(kMagic) + 5 * sizeof(uint32_t) + sizeof(uint64_t);
+    static constexpr size_t kRecordSize = (16 + 2 * sizeof(TIdentifier) + sizeof(TWeight) + 7) / 8 * 8;
+
+private:
+    AppendFile file_;
+    std::string path_;
+    std::vector<char> buffer_;
+    SyncPolicy policy_;
+    size_t groupSize_ = 1;
+    std::chrono::steady_clock::duration syncInterval_ = std::chrono::milliseconds(10);
+    std::chrono::steady_clock::time_point lastSync_ = std::chrono::steady_clock::now();
+    bool dirty_ = false; // записано, но не синхронизировано
+
+    static uint32_t recordChecksum(const char* record) {
+        char copy[kRecordSize];
+        std::memcpy(copy, record, kRecordSize);
+        std::memset(copy + 12, 0, sizeof(uint32_t));
+        return static_cast<uint32_t>(GraphFileFormat::checksum(copy, kRecordSize));
+    }
+
+    static void encode(const Record& record, char* out) {
+        std::memset(out, 0, kRecordSize);
+        uint32_t operation = static_cast<uint32_t>(record.operation);
+        std::memcpy(out, &record.sequence, sizeof(uint64_t));
+        std::memcpy(out + 8, &operation, sizeof(uint32_t));
+        std::memcpy(out + 16, &record.from, sizeof(TIdentifier));
+        std::memcpy(out + 16 + sizeof(TIdentifier), &record.to, sizeof(TIdentifier));
+        std::memcpy(out + 16 + 2 * sizeof(TIdentifier), &record.weight, sizeof(TWeight));
+        uint32_t checksum = recordChecksum(out);
+        std::memcpy(out + 12, &checksum, sizeof(uint32_t));
+    }
+
+    static bool decode(const char* in, Record& record) {
+        uint32_t operation;
+        uint32_t checksum;
+        std::memcpy(&record.sequence, in, sizeof(uint64_t));
+        std::memcpy(&operation, in + 8, sizeof(uint32_t));
+        std::memcpy(&checksum, in + 12, sizeof(uint32_t));
+        std::memcpy(&record.from, in + 16, sizeof(TIdentifier));
+        std::memcpy(&record.to, in + 16 + sizeof(TIdentifier), sizeof(TIdentifier));
+        std::memcpy(&record.weight, in + 16 + 2 * sizeof(TIdentifier), sizeof(TWeight));
+        record.operation = static_cast<Operation>(operation);
+        return checksum == recordChecksum(in) && operation >= 1 && operation <= 4;
+    }
+
+    static void header(uint64_t firstSequence, char* out) {
+        uint32_t fields[5] = {kVersion, GraphFileFormat::typeCode<TWeight>(), static_cast<uint32_t>(sizeof(TWeight)),
+                              GraphFileFormat::typeCode<TIdentifier>(), static_cast<uint32_t>(sizeof(TIdentifier))};
+        std::memcpy(out, kMagic, sizeof(kMagic));
+        std::memcpy(out + sizeof(kMagic), fields, sizeof(fields));
+        std::memcpy(out + sizeof(kMagic) + sizeof(fields), &firstSequence, sizeof(firstSequence));
+    }
+
+public:
+    // Новый журнал, первая запись которого получит номер firstSequence; существующий файл заменяется
+    MutationLog(const std::string& path, uint64_t firstSequence, SyncPolicy policy)
+        : path_(path), policy_(policy) {
+        std::filesystem::remove(path);
+        file_ = AppendFile(path);
+        char head[kHeaderSize];
+        header(firstSequence, head);
+        file_.append(head, kHeaderSize);
+        file_.sync();
+    }
+
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    ~MutationLog() {
+        try {
+            commit();
+            if (dirty_ && policy_ != SyncPolicy::None) {
+                file_.sync();
+            }
+        } catch (...) {
+        }
+    }
+
+    // Число записей в группе: при заполнении группа фиксируется автоматически
+    void setGroupSize(size_t records) {
+        if (records == 0) {
+            throw std::invalid_argument("Group size must be greater than 0.");
+        }
+        groupSize_ = records;
+        buffer_.reserve(groupSize_ * kRecordSize);
+    }
+
+    void setSyncInterval(std::chrono::steady_clock::duration interval) {
+        syncInterval_ = interval;
+    }
+
+    void append(const Record& record) {
+        size_t size = buffer_.size();
+        buffer_.resize(size + kRecordSize);
+        encode(record, buffer_.data() + size);
+        if (buffer_.size() >= groupSize_ * kRecordSize) {
+            commit();
+        }
+    }
+
+    size_t getPendingCount() const { return buffer_.size() / kRecordSize; }
+    const std::string& getPath() const { return path_; }
+
+    // Запись накопленной группы и синхронизация по политике
+    void commit() {
+        if (!buffer_.empty()) {
+            file_.append(buffer_.data(), buffer_.size());
+            buffer_.clear();
+            dirty_ = true;
+        }
+        if (!dirty_) return;
+        auto now = std::chrono::steady_clock::now();
+        if (policy_ == SyncPolicy::EveryCommit || (policy_ == SyncPolicy::Interval && now - lastSync_ >= syncInterval_)) {
+            file_.sync();
+            lastSync_ = now;
+            dirty_ = false;
+        }
+    }
+
+    // Фиксация и синхронизация независимо от политики
+    void sync() {
+        commit();
+        if (dirty_) {
+            file_.sync();
+            lastSync_ = std::chrono::steady_clock::now();
+            dirty_ = false;
+        }
+    }
+
+    // Номер первой записи журнала из заголовка
+    static uint64_t readFirstSequence(const std::string& path) {
+        MappedFile file(path);
+        checkHeader(file, path);
+        uint64_t firstSequence;
+        std::memcpy(&firstSequence, file.data() + kHeaderSize - sizeof(uint64_t), sizeof(firstSequence));
+        return firstSequence;
+    }
+
+    // Передает visit записи с номерами nextSequence, nextSequence + 1, ...; более ранние записи
+    // пропускаются (они уже есть в снимке). Чтение прекращается на оборванной или испорченной записи
+    // и на разрыве нумерации.
+    template <typename Visitor>
+    static ReplayResult replay(const std::string& path, uint64_t nextSequence, Visitor visit) {
+        MappedFile file(path);
+        checkHeader(file, path);
+        file.adviseSequential();
+        ReplayResult result{nextSequence, 0, true, kHeaderSize};
+        size_t offset = kHeaderSize;
+        Record record{};
+        for (; offset + kRecordSize <= file.size(); offset += kRecordSize) {
+            if (!decode(file.data() + offset, record) || record.sequence > result.nextSequence) {
+                result.complete = false;
+                return result;
+            }
+            if (record.sequence == result.nextSequence) {
+                visit(record);
+                ++result.nextSequence;
+                ++result.applied;
+            }
+            result.validBytes = offset + kRecordSize;
+        }
+        result.complete = offset == file.size();
+        return result;
+    }
+
+private:
+    static void checkHeader(const MappedFile& file, const std::string& path) {
+        if (file.size() < kHeaderSize || std::memcmp(file.data(), kMagic, sizeof(kMagic)) != 0) {
+            throw std::runtime_error("Not a mutation log: " + path);
+        }
+        char expected[kHeaderSize];
+        header(0, expected);
+        if (std::memcmp(file.data(), expected, kHeaderSize - sizeof(uint64_t)) != 0) {
+            throw std::runtime_error("Unsupported mutation log format: " + path);
+        }
+    }
+};
+
+#endif // MUTATIONLOG_H
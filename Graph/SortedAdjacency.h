@@ -0,0 +1,74 @@
+#ifndef SORTEDADJACENCY_H
+#define SORTEDADJACENCY_H
+
+#include "CompressedGraph.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Простой граф поверх снимка CompressedGraph: соседи каждой вершины - различные индексы
+// по возрастанию, без петель (для ориентированного снимка - концы исходящих дуг).
+// Кратные дуги схлопываются, поэтому степень - число различных соседей.
+// Нужен алгоритмам, которые пересекают списки соседей или считают степени простого графа.
+template <typename TWeight, typename TIdentifier>
+class SortedAdjacency {
+private:
+    std::vector<size_t> offsets_;
+    std::vector<int> neighbors_;
+    bool directed_;
+
+public:
+    // С пулом сортировка списков идет параллельно по вершинам
+    explicit SortedAdjacency(const CompressedGraph<TWeight, TIdentifier>& graph, ThreadPool* pool = nullptr)
+        : directed_(graph.isDirected()) {
+        int n = graph.getVertexCount();
+        auto forVertices = [&](const std::function<void(size_t, size_t)>& body) {
+            if (pool) {
+                pool->parallelFor(0, n, body, 256);
+            } else {
+                body(0, n);
+            }
+        };
+
+        // Соседи копируются как есть, сортируются и сжимаются на месте; затем массив уплотняется
+        std::vector<int> scratch(graph.getOutTargets());
+        const std::vector<size_t>& rawOffsets = graph.getOutOffsets();
+        std::vector<size_t> degree(n);
+        forVertices([&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                auto first = scratch.begin() + rawOffsets[v];
+                auto last = scratch.begin() + rawOffsets[v + 1];
+                std::sort(first, last);
+                last = std::unique(first, last);
+                last = std::remove(first, last, static_cast<int>(v));
+                degree[v] = last - first;
+            }
+        });
+        offsets_.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            offsets_[v + 1] = offsets_[v] + degree[v];
+        }
+        neighbors_.resize(offsets_[n]);
+        forVertices([&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                std::copy_n(scratch.begin() + rawOffsets[v], degree[v], neighbors_.begin() + offsets_[v]);
+            }
+        });
+    }
+
+    int getVertexCount() const { return static_cast<int>(offsets_.size()) - 1; }
+
+    // Число ребер простого графа; для снимка ориентированного графа - число различных дуг
+    size_t getEdgeCount() const { return directed_ ? neighbors_.size() : neighbors_.size() / 2; }
+
+    size_t getDegree(int vertex) const { return offsets_[vertex + 1] - offsets_[vertex]; }
+
+    std::span<const int> getNeighbors(int vertex) const {
+        return {neighbors_.data() + offsets_[vertex], getDegree(vertex)};
+    }
+};
+
+#endif // SORTEDADJACENCY_H
@@ -0,0 +1,652 @@
+#ifndef VERSIONEDGRAPH_H
+#define VERSIONEDGRAPH_H
+
+#include "CompressedGraph.h"
+#include "DirectedGraph.h"
+#include "EpochReclamation.h"
+#include "GraphBuilder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Ориентированный граф с версиями (MVCC) для одного писателя и любого числа читателей.
+// Писатель меняет граф и публикует новую версию через commit; читатель берет snapshot - неизменяемую
+// опубликованную версию, которую можно обходить, пока писатель продолжает работу. Читатели не
+// блокируются и не блокируют писателя.
+//
+// Таблица вершин и списки смежности - фрагментированные массивы: деревья с ветвлением 64, в листьях
+// до 64 элементов. Изменение копирует только путь от корня до листа (path copying), остальные узлы
+// общие с прошлыми версиями. Узел, созданный в текущей неопубликованной версии, меняется на месте,
+// поэтому commit стоит O(число измененных листьев), а не O(V + E). Замененные узлы освобождаются
+// по эпохам (EpochManager), когда их не может читать ни один snapshot.
+//
+// Идентификатор получает плотный индекс при первом добавлении и сохраняет его навсегда: удаленная
+// вершина помечается как удаленная, повторное добавление возвращает ее на тот же индекс.
+// Методы изменения вызываются из одного потока; snapshot - из любого. Снимки не должны переживать граф.
+template <typename TWeight, typename TIdentifier>
+class VersionedGraph {
+    static_assert(std::is_trivially_copyable_v<TWeight> && std::is_trivially_copyable_v<TIdentifier>,
+                  "Versioned graph copies weights and identifiers as raw bytes.");
+
+public:
+    // Дуга списка смежности: сосед (конец для исходящих, начало для входящих) и вес
+    struct Arc {
+        int vertex;
+        TWeight weight;
+    };
+
+private:
+    static constexpr int kBits = 6;
+    static constexpr size_t kFanout = size_t(1) << kBits;
+    static constexpr size_t kMask = kFanout - 1;
+
+    // Узел фрагментированного массива. owner - версия, в которой узел создан: пока она не опубликована,
+    // узел виден только писателю и меняется на месте
+    struct alignas(16) Node {
+        uint64_t owner;
+        uint32_t count;
+        uint32_t capacity;
+    };
+
+    struct Array {
+        Node* root = nullptr;
+        size_t size = 0;
+    };
+
+    struct VertexEntry {
+        TIdentifier id;
+        Array out;
+        Array in;
+        bool alive;
+    };
+
+    struct Root {
+        uint64_t version;
+        Array vertices;
+        int vertexCount;
+        size_t edgeCount;
+    };
+
+    // Вставляемая только писателем таблица идентификатор -> индекс. Читатель видит ячейку после
+    // записи индекса (release/acquire); при росте новая таблица публикуется целиком, старая уходит в retire
+    struct IdTable {
+        struct Slot {
+            std::atomic<int> index{-1};
+            TIdentifier id{};
+        };
+
+        size_t mask;
+        size_t count = 0;
+        Slot* slots;
+
+        explicit IdTable(size_t capacity) : mask(capacity - 1), slots(new Slot[capacity]) {}
+        ~IdTable() { delete[] slots; }
+
+        static size_t position(const TIdentifier& id) {
+            unsigned long long mixed = static_cast<unsigned long long>(std::hash<TIdentifier>()(id));
+            mixed ^= mixed >> 33;
+            mixed *= 0xff51afd7ed558ccdULL;
+            mixed ^= mixed >> 33;
+            return static_cast<size_t>(mixed);
+        }
+
+        int find(const TIdentifier& id) const {
+            for (size_t p = position(id) & mask;; p = (p + 1) & mask) {
+                int index = slots[p].index.load(std::memory_order_acquire);
+                if (index < 0) return -1;
+                if (slots[p].id == id) return index;
+            }
+        }
+
+        void insert(const TIdentifier& id, int index) {
+            size_t p = position(id) & mask;
+            while (slots[p].index.load(std::memory_order_relaxed) >= 0) {
+                p = (p + 1) & mask;
+            }
+            slots[p].id = id;
+            slots[p].index.store(index, std::memory_order_release);
+            ++count;
+        }
+    };
+
+    // Контекст изменения: версия, узлы которой можно менять на месте, и куда отдавать замененные узлы
+    struct Transaction {
+        uint64_t version;
+        EpochManager& epochs;
+    };
+
+    template <typename Item>
+    static Item* items(Node* node) {
+        return reinterpret_cast<Item*>(reinterpret_cast<char*>(node) + sizeof(Node));
+    }
+
+    template <typename Item>
+    static const Item* items(const Node* node) {
+        return reinterpret_cast<const Item*>(reinterpret_cast<const char*>(node) + sizeof(Node));
+    }
+
+    template <typename Item>
+    static Node* allocate(uint64_t owner, uint32_t capacity) {
+        void* memory = ::operator new(sizeof(Node) + capacity * sizeof(Item));
+        return new (memory) Node{owner, 0, capacity};
+    }
+
+    static void deallocate(void* node) {
+        ::operator delete(node);
+    }
+
+    static void deleteRoot(void* root) {
+        delete static_cast<Root*>(root);
+    }
+
+    static void deleteIdTable(void* table) {
+        delete static_cast<IdTable*>(table);
+    }
+
+    // Высота дерева массива из size элементов: 0 - корень является листом
+    static int height(size_t size) {
+        int h = 0;
+        for (size_t capacity = kFanout; size > capacity; capacity <<= kBits) {
+            ++h;
+        }
+        return h;
+    }
+
+    static void discard(Node* node, Transaction& tx) {
+        if (node->owner == tx.version) {
+            deallocate(node);
+        } else {
+            tx.epochs.retire(node, deallocate);
+        }
+    }
+
+    // Узел, который можно менять в текущей версии, с местом не меньше чем на capacity элементов
+    template <typename Item>
+    static void makeMutable(Node*& node, Transaction& tx, uint32_t capacity) {
+        if (node->owner == tx.version && node->capacity >= capacity) {
+            return;
+        }
+        Node* copy = allocate<Item>(tx.version, std::max(node->capacity, capacity));
+        copy->count = node->count;
+        std::memcpy(static_cast<void*>(items<Item>(copy)), items<Item>(node), node->count * sizeof(Item));
+        discard(node, tx);
+        node = copy;
+    }
+
+    template <typename T>
+    static const T& get(const Array& array, size_t index) {
+        const Node* node = array.root;
+        for (int level = height(array.size); level > 0; --level) {
+            node = items<Node*>(node)[(index >> (kBits * level)) & kMask];
+        }
+        return items<T>(node)[index & kMask];
+    }
+
+    template <typename T>
+    static void set(Array& array, size_t index, const T& value, Transaction& tx) {
+        Node** link = &array.root;
+        for (int level = height(array.size); level > 0; --level) {
+            makeMutable<Node*>(*link, tx, kFanout);
+            link = &items<Node*>(*link)[(index >> (kBits * level)) & kMask];
+        }
+        makeMutable<T>(*link, tx, (*link)->capacity);
+        items<T>(*link)[index & kMask] = value;
+    }
+
+    template <typename T>
+    static void pushBack(Array& array, const T& value, Transaction& tx) {
+        size_t index = array.size;
+        int h = height(index + 1);
+        if (array.root && h > height(index)) {
+            Node* root = allocate<Node*>(tx.version, kFanout);
+            items<Node*>(root)[0] = array.root;
+            root->count = 1;
+            array.root = root;
+        }
+        Node** link = &array.root;
+        for (int level = h; level > 0; --level) {
+            if (*link) {
+                makeMutable<Node*>(*link, tx, kFanout);
+            } else {
+                *link = allocate<Node*>(tx.version, kFanout);
+            }
+            size_t slot = (index >> (kBits * level)) & kMask;
+            if (slot == (*link)->count) {
+                items<Node*>(*link)[slot] = nullptr;
+                ++(*link)->count;
+            }
+            link = &items<Node*>(*link)[slot];
+        }
+        // Лист-корень растет удвоением, листья под внутренними узлами сразу полные
+        uint32_t slot = static_cast<uint32_t>(index & kMask);
+        if (!*link) {
+            *link = allocate<T>(tx.version, h == 0 ? 4 : kFanout);
+        } else if (slot >= (*link)->capacity) {
+            makeMutable<T>(*link, tx, std::min<uint32_t>(kFanout, (*link)->capacity * 2));
+        } else {
+            makeMutable<T>(*link, tx, (*link)->capacity);
+        }
+        items<T>(*link)[slot] = value;
+        (*link)->count = slot + 1;
+        ++array.size;
+    }
+
+    template <typename T>
+    static void popBack(Array& array, Transaction& tx) {
+        size_t index = array.size - 1;
+        int h = height(array.size);
+        Node** path[16];
+        Node** link = &array.root;
+        for (int level = h; level > 0; --level) {
+            makeMutable<Node*>(*link, tx, kFanout);
+            path[level] = link;
+            link = &items<Node*>(*link)[(index >> (kBits * level)) & kMask];
+        }
+        makeMutable<T>(*link, tx, (*link)->capacity);
+        path[0] = link;
+        --(*link)->count;
+        // Опустевшие узлы убираются снизу вверх
+        for (int level = 0; level <= h && (*path[level])->count == 0; ++level) {
+            discard(*path[level], tx);
+            *path[level] = nullptr;
+            if (level < h) {
+                --(*path[level + 1])->count;
+            }
+        }
+        --array.size;
+        if (array.size > 0 && height(array.size) < h) {
+            Node* root = array.root;
+            array.root = items<Node*>(root)[0];
+            discard(root, tx);
+        }
+    }
+
+    // Убирает все узлы массива из текущей версии
+    static void destroy(Array& array, Transaction& tx) {
+        if (array.root) {
+            destroyNode(array.root, height(array.size), tx);
+        }
+        array = Array();
+    }
+
+    static void destroyNode(Node* node, int level, Transaction& tx) {
+        if (level > 0) {
+            for (uint32_t i = 0; i < node->count; ++i) {
+                destroyNode(items<Node*>(node)[i], level - 1, tx);
+            }
+        }
+        discard(node, tx);
+    }
+
+    // Освобождение без учета читателей - только в деструкторе
+    static void freeNode(Node* node, int level) {
+        if (level > 0) {
+            for (uint32_t i = 0; i < node->count; ++i) {
+                freeNode(items<Node*>(node)[i], level - 1);
+            }
+        }
+        deallocate(node);
+    }
+
+    // Обход элементов массива по листьям: visit(const T* items, size_t count)
+    template <typename T, typename Visitor>
+    static void forEachChunk(const Array& array, Visitor&& visit) {
+        if (array.root) {
+            forEachChunk<T>(array.root, height(array.size), visit);
+        }
+    }
+
+    template <typename T, typename Visitor>
+    static void forEachChunk(const Node* node, int level, Visitor& visit) {
+        if (level == 0) {
+            visit(items<T>(node), node->count);
+            return;
+        }
+        for (uint32_t i = 0; i < node->count; ++i) {
+            forEachChunk<T>(items<Node*>(node)[i], level - 1, visit);
+        }
+    }
+
+    // Удаляет из списка одну дугу {vertex, weight}: на ее место встает последняя
+    static bool removeArc(Array& arcs, int vertex, TWeight weight, bool matchWeight, TWeight* removedWeight,
+                          Transaction& tx) {
+        size_t position = 0;
+        bool found = false;
+        forEachChunk<Arc>(arcs, [&](const Arc* chunk, size_t count) {
+            for (size_t i = 0; i < count && !found; ++i, ++position) {
+                if (chunk[i].vertex == vertex && (!matchWeight || chunk[i].weight == weight)) {
+                    found = true;
+                    if (removedWeight) *removedWeight = chunk[i].weight;
+                    return;
+                }
+            }
+        });
+        if (!found) return false;
+        if (position + 1 < arcs.size) {
+            Arc last = get<Arc>(arcs, arcs.size - 1);
+            set(arcs, position, last, tx);
+        }
+        popBack<Arc>(arcs, tx);
+        return true;
+    }
+
+    mutable EpochManager epochs_;
+    std::atomic<const Root*> published_;
+    std::atomic<IdTable*> ids_;
+
+    // Состояние писателя: неопубликованная версия pending_
+    Array vertices_;
+    int vertexCount_ = 0;
+    size_t edgeCount_ = 0;
+    uint64_t pending_ = 1;
+    bool dirty_ = false;
+
+    Transaction transaction() {
+        return Transaction{pending_, epochs_};
+    }
+
+    int findIndex(TIdentifier id) const {
+        return ids_.load(std::memory_order_acquire)->find(id);
+    }
+
+    // Индекс живой вершины id, при необходимости вершина создается или возвращается
+    int ensureVertex(TIdentifier id, Transaction& tx) {
+        int index = findIndex(id);
+        if (index >= 0) {
+            VertexEntry entry = get<VertexEntry>(vertices_, index);
+            if (!entry.alive) {
+                entry.alive = true;
+                set(vertices_, index, entry, tx);
+                ++vertexCount_;
+            }
+            return index;
+        }
+        IdTable* table = ids_.load(std::memory_order_relaxed);
+        if ((table->count + 1) * 2 > table->mask + 1) {
+            IdTable* grown = new IdTable((table->mask + 1) * 2);
+            for (size_t p = 0; p <= table->mask; ++p) {
+                int slotIndex = table->slots[p].index.load(std::memory_order_relaxed);
+                if (slotIndex >= 0) {
+                    grown->insert(table->slots[p].id, slotIndex);
+                }
+            }
+            ids_.store(grown);
+            epochs_.retire(table, deleteIdTable);
+            table = grown;
+        }
+        index = static_cast<int>(vertices_.size);
+        pushBack(vertices_, VertexEntry{id, Array(), Array(), true}, tx);
+        table->insert(id, index);
+        ++vertexCount_;
+        return index;
+    }
+
+public:
+    class Snapshot {
+    private:
+        EpochManager::Guard guard_;
+        const Root* root_ = nullptr;
+        const VersionedGraph* graph_ = nullptr;
+
+        const VertexEntry& entry(int vertex) const {
+            if (vertex < 0 || static_cast<size_t>(vertex) >= root_->vertices.size) {
+                throw std::out_of_range("Vertex index is out of range.");
+            }
+            return get<VertexEntry>(root_->vertices, vertex);
+        }
+
+    public:
+        Snapshot(EpochManager::Guard guard, const Root* root, const VersionedGraph* graph)
+            : guard_(std::move(guard)), root_(root), graph_(graph) {}
+
+        uint64_t getVersion() const { return root_->version; }
+        int getVertexCount() const { return root_->vertexCount; }
+        size_t getEdgeCount() const { return root_->edgeCount; }
+
+        // Индексы вершин лежат в [0, getIndexBound()), среди них могут быть удаленные
+        int getIndexBound() const { return static_cast<int>(root_->vertices.size); }
+        bool isAlive(int vertex) const { return entry(vertex).alive; }
+        TIdentifier getId(int vertex) const { return entry(vertex).id; }
+
+        // -1, если вершины нет в этой версии
+        int findIndex(TIdentifier id) const {
+            int index = graph_->findIndex(id);
+            if (index < 0 || index >= getIndexBound() || !get<VertexEntry>(root_->vertices, index).alive) {
+                return -1;
+            }
+            return index;
+        }
+
+        bool hasVertex(TIdentifier id) const { return findIndex(id) >= 0; }
+
+        int getIndex(TIdentifier id) const {
+            int index = findIndex(id);
+            if (index < 0) {
+                throw std::invalid_argument("Vertex does not exist in the graph.");
+            }
+            return index;
+        }
+
+        size_t getOutDegree(int vertex) const { return entry(vertex).out.size; }
+        size_t getInDegree(int vertex) const { return entry(vertex).in.size; }
+
+        // visit(int target, TWeight weight) для каждой исходящей дуги
+        template <typename Visitor>
+        void forEachOutArc(int vertex, Visitor visit) const {
+            forEachChunk<Arc>(entry(vertex).out, [&](const Arc* arcs, size_t count) {
+                for (size_t i = 0; i < count; ++i) visit(arcs[i].vertex, arcs[i].weight);
+            });
+        }
+
+        // visit(int source, TWeight weight) для каждой входящей дуги
+        template <typename Visitor>
+        void forEachInArc(int vertex, Visitor visit) const {
+            forEachChunk<Arc>(entry(vertex).in, [&](const Arc* arcs, size_t count) {
+                for (size_t i = 0; i < count; ++i) visit(arcs[i].vertex, arcs[i].weight);
+            });
+        }
+
+        bool hasEdge(TIdentifier from, TIdentifier to) const {
+            int fromIndex = findIndex(from);
+            int toIndex = findIndex(to);
+            if (fromIndex < 0 || toIndex < 0) return false;
+            bool found = false;
+            forEachOutArc(fromIndex, [&](int target, TWeight) { found = found || target == toIndex; });
+            return found;
+        }
+
+        // Плотная копия версии для алгоритмов над CompressedGraph; индексы - живые вершины по порядку
+        CompressedGraph<TWeight, TIdentifier> toCompressed() const {
+            std::vector<int> dense(getIndexBound(), -1);
+            std::vector<TIdentifier> ids;
+            ids.reserve(getVertexCount());
+            for (int v = 0; v < getIndexBound(); ++v) {
+                const VertexEntry& e = get<VertexEntry>(root_->vertices, v);
+                if (e.alive) {
+                    dense[v] = static_cast<int>(ids.size());
+                    ids.push_back(e.id);
+                }
+            }
+            std::vector<size_t> outOffsets(1, 0), inOffsets(1, 0);
+            std::vector<int> outTargets, inSources;
+            std::vector<TWeight> outWeights, inWeights;
+            outTargets.reserve(getEdgeCount());
+            outWeights.reserve(getEdgeCount());
+            inSources.reserve(getEdgeCount());
+            inWeights.reserve(getEdgeCount());
+            for (int v = 0; v < getIndexBound(); ++v) {
+                if (dense[v] < 0) continue;
+                forEachOutArc(v, [&](int target, TWeight weight) {
+                    outTargets.push_back(dense[target]);
+                    outWeights.push_back(weight);
+                });
+                forEachInArc(v, [&](int source, TWeight weight) {
+                    inSources.push_back(dense[source]);
+                    inWeights.push_back(weight);
+                });
+                outOffsets.push_back(outTargets.size());
+                inOffsets.push_back(inSources.size());
+            }
+            return CompressedGraph<TWeight, TIdentifier>(true, std::move(ids), std::move(outOffsets), std::move(outTargets),
+                                                         std::move(outWeights), std::move(inOffsets), std::move(inSources),
+                                                         std::move(inWeights));
+        }
+
+        // Копия версии для алгоритмов над IGraph (SCC, MST)
+        DirectedGraph<TWeight, TIdentifier> toGraph() const {
+            GraphBuilder<TWeight, TIdentifier> builder(getVertexCount());
+            builder.reserveEdges(getEdgeCount());
+            for (int v = 0; v < getIndexBound(); ++v) {
+                const VertexEntry& e = get<VertexEntry>(root_->vertices, v);
+                if (!e.alive) continue;
+                builder.addVertex(e.id);
+                forEachOutArc(v, [&](int target, TWeight weight) {
+                    builder.addEdge(e.id, get<VertexEntry>(root_->vertices, target).id, weight);
+                });
+            }
+            return builder.buildDirected();
+        }
+    };
+
+    VersionedGraph() : published_(new Root{0, Array(), 0, 0}), ids_(new IdTable(16)) {}
+
+    VersionedGraph(const VersionedGraph&) = delete;
+    VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+    // Узлы текущего состояния писателя освобождаются здесь, замененные - вместе с epochs_
+    ~VersionedGraph() {
+        for (size_t v = 0; v < vertices_.size; ++v) {
+            const VertexEntry& entry = get<VertexEntry>(vertices_, v);
+            if (entry.out.root) freeNode(entry.out.root, height(entry.out.size));
+            if (entry.in.root) freeNode(entry.in.root, height(entry.in.size));
+        }
+        if (vertices_.root) {
+            freeNode(vertices_.root, height(vertices_.size));
+        }
+        delete published_.load();
+        delete ids_.load();
+    }
+
+    // Закрепляет последнюю опубликованную версию
+    Snapshot snapshot() const {
+        EpochManager::Guard guard = epochs_.pin();
+        const Root* root = published_.load();
+        return Snapshot(std::move(guard), root, this);
+    }
+
+    uint64_t getVersion() const { return published_.load()->version; }
+
+    // Состояние писателя, включая неопубликованные изменения
+    int getVertexCount() const { return vertexCount_; }
+    size_t getEdgeCount() const { return edgeCount_; }
+
+    // Замененные узлы, которые еще могут читать снимки
+    size_t getRetiredCount() const { return epochs_.getRetiredCount(); }
+
+    bool addVertex(TIdentifier id) {
+        int index = findIndex(id);
+        if (index >= 0 && get<VertexEntry>(vertices_, index).alive) {
+            return false;
+        }
+        Transaction tx = transaction();
+        ensureVertex(id, tx);
+        dirty_ = true;
+        return true;
+    }
+
+    // Недостающие концы ребра создаются
+    void addEdge(TIdentifier from, TIdentifier to, TWeight weight) {
+        Transaction tx = transaction();
+        int fromIndex = ensureVertex(from, tx);
+        int toIndex = ensureVertex(to, tx);
+        VertexEntry entry = get<VertexEntry>(vertices_, fromIndex);
+        pushBack(entry.out, Arc{toIndex, weight}, tx);
+        set(vertices_, fromIndex, entry, tx);
+        entry = get<VertexEntry>(vertices_, toIndex);
+        pushBack(entry.in, Arc{fromIndex, weight}, tx);
+        set(vertices_, toIndex, entry, tx);
+        ++edgeCount_;
+        dirty_ = true;
+    }
+
+    // Удаляет одно ребро from -> to; поиск по списку смежности - O(степени)
+    bool removeEdge(TIdentifier from, TIdentifier to) {
+        int fromIndex = findIndex(from);
+        int toIndex = findIndex(to);
+        if (fromIndex < 0 || toIndex < 0) {
+            return false;
+        }
+        Transaction tx = transaction();
+        VertexEntry entry = get<VertexEntry>(vertices_, fromIndex);
+        TWeight weight{};
+        if (!removeArc(entry.out, toIndex, weight, false, &weight, tx)) {
+            return false;
+        }
+        set(vertices_, fromIndex, entry, tx);
+        entry = get<VertexEntry>(vertices_, toIndex);
+        removeArc(entry.in, fromIndex, weight, true, nullptr, tx);
+        set(vertices_, toIndex, entry, tx);
+        --edgeCount_;
+        dirty_ = true;
+        return true;
+    }
+
+    bool removeVertex(TIdentifier id) {
+        int index = findIndex(id);
+        if (index < 0 || !get<VertexEntry>(vertices_, index).alive) {
+            return false;
+        }
+        Transaction tx = transaction();
+        VertexEntry entry = get<VertexEntry>(vertices_, index);
+        std::vector<Arc> outgoing, incoming;
+        forEachChunk<Arc>(entry.out, [&](const Arc* arcs, size_t count) { outgoing.insert(outgoing.end(), arcs, arcs + count); });
+        forEachChunk<Arc>(entry.in, [&](const Arc* arcs, size_t count) { incoming.insert(incoming.end(), arcs, arcs + count); });
+        size_t loops = 0;
+        for (const Arc& arc : outgoing) {
+            if (arc.vertex == index) {
+                ++loops;
+                continue;
+            }
+            VertexEntry neighbor = get<VertexEntry>(vertices_, arc.vertex);
+            removeArc(neighbor.in, index, arc.weight, true, nullptr, tx);
+            set(vertices_, arc.vertex, neighbor, tx);
+        }
+        for (const Arc& arc : incoming) {
+            if (arc.vertex == index) continue;
+            VertexEntry neighbor = get<VertexEntry>(vertices_, arc.vertex);
+            removeArc(neighbor.out, index, arc.weight, true, nullptr, tx);
+            set(vertices_, arc.vertex, neighbor, tx);
+        }
+        edgeCount_ -= outgoing.size() + incoming.size() - loops;
+        destroy(entry.out, tx);
+        destroy(entry.in, tx);
+        entry.alive = false;
+        set(vertices_, index, entry, tx);
+        --vertexCount_;
+        dirty_ = true;
+        return true;
+    }
+
+    // Публикует накопленные изменения как новую версию и освобождает то, что уже никто не читает.
+    // Без изменений версия не меняется
+    uint64_t commit() {
+        if (dirty_) {
+            const Root* old = published_.exchange(new Root{pending_, vertices_, vertexCount_, edgeCount_});
+            epochs_.retire(const_cast<Root*>(old), deleteRoot);
+            ++pending_;
+            dirty_ = false;
+        }
+        epochs_.advance();
+        return pending_ - 1;
+    }
+};
+
+#endif // VERSIONEDGRAPH_H
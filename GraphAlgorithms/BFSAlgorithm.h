@@ -0,0 +1,235 @@
+#ifndef BFSALGORITHM_H
+#define BFSALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Результат обхода в ширину. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()).
+struct BFSResult {
+    std::vector<int> distances; // число ребер от источника, -1 если вершина недостижима
+    std::vector<int> parents;   // предок в дереве обхода, -1 у источника и недостижимых
+    int reachedCount = 0;
+    int topDownSteps = 0;
+    int bottomUpSteps = 0;
+};
+
+// Обход в ширину с переключением направления (Beamer, Asanović, Patterson).
+// Пока фронт мал, шаг идет сверху вниз: фронт просматривает исходящие дуги. Когда дуг у фронта
+// становится больше, чем непросмотренных дуг / alpha, шаг идет снизу вверх: каждая непосещенная
+// вершина ищет предка среди входящих дуг и останавливается на первом найденном. Фронт снизу вверх -
+// битовая карта. С пулом потоков оба шага выполняются параллельно; расстояния от этого не зависят,
+// дерево предков может быть другим допустимым деревом обхода.
+template <typename TWeight, typename TIdentifier>
+class BFSAlgorithm : public IAlgorithm<TWeight, BFSResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+private:
+    class Bitmap {
+    private:
+        std::vector<uint64_t> words_;
+
+    public:
+        explicit Bitmap(int size) : words_((size + 63) / 64, 0) {}
+
+        void reset() { std::fill(words_.begin(), words_.end(), 0); }
+        void set(int index) { words_[index >> 6] |= uint64_t(1) << (index & 63); }
+        bool test(int index) const { return (words_[index >> 6] >> (index & 63)) & 1; }
+        size_t getWordCount() const { return words_.size(); }
+        uint64_t getWord(size_t word) const { return words_[word]; }
+        uint64_t& wordAt(size_t word) { return words_[word]; }
+        void swap(Bitmap& other) { words_.swap(other.words_); }
+    };
+
+    // Граница, после которой параллельный шаг окупается
+    static constexpr size_t kParallelGrain = 1024;
+
+    ThreadPool* pool_ = nullptr;
+    int alpha_ = 15;
+    int beta_ = 18;
+
+    void forRange(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) const {
+        if (pool_) {
+            pool_->parallelFor(0, count, body, grain);
+        } else {
+            body(0, count);
+        }
+    }
+
+    // Шаг сверху вниз. Возвращает сумму исходящих степеней нового фронта
+    size_t topDownStep(const Snapshot& graph, const std::vector<int>& frontier, std::vector<int>& next,
+                       BFSResult& result, int level) const {
+        std::mutex mergeMutex;
+        size_t scoutCount = 0;
+        next.clear();
+        forRange(frontier.size(), kParallelGrain / 16, [&](size_t lo, size_t hi) {
+            std::vector<int> localNext;
+            size_t localScout = 0;
+            for (size_t i = lo; i < hi; ++i) {
+                int vertex = frontier[i];
+                for (int neighbor : graph.getOutNeighbors(vertex)) {
+                    int expected = -1;
+                    // Вершину захватывает ровно один поток
+                    std::atomic_ref<int> distance(result.distances[neighbor]);
+                    if (distance.load(std::memory_order_relaxed) == -1 &&
+                        distance.compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                        result.parents[neighbor] = vertex;
+                        localNext.push_back(neighbor);
+                        localScout += graph.getOutDegree(neighbor);
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            next.insert(next.end(), localNext.begin(), localNext.end());
+            scoutCount += localScout;
+        });
+        return scoutCount;
+    }
+
+    // Шаг снизу вверх. Каждый блок владеет целыми словами битовой карты, поэтому запись без атомиков.
+    // Возвращает число вершин нового фронта
+    size_t bottomUpStep(const Snapshot& graph, const Bitmap& frontier, Bitmap& next,
+                        BFSResult& result, int level) const {
+        int vertexCount = graph.getVertexCount();
+        std::atomic<size_t> awakeCount{0};
+        next.reset();
+        forRange(next.getWordCount(), kParallelGrain / 64, [&](size_t lo, size_t hi) {
+            size_t localAwake = 0;
+            for (size_t word = lo; word < hi; ++word) {
+                int end = std::min<int>(vertexCount, static_cast<int>((word + 1) * 64));
+                for (int vertex = static_cast<int>(word * 64); vertex < end; ++vertex) {
+                    if (result.distances[vertex] != -1) continue;
+                    for (int parent : graph.getInNeighbors(vertex)) {
+                        if (frontier.test(parent)) {
+                            result.distances[vertex] = level + 1;
+                            result.parents[vertex] = parent;
+                            next.wordAt(word) |= uint64_t(1) << (vertex & 63);
+                            ++localAwake;
+                            break;
+                        }
+                    }
+                }
+            }
+            awakeCount.fetch_add(localAwake, std::memory_order_relaxed);
+        });
+        return awakeCount.load();
+    }
+
+    static void queueToBitmap(const std::vector<int>& queue, Bitmap& bitmap) {
+        bitmap.reset();
+        for (int vertex : queue) {
+            bitmap.set(vertex);
+        }
+    }
+
+    static void bitmapToQueue(const Bitmap& bitmap, std::vector<int>& queue) {
+        queue.clear();
+        for (size_t word = 0; word < bitmap.getWordCount(); ++word) {
+            for (uint64_t bits = bitmap.getWord(word); bits; bits &= bits - 1) {
+                queue.push_back(static_cast<int>(word * 64 + __builtin_ctzll(bits)));
+            }
+        }
+    }
+
+public:
+    explicit BFSAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~BFSAlgorithm() override = default;
+
+    // nullptr - последовательный обход
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // alpha: переход вниз-вверх, когда дуг фронта больше непросмотренных / alpha;
+    // beta: возврат сверху вниз, когда фронт меньше V / beta
+    void setSwitchParameters(int alpha, int beta) {
+        if (alpha <= 0 || beta <= 0) {
+            throw std::invalid_argument("Switch parameters must be positive.");
+        }
+        alpha_ = alpha;
+        beta_ = beta;
+    }
+
+    BFSResult run(const Snapshot& graph, int source) const {
+        int vertexCount = graph.getVertexCount();
+        if (source < 0 || source >= vertexCount) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        BFSResult result;
+        result.distances.assign(vertexCount, -1);
+        result.parents.assign(vertexCount, -1);
+        result.distances[source] = 0;
+
+        std::vector<int> queue{source};
+        std::vector<int> nextQueue;
+        Bitmap front(vertexCount);
+        Bitmap current(vertexCount);
+        size_t edgesToCheck = graph.getArcCount();
+        size_t scoutCount = graph.getOutDegree(source);
+        int level = 0;
+        int reached = 1;
+
+        while (!queue.empty()) {
+            if (scoutCount > edgesToCheck / alpha_) {
+                queueToBitmap(queue, front);
+                size_t awakeCount = queue.size();
+                size_t previousAwake;
+                do {
+                    previousAwake = awakeCount;
+                    awakeCount = bottomUpStep(graph, front, current, result, level++);
+                    reached += static_cast<int>(awakeCount);
+                    ++result.bottomUpSteps;
+                    front.swap(current);
+                } while (awakeCount >= previousAwake || awakeCount > static_cast<size_t>(vertexCount / beta_));
+                bitmapToQueue(front, queue);
+                scoutCount = 1;
+            } else {
+                edgesToCheck -= std::min(edgesToCheck, scoutCount);
+                scoutCount = topDownStep(graph, queue, nextQueue, result, level++);
+                reached += static_cast<int>(nextQueue.size());
+                ++result.topDownSteps;
+                queue.swap(nextQueue);
+            }
+        }
+
+        result.reachedCount = reached;
+        return result;
+    }
+
+    SharedPtr<BFSResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (!startVertex) {
+            throw std::invalid_argument("Start vertex is not specified.");
+        }
+        if (!graph->hasVertex(startVertex)) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        // Снимок берет входящие дуги из Vertex - они нужны шагу снизу вверх
+        Snapshot snapshot = Snapshot::fromGraph(graph);
+        return MakeShared<BFSResult>(run(snapshot, snapshot.getIndex(startVertex->getId())));
+    }
+};
+
+#endif // BFSALGORITHM_H
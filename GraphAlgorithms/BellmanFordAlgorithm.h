@@ -0,0 +1,378 @@
+#ifndef BELLMANFORDALGORITHM_H
+#define BELLMANFORDALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "GraphPath.h"
+#include "IVertex.h"
+#include "MutableArraySequence.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Кратчайшие пути из одного источника при отрицательных весах. Индексы - плотные индексы снимка
+// CompressedGraph (для execute это порядок graph->getVertices()).
+template <typename TWeight, typename TIdentifier>
+struct BellmanFordResult {
+    static constexpr TWeight unreachable() { return std::numeric_limits<TWeight>::max(); }
+
+    std::vector<TWeight> distances; // unreachable() для недостижимых; при отрицательном цикле не окончательные
+    std::vector<int> parents;       // предок в дереве кратчайших путей, -1 у источника и недостижимых
+    bool hasNegativeCycle = false;
+    std::vector<int> cycle;         // отрицательный цикл v0, v1, ..., v0 по дугам графа
+    int rounds = 0;                 // выполненные раунды (Беллман-Форд) или извлечения из очереди (SPFA)
+    size_t relaxations = 0;         // успешные ослабления дуг
+
+    // Заполняются execute: путь до конечной вершины и отрицательный цикл в вершинах графа
+    GraphPath<TWeight, TIdentifier> path;
+    GraphPath<TWeight, TIdentifier> negativeCycle;
+};
+
+// Алгоритм Беллмана-Форда и его очередной вариант SPFA.
+// Раунды Беллмана-Форда ослабляют только дуги вершин, изменившихся в прошлом раунде, и останавливаются,
+// как только раунд ничего не изменил. С пулом потоков раунд идет вытягиванием: каждая вершина
+// пересчитывает себя по входящим дугам из значений прошлого раунда, поэтому пишет только свою ячейку.
+// SPFA держит очередь изменившихся вершин с эвристиками SLF (меньшая метка - в начало очереди)
+// и LLL (метка больше средней по очереди - в конец).
+// Отрицательный цикл, достижимый из источника, находится как цикл в графе предков.
+template <typename TWeight, typename TIdentifier>
+class BellmanFordAlgorithm : public IAlgorithm<TWeight, BellmanFordResult<TWeight, TIdentifier>, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+    using Result = BellmanFordResult<TWeight, TIdentifier>;
+
+    enum class Mode {
+        BellmanFord,
+        Spfa
+    };
+
+private:
+    ThreadPool* pool_ = nullptr;
+    Mode mode_ = Mode::BellmanFord;
+
+    // Обходит все циклы графа предков. Каждый цикл передается в visit как (v0, ..., v0) в направлении дуг;
+    // обход прекращается, когда visit возвращает true. Граф предков функциональный, поэтому отметки
+    // посещения по стартовой вершине дают каждый цикл ровно один раз за O(V)
+    template <typename Visitor>
+    static bool forEachParentCycle(const std::vector<int>& parents, Visitor visit) {
+        int n = static_cast<int>(parents.size());
+        std::vector<int> stamp(n, -1);
+        for (int start = 0; start < n; ++start) {
+            int v = start;
+            while (v != -1 && stamp[v] == -1) {
+                stamp[v] = start;
+                v = parents[v];
+            }
+            if (v == -1 || stamp[v] != start) continue;
+
+            // v лежит на новом цикле; предки идут против дуг, поэтому цикл собирается в обратном порядке
+            std::vector<int> cycle{v};
+            for (int u = parents[v]; u != v; u = parents[u]) {
+                cycle.push_back(u);
+            }
+            cycle.push_back(v);
+            if (visit(std::vector<int>(cycle.rbegin(), cycle.rend()))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runSequential(const Snapshot& graph, Result& result) const {
+        int n = graph.getVertexCount();
+        std::vector<char> active(n, 0);
+        std::vector<int> frontier;
+        std::vector<int> next;
+        for (int v = 0; v < n; ++v) {
+            if (result.parents[v] == -1 && result.distances[v] != Result::unreachable()) {
+                frontier.push_back(v);
+            }
+        }
+
+        while (!frontier.empty()) {
+            ++result.rounds;
+            next.clear();
+            for (int u : frontier) {
+                active[u] = 0;
+            }
+            for (int u : frontier) {
+                TWeight base = result.distances[u];
+                auto neighbors = graph.getOutNeighbors(u);
+                auto weights = graph.getOutWeights(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    int v = neighbors[i];
+                    TWeight candidate = base + weights[i];
+                    if (result.distances[v] == Result::unreachable() || candidate < result.distances[v]) {
+                        result.distances[v] = candidate;
+                        result.parents[v] = u;
+                        ++result.relaxations;
+                        if (!active[v]) {
+                            active[v] = 1;
+                            next.push_back(v);
+                        }
+                    }
+                }
+            }
+            frontier.swap(next);
+            if (result.rounds >= n && !frontier.empty() && checkCycle(graph, result)) {
+                return;
+            }
+        }
+    }
+
+    void runParallel(const Snapshot& graph, Result& result) const {
+        int n = graph.getVertexCount();
+        std::vector<TWeight> previous(result.distances);
+        std::vector<char> changed(n, 0);
+        std::vector<char> nextChanged(n, 0);
+        for (int v = 0; v < n; ++v) {
+            changed[v] = previous[v] != Result::unreachable() ? 1 : 0;
+        }
+
+        bool any = true;
+        while (any) {
+            ++result.rounds;
+            std::atomic<bool> anyChanged{false};
+            std::atomic<size_t> relaxations{0};
+            pool_->parallelFor(0, n, [&](size_t lo, size_t hi) {
+                bool localChanged = false;
+                size_t localRelaxations = 0;
+                for (size_t v = lo; v < hi; ++v) {
+                    TWeight best = previous[v];
+                    int parent = result.parents[v];
+                    auto sources = graph.getInNeighbors(static_cast<int>(v));
+                    auto weights = graph.getInWeights(static_cast<int>(v));
+                    for (size_t i = 0; i < sources.size(); ++i) {
+                        int u = sources[i];
+                        if (!changed[u]) continue;
+                        TWeight candidate = previous[u] + weights[i];
+                        if (best == Result::unreachable() || candidate < best) {
+                            best = candidate;
+                            parent = u;
+                        }
+                    }
+                    nextChanged[v] = best != previous[v] ? 1 : 0;
+                    if (nextChanged[v]) {
+                        result.distances[v] = best;
+                        result.parents[v] = parent;
+                        localChanged = true;
+                        ++localRelaxations;
+                    }
+                }
+                if (localChanged) anyChanged.store(true, std::memory_order_relaxed);
+                relaxations.fetch_add(localRelaxations, std::memory_order_relaxed);
+            }, 1024);
+            result.relaxations += relaxations.load();
+            any = anyChanged.load();
+            previous = result.distances;
+            changed.swap(nextChanged);
+            if (any && result.rounds >= n && checkCycle(graph, result)) {
+                return;
+            }
+        }
+    }
+
+    void runSpfa(const Snapshot& graph, Result& result) const {
+        int n = graph.getVertexCount();
+        std::deque<int> queue;
+        std::vector<char> queued(n, 0);
+        std::vector<int> edgeCount(n, 0); // число дуг в пути до вершины на момент ее последнего ослабления
+        double labelSum = 0;              // сумма меток вершин в очереди для LLL
+        for (int v = 0; v < n; ++v) {
+            if (result.distances[v] != Result::unreachable()) {
+                queue.push_back(v);
+                queued[v] = 1;
+                labelSum += static_cast<double>(result.distances[v]);
+            }
+        }
+        int nextCheck = n;
+
+        while (!queue.empty()) {
+            // LLL: вершины с меткой больше средней уходят в конец очереди. Из-за округления суммы
+            // все метки могут оказаться чуть больше среднего, поэтому очередь обходится не больше одного раза
+            double average = labelSum / queue.size();
+            for (size_t turns = queue.size(); turns > 1 && static_cast<double>(result.distances[queue.front()]) > average;
+                 --turns) {
+                queue.push_back(queue.front());
+                queue.pop_front();
+            }
+            int u = queue.front();
+            queue.pop_front();
+            queued[u] = 0;
+            labelSum -= static_cast<double>(result.distances[u]);
+            ++result.rounds;
+
+            TWeight base = result.distances[u];
+            auto neighbors = graph.getOutNeighbors(u);
+            auto weights = graph.getOutWeights(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                int v = neighbors[i];
+                TWeight candidate = base + weights[i];
+                if (result.distances[v] != Result::unreachable() && !(candidate < result.distances[v])) continue;
+
+                if (queued[v]) {
+                    labelSum -= static_cast<double>(result.distances[v]);
+                }
+                result.distances[v] = candidate;
+                result.parents[v] = u;
+                edgeCount[v] = edgeCount[u] + 1;
+                ++result.relaxations;
+                if (queued[v]) {
+                    labelSum += static_cast<double>(candidate);
+                } else {
+                    // SLF: метка меньше, чем у головы очереди, - в начало
+                    queued[v] = 1;
+                    labelSum += static_cast<double>(candidate);
+                    if (!queue.empty() && candidate < result.distances[queue.front()]) {
+                        queue.push_front(v);
+                    } else {
+                        queue.push_back(v);
+                    }
+                }
+
+                // Путь из n дуг повторяет вершину - проверяем граф предков
+                if (edgeCount[v] >= nextCheck) {
+                    if (checkCycle(graph, result)) return;
+                    nextCheck += n;
+                }
+            }
+        }
+    }
+
+    // Пока граф предков ацикличен, каждое расстояние не меньше веса простого пути из источника,
+    // поэтому при достижимом отрицательном цикле ослабления рано или поздно замыкают цикл предков
+    static bool checkCycle(const Snapshot& graph, Result& result) {
+        std::vector<int> cycle = findNegativeParentCycle(graph, result.parents);
+        if (cycle.empty()) {
+            return false;
+        }
+        result.cycle = std::move(cycle);
+        result.hasNegativeCycle = true;
+        return true;
+    }
+
+    static GraphPath<TWeight, TIdentifier> toGraphPath(const IGraph<TWeight, TIdentifier>* graph, const Snapshot& snapshot,
+                                                       const std::vector<int>& indices) {
+        MutableArraySequence<IVertex<TWeight, TIdentifier>*> vertices;
+        for (int index : indices) {
+            vertices.append(graph->getVertexById(snapshot.getId(index)));
+        }
+        return GraphPath<TWeight, TIdentifier>(vertices);
+    }
+
+public:
+    explicit BellmanFordAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~BellmanFordAlgorithm() override = default;
+
+    void setMode(Mode mode) {
+        mode_ = mode;
+    }
+
+    // Пул используется раундами Беллмана-Форда; SPFA последовательный по своей природе
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // Первый цикл графа предков с отрицательным весом (v0, ..., v0 в направлении дуг) или пустой вектор.
+    // Вес цикла считается по самым легким дугам. Цикл предков нулевого веса возможен и не должен
+    // заслонять отрицательный цикл в другом месте, поэтому проверяются все циклы
+    static std::vector<int> findNegativeParentCycle(const Snapshot& graph, const std::vector<int>& parents) {
+        std::vector<int> negative;
+        forEachParentCycle(parents, [&](std::vector<int> cycle) {
+            TWeight weight{};
+            for (size_t i = 0; i + 1 < cycle.size(); ++i) {
+                auto neighbors = graph.getOutNeighbors(cycle[i]);
+                auto weights = graph.getOutWeights(cycle[i]);
+                bool found = false;
+                TWeight lightest{};
+                for (size_t j = 0; j < neighbors.size(); ++j) {
+                    if (neighbors[j] == cycle[i + 1] && (!found || weights[j] < lightest)) {
+                        lightest = weights[j];
+                        found = true;
+                    }
+                }
+                weight += lightest;
+            }
+            if (!(weight < TWeight{})) {
+                return false;
+            }
+            negative = std::move(cycle);
+            return true;
+        });
+        return negative;
+    }
+
+    // source = -1: виртуальный источник с дугами веса 0 во все вершины (потенциалы Джонсона,
+    // поиск любого отрицательного цикла)
+    Result run(const Snapshot& graph, int source) const {
+        int n = graph.getVertexCount();
+        if (source < -1 || source >= n) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        Result result;
+        result.distances.assign(n, source == -1 ? TWeight{} : Result::unreachable());
+        result.parents.assign(n, -1);
+        if (source != -1) {
+            result.distances[source] = TWeight{};
+        }
+        if (n == 0) {
+            return result;
+        }
+
+        if (mode_ == Mode::Spfa) {
+            runSpfa(graph, result);
+        } else if (pool_) {
+            runParallel(graph, result);
+        } else {
+            runSequential(graph, result);
+        }
+        return result;
+    }
+
+    // Путь от источника до target по дереву предков (пустой, если недостижима или есть отрицательный цикл)
+    static std::vector<int> extractPath(const Result& result, int target) {
+        std::vector<int> path;
+        if (result.hasNegativeCycle || result.distances[target] == Result::unreachable()) {
+            return path;
+        }
+        for (int v = target; v != -1; v = result.parents[v]) {
+            path.push_back(v);
+        }
+        return std::vector<int>(path.rbegin(), path.rend());
+    }
+
+    SharedPtr<Result> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (!startVertex) {
+            throw std::invalid_argument("Start vertex is not specified.");
+        }
+        if (!graph->hasVertex(startVertex)) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        Snapshot snapshot = Snapshot::fromGraph(graph);
+        auto result = MakeShared<Result>(run(snapshot, snapshot.getIndex(startVertex->getId())));
+        if (result->hasNegativeCycle) {
+            result->negativeCycle = toGraphPath(graph, snapshot, result->cycle);
+        } else if (endVertex && graph->hasVertex(endVertex)) {
+            result->path = toGraphPath(graph, snapshot, extractPath(*result, snapshot.getIndex(endVertex->getId())));
+        }
+        return result;
+    }
+};
+
+#endif // BELLMANFORDALGORITHM_H
@@ -0,0 +1,272 @@
+#ifndef BETWEENNESSCENTRALITYALGORITHM_H
+#define BETWEENNESSCENTRALITYALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Центральность по посредничеству. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()).
+struct BetweennessResult {
+    // Сумма по парам s != t долей кратчайших путей s -> t через вершину; для неориентированного
+    // графа каждая пара считается один раз. В приближенном режиме - несмещенная оценка
+    std::vector<double> centrality;
+    int sourceCount = 0;    // число обработанных источников
+    bool exact = true;
+    // Приближенный режим: с вероятностью не меньше 1 - failureProbability ошибка оценки
+    // не превышает errorBound сразу для всех вершин (неравенство Хёфдинга и оценка объединения)
+    double errorBound = 0;
+    double failureProbability = 0;
+};
+
+// Алгоритм Брандеса: из каждого источника строится ДАГ кратчайших путей (обходом в ширину, если
+// у всех ребер одинаковый вес, иначе алгоритмом Дейкстры), затем зависимости накапливаются
+// в обратном порядке обхода. Предшественники не хранятся - они находятся по входящим дугам снимка.
+// С пулом потоков источники делятся между блоками, каждый блок копит зависимости в своем массиве,
+// массивы складываются в конце.
+// Приближенный режим (setSampleCount) обрабатывает k источников, выбранных равномерно с возвращением,
+// и масштабирует сумму на V / k.
+template <typename TWeight, typename TIdentifier>
+class BetweennessCentralityAlgorithm : public IAlgorithm<TWeight, BetweennessResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+private:
+    // Состояние вершины относительно текущего источника. Поля лежат рядом, чтобы обращение
+    // к случайной вершине стоило одного промаха кэша, а не одного на каждый массив
+    struct VertexState {
+        TWeight distance{};
+        double paths = 0;      // число кратчайших путей из источника
+        double dependency = 0;
+        bool reached = false;  // во взвешенном обходе - расстояние окончательное
+    };
+
+    // Рабочие массивы одного потока; после источника сбрасываются только посещенные вершины
+    struct Workspace {
+        std::vector<VertexState> state;
+        std::vector<int> order; // вершины в порядке неубывания расстояния
+
+        explicit Workspace(int n) : state(n) {
+            order.reserve(n);
+        }
+    };
+
+    ThreadPool* pool_ = nullptr;
+    int sampleCount_ = 0;
+    uint64_t seed_ = 1;
+    double failureProbability_ = 0.05;
+
+    static void searchUnweighted(const Snapshot& graph, int source, Workspace& work) {
+        work.state[source].reached = true;
+        work.state[source].paths = 1;
+        work.order.push_back(source);
+        for (size_t head = 0; head < work.order.size(); ++head) {
+            int v = work.order[head];
+            const VertexState& from = work.state[v];
+            TWeight next = from.distance + TWeight(1);
+            for (int w : graph.getOutNeighbors(v)) {
+                VertexState& to = work.state[w];
+                if (!to.reached) {
+                    to.reached = true;
+                    to.distance = next;
+                    work.order.push_back(w);
+                }
+                if (to.distance == next) {
+                    to.paths += from.paths;
+                }
+            }
+        }
+    }
+
+    static void searchWeighted(const Snapshot& graph, int source, Workspace& work) {
+        using Entry = std::pair<TWeight, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        work.state[source].paths = 1;
+        queue.push({TWeight{}, source});
+
+        // В очереди могут быть устаревшие записи; вершина фиксируется при первом извлечении
+        // с актуальным расстоянием, к этому моменту число путей до нее уже окончательное.
+        // paths == 0 означает, что вершина еще не найдена
+        while (!queue.empty()) {
+            auto [distance, v] = queue.top();
+            queue.pop();
+            VertexState& from = work.state[v];
+            if (from.reached || distance != from.distance) continue;
+            from.reached = true;
+            work.order.push_back(v);
+
+            auto neighbors = graph.getOutNeighbors(v);
+            auto weights = graph.getOutWeights(v);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                VertexState& to = work.state[neighbors[i]];
+                if (to.reached) continue;
+                TWeight candidate = distance + weights[i];
+                if (to.paths == 0 || candidate < to.distance) {
+                    to.distance = candidate;
+                    to.paths = from.paths;
+                    queue.push({candidate, neighbors[i]});
+                } else if (candidate == to.distance) {
+                    to.paths += from.paths;
+                }
+            }
+        }
+    }
+
+    // Зависимости источника добавляются в accumulator; рабочие массивы возвращаются в исходное состояние
+    static void accumulate(const Snapshot& graph, bool weighted, int source, Workspace& work,
+                           std::vector<double>& accumulator) {
+        for (size_t i = work.order.size(); i-- > 0;) {
+            int w = work.order[i];
+            const VertexState& to = work.state[w];
+            double share = (1.0 + to.dependency) / to.paths;
+            auto predecessors = graph.getInNeighbors(w);
+            auto weights = graph.getInWeights(w);
+            for (size_t j = 0; j < predecessors.size(); ++j) {
+                int v = predecessors[j];
+                VertexState& from = work.state[v];
+                TWeight step = weighted ? weights[j] : TWeight(1);
+                if (from.reached && v != w && from.distance + step == to.distance) {
+                    from.dependency += from.paths * share;
+                }
+            }
+            if (w != source) {
+                accumulator[w] += to.dependency;
+            }
+        }
+        for (int v : work.order) {
+            work.state[v] = VertexState{};
+        }
+        work.order.clear();
+    }
+
+    // Веса должны быть положительными; одинаковые положительные веса не влияют на кратчайшие пути,
+    // и тогда хватает обхода в ширину
+    static bool needsWeights(const Snapshot& graph) {
+        const auto& weights = graph.getOutWeights();
+        bool uniform = true;
+        for (const TWeight& weight : weights) {
+            if (!(weight > TWeight{})) {
+                throw std::invalid_argument("Betweenness centrality requires positive edge weights.");
+            }
+            uniform = uniform && weight == weights.front();
+        }
+        return !uniform;
+    }
+
+public:
+    explicit BetweennessCentralityAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~BetweennessCentralityAlgorithm() override = default;
+
+    // nullptr - последовательный расчет
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // 0 - точный расчет по всем источникам, k > 0 - оценка по k случайным источникам
+    void setSampleCount(int sampleCount) {
+        if (sampleCount < 0) {
+            throw std::invalid_argument("Sample count must be non-negative.");
+        }
+        sampleCount_ = sampleCount;
+    }
+
+    void setSeed(uint64_t seed) {
+        seed_ = seed;
+    }
+
+    // Допустимая вероятность того, что ошибка оценки превысит errorBound
+    void setFailureProbability(double probability) {
+        if (!(probability > 0 && probability < 1)) {
+            throw std::invalid_argument("Failure probability must be in (0, 1).");
+        }
+        failureProbability_ = probability;
+    }
+
+    BetweennessResult run(const Snapshot& graph) const {
+        int n = graph.getVertexCount();
+        bool weighted = needsWeights(graph);
+
+        std::vector<int> sources;
+        if (sampleCount_ == 0) {
+            sources.resize(n);
+            for (int v = 0; v < n; ++v) {
+                sources[v] = v;
+            }
+        } else if (n > 0) {
+            std::mt19937_64 generator(seed_);
+            std::uniform_int_distribution<int> vertexDist(0, n - 1);
+            sources.resize(sampleCount_);
+            for (int& source : sources) {
+                source = vertexDist(generator);
+            }
+        }
+
+        BetweennessResult result;
+        result.centrality.assign(n, 0.0);
+        result.sourceCount = static_cast<int>(sources.size());
+        result.exact = sampleCount_ == 0;
+
+        std::mutex mergeMutex;
+        auto processSources = [&](size_t lo, size_t hi) {
+            Workspace work(n);
+            std::vector<double> accumulator(n, 0.0);
+            for (size_t i = lo; i < hi; ++i) {
+                if (weighted) {
+                    searchWeighted(graph, sources[i], work);
+                } else {
+                    searchUnweighted(graph, sources[i], work);
+                }
+                accumulate(graph, weighted, sources[i], work, accumulator);
+            }
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            for (int v = 0; v < n; ++v) {
+                result.centrality[v] += accumulator[v];
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, sources.size(), processSources);
+        } else {
+            processSources(0, sources.size());
+        }
+
+        // Для неориентированного графа путь s -> t и t -> s - одна пара
+        double scale = graph.isDirected() ? 1.0 : 0.5;
+        if (!result.exact && !sources.empty()) {
+            scale *= static_cast<double>(n) / sources.size();
+            // Вклад источника в вершину лежит в [0, V - 2]; Хёфдинг для среднего k таких величин
+            double epsilon = std::sqrt(std::log(2.0 * n / failureProbability_) / (2.0 * sources.size()));
+            result.errorBound = (graph.isDirected() ? 1.0 : 0.5) * epsilon * n * std::max(0, n - 2);
+            result.failureProbability = failureProbability_;
+        }
+        for (double& value : result.centrality) {
+            value *= scale;
+        }
+        return result;
+    }
+
+    SharedPtr<BetweennessResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        return MakeShared<BetweennessResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // BETWEENNESSCENTRALITYALGORITHM_H
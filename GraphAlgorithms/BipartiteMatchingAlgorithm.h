@@ -0,0 +1,260 @@
+#ifndef BIPARTITEMATCHINGALGORITHM_H
+#define BIPARTITEMATCHINGALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Паросочетание максимальной мощности в двудольном графе. Индексы - плотные индексы снимка
+// CompressedGraph (для execute это порядок graph->getVertices()).
+struct BipartiteMatchingResult {
+    bool bipartite = true;
+    // Если граф не двудольный - нечетный цикл v0, v1, ..., v0 по ребрам графа, паросочетание не строится
+    std::vector<int> oddCycle;
+    std::vector<int> side;      // доля вершины: 0 или 1 (в каждой компоненте первая вершина - в доле 0)
+    std::vector<int> mate;      // пара вершины, -1 у свободных
+    int matchingSize = 0;
+    int greedyMatches = 0;      // ребер в начальном жадном паросочетании
+    int phases = 0;             // фаз Хопкрофта-Карпа (поиск в ширину + поиск в глубину)
+};
+
+// Алгоритм Хопкрофта-Карпа для неориентированного графа. Доли находятся раскраской обходом в ширину;
+// если раскраска невозможна, возвращается нечетный цикл. Каждая фаза строит слои обходом в ширину
+// от свободных вершин доли 0 до ближайших свободных вершин доли 1, затем поиском в глубину по слоям
+// находит вершинно-непересекающиеся кратчайшие увеличивающие пути; всего O(E * sqrt(V)).
+// Поиск в глубину итеративный, с текущим ребром у каждой вершины, поэтому глубина пути не ограничена стеком.
+// Начальное жадное паросочетание (по умолчанию включено) обычно покрывает большую часть ответа
+// и сокращает число фаз.
+template <typename TWeight, typename TIdentifier>
+class BipartiteMatchingAlgorithm : public IAlgorithm<TWeight, BipartiteMatchingResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+private:
+    static constexpr int kUnreached = std::numeric_limits<int>::max();
+
+    bool greedyInitialization_ = true;
+
+    // Раскраска в две доли; при конфликте заполняет oddCycle и возвращает false
+    static bool colorSides(const Snapshot& graph, BipartiteMatchingResult& result) {
+        int n = graph.getVertexCount();
+        result.side.assign(n, -1);
+        std::vector<int> parent(n, -1);
+        std::vector<int> depth(n, 0);
+        std::vector<int> queue;
+        queue.reserve(n);
+
+        for (int root = 0; root < n; ++root) {
+            if (result.side[root] != -1) continue;
+            result.side[root] = 0;
+            queue.assign(1, root);
+            for (size_t head = 0; head < queue.size(); ++head) {
+                int u = queue[head];
+                for (int w : graph.getOutNeighbors(u)) {
+                    if (result.side[w] == -1) {
+                        result.side[w] = 1 - result.side[u];
+                        parent[w] = u;
+                        depth[w] = depth[u] + 1;
+                        queue.push_back(w);
+                    } else if (result.side[w] == result.side[u]) {
+                        result.oddCycle = buildOddCycle(parent, depth, u, w);
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Вершины u и w одной доли соединены ребром: цикл идет от их общего предка в дереве обхода к u,
+    // по ребру u - w и обратно по дереву к предку. Глубины u и w одной четности, поэтому цикл нечетный
+    static std::vector<int> buildOddCycle(const std::vector<int>& parent, const std::vector<int>& depth, int u, int w) {
+        std::vector<int> fromU{u};
+        std::vector<int> fromW{w};
+        int a = u;
+        int b = w;
+        while (depth[a] > depth[b]) {
+            a = parent[a];
+            fromU.push_back(a);
+        }
+        while (depth[b] > depth[a]) {
+            b = parent[b];
+            fromW.push_back(b);
+        }
+        while (a != b) {
+            a = parent[a];
+            b = parent[b];
+            fromU.push_back(a);
+            fromW.push_back(b);
+        }
+        // fromU: u ... lca, fromW: w ... lca
+        std::vector<int> cycle(fromU.rbegin(), fromU.rend());
+        cycle.insert(cycle.end(), fromW.begin(), fromW.end());
+        return cycle;
+    }
+
+    // Жадное паросочетание в духе Карпа-Сипсера: вершины доли 0 в порядке возрастания степени, каждой -
+    // свободный сосед наименьшей степени. Вершины с малой степенью так реже остаются без пары
+    static int matchGreedily(const Snapshot& graph, const std::vector<int>& left, std::vector<int>& mate) {
+        std::vector<int> order(left);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int a, int b) { return graph.getOutDegree(a) < graph.getOutDegree(b); });
+        int matched = 0;
+        for (int u : order) {
+            int best = -1;
+            for (int v : graph.getOutNeighbors(u)) {
+                if (mate[v] == -1 && (best == -1 || graph.getOutDegree(v) < graph.getOutDegree(best))) {
+                    best = v;
+                }
+            }
+            if (best != -1) {
+                mate[u] = best;
+                mate[best] = u;
+                ++matched;
+            }
+        }
+        return matched;
+    }
+
+    // Слои от свободных вершин доли 0; возвращает слой, на котором впервые достижима свободная вершина доли 1
+    static int buildLayers(const Snapshot& graph, const std::vector<int>& left, const std::vector<int>& mate,
+                           std::vector<int>& layer, std::vector<int>& queue) {
+        queue.clear();
+        for (int u : left) {
+            if (mate[u] == -1) {
+                layer[u] = 0;
+                queue.push_back(u);
+            } else {
+                layer[u] = kUnreached;
+            }
+        }
+        int limit = kUnreached;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            if (layer[u] >= limit) break;
+            for (int v : graph.getOutNeighbors(u)) {
+                int w = mate[v];
+                if (w == -1) {
+                    limit = std::min(limit, layer[u]);
+                } else if (layer[w] == kUnreached) {
+                    layer[w] = layer[u] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        return limit;
+    }
+
+    // Увеличивающий путь из свободной вершины root по слоям; при успехе паросочетание обновляется
+    static bool augment(const Snapshot& graph, int root, int limit, std::vector<int>& mate, std::vector<int>& layer,
+                        std::vector<size_t>& current, std::vector<int>& stack) {
+        stack.assign(1, root);
+        while (!stack.empty()) {
+            int u = stack.back();
+            auto neighbors = graph.getOutNeighbors(u);
+            bool descended = false;
+            for (; current[u] < neighbors.size(); ++current[u]) {
+                int w = mate[neighbors[current[u]]];
+                if (w == -1 && layer[u] == limit) {
+                    // Свободная вершина на последнем слое: перекладываем ребра пути, current указывают на них
+                    for (int x : stack) {
+                        int v = graph.getOutNeighbors(x)[current[x]];
+                        mate[x] = v;
+                        mate[v] = x;
+                    }
+                    for (int x : stack) {
+                        layer[x] = kUnreached; // вершина уже на найденном пути
+                    }
+                    return true;
+                }
+                if (w != -1 && layer[u] < limit && layer[w] == layer[u] + 1) {
+                    stack.push_back(w);
+                    descended = true;
+                    break;
+                }
+            }
+            if (descended) continue;
+
+            // Тупик: вершина исключается из слоев до конца фазы
+            layer[u] = kUnreached;
+            stack.pop_back();
+            if (!stack.empty()) {
+                ++current[stack.back()];
+            }
+        }
+        return false;
+    }
+
+public:
+    BipartiteMatchingAlgorithm() = default;
+    ~BipartiteMatchingAlgorithm() override = default;
+
+    void setGreedyInitialization(bool enabled) {
+        greedyInitialization_ = enabled;
+    }
+
+    BipartiteMatchingResult run(const Snapshot& graph) const {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("Bipartite matching requires an undirected graph.");
+        }
+        BipartiteMatchingResult result;
+        if (!colorSides(graph, result)) {
+            result.bipartite = false;
+            return result;
+        }
+
+        int n = graph.getVertexCount();
+        result.mate.assign(n, -1);
+        std::vector<int> left;
+        for (int v = 0; v < n; ++v) {
+            if (result.side[v] == 0) left.push_back(v);
+        }
+        if (greedyInitialization_) {
+            result.greedyMatches = matchGreedily(graph, left, result.mate);
+        }
+        result.matchingSize = result.greedyMatches;
+
+        std::vector<int> layer(n, kUnreached);
+        std::vector<size_t> current(n, 0);
+        std::vector<int> queue;
+        std::vector<int> stack;
+        while (true) {
+            int limit = buildLayers(graph, left, result.mate, layer, queue);
+            if (limit == kUnreached) break;
+            ++result.phases;
+            for (int u : left) {
+                current[u] = 0;
+            }
+            for (int u : left) {
+                if (result.mate[u] == -1 && layer[u] == 0 &&
+                    augment(graph, u, limit, result.mate, layer, current, stack)) {
+                    ++result.matchingSize;
+                }
+            }
+        }
+        return result;
+    }
+
+    SharedPtr<BipartiteMatchingResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (graph->isDirected()) {
+            throw std::invalid_argument("Bipartite matching requires an undirected graph.");
+        }
+        return MakeShared<BipartiteMatchingResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // BIPARTITEMATCHINGALGORITHM_H
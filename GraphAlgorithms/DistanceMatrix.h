@@ -0,0 +1,140 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Плотная матрица расстояний между всеми парами вершин, построчно в одном массиве.
+// Длина строки (stride) может быть больше числа вершин: алгоритмы выравнивают ее на размер блока.
+// Недостижимые пары хранят infinity(); для целых весов это половина максимума, чтобы сумма
+// двух бесконечностей не переполнялась.
+template <typename TWeight>
+class DistanceMatrix {
+private:
+    static constexpr char kMagic[4] = {'A', 'P', 'S', 'P'};
+    static constexpr uint32_t kVersion = 1;
+
+    int vertexCount_ = 0;
+    size_t stride_ = 0;
+    std::vector<TWeight> data_;
+
+    // Код типа элемента в файле: 1 - целое со знаком, 2 - беззнаковое, 3 - с плавающей точкой
+    static constexpr uint32_t typeCode() {
+        if constexpr (std::is_floating_point_v<TWeight>) {
+            return 3;
+        } else if constexpr (std::is_signed_v<TWeight>) {
+            return 1;
+        } else {
+            return 2;
+        }
+    }
+
+public:
+    static_assert(std::is_arithmetic_v<TWeight>, "DistanceMatrix requires an arithmetic weight type.");
+
+    static constexpr TWeight infinity() {
+        if constexpr (std::numeric_limits<TWeight>::has_infinity) {
+            return std::numeric_limits<TWeight>::infinity();
+        } else {
+            return std::numeric_limits<TWeight>::max() / 2;
+        }
+    }
+
+    DistanceMatrix() = default;
+
+    // Матрица без ребер: 0 на диагонали, infinity() вне ее, включая выравнивание строк
+    explicit DistanceMatrix(int vertexCount, size_t stride = 0)
+        : vertexCount_(vertexCount), stride_(stride ? stride : static_cast<size_t>(vertexCount)) {
+        if (vertexCount < 0 || stride_ < static_cast<size_t>(vertexCount)) {
+            throw std::invalid_argument("Invalid distance matrix dimensions.");
+        }
+        data_.assign(stride_ * stride_, infinity());
+        for (int i = 0; i < vertexCount_; ++i) {
+            data_[i * stride_ + i] = TWeight{};
+        }
+    }
+
+    int getVertexCount() const { return vertexCount_; }
+    size_t getStride() const { return stride_; }
+
+    TWeight get(int from, int to) const {
+        if (from < 0 || from >= vertexCount_ || to < 0 || to >= vertexCount_) {
+            throw std::out_of_range("Vertex index is out of range.");
+        }
+        return data_[from * stride_ + to];
+    }
+
+    bool isReachable(int from, int to) const {
+        return get(from, to) < infinity();
+    }
+
+    // Строка матрицы длиной stride; для вычислительных ядер
+    TWeight* row(size_t index) { return data_.data() + index * stride_; }
+    const TWeight* row(size_t index) const { return data_.data() + index * stride_; }
+
+    std::span<const TWeight> getRow(int from) const {
+        if (from < 0 || from >= vertexCount_) {
+            throw std::out_of_range("Vertex index is out of range.");
+        }
+        return {row(from), static_cast<size_t>(vertexCount_)};
+    }
+
+    // Двоичный файл: сигнатура "APSP", версия, код типа и размер элемента, число вершин,
+    // затем V * V элементов построчно без выравнивания. Порядок байтов - порядок байтов машины.
+    void writeBinary(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        uint32_t header[3] = {kVersion, typeCode(), static_cast<uint32_t>(sizeof(TWeight))};
+        uint64_t vertexCount = static_cast<uint64_t>(vertexCount_);
+        out.write(kMagic, sizeof(kMagic));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
+        for (int i = 0; i < vertexCount_; ++i) {
+            out.write(reinterpret_cast<const char*>(row(i)), sizeof(TWeight) * vertexCount_);
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write distance matrix: " + path);
+        }
+    }
+
+    static DistanceMatrix readBinary(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        char magic[4];
+        uint32_t header[3];
+        uint64_t vertexCount = 0;
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&vertexCount), sizeof(vertexCount));
+        if (!in || std::memcmp(magic, kMagic, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a distance matrix file: " + path);
+        }
+        if (header[0] != kVersion || header[1] != typeCode() || header[2] != sizeof(TWeight) ||
+            vertexCount > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            throw std::runtime_error("Unsupported distance matrix format: " + path);
+        }
+
+        DistanceMatrix matrix(static_cast<int>(vertexCount));
+        for (int i = 0; i < matrix.vertexCount_; ++i) {
+            in.read(reinterpret_cast<char*>(matrix.row(i)), sizeof(TWeight) * matrix.vertexCount_);
+        }
+        if (!in) {
+            throw std::runtime_error("Distance matrix file is truncated: " + path);
+        }
+        return matrix;
+    }
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,189 @@
+#ifndef FLOYDWARSHALLALGORITHM_H
+#define FLOYDWARSHALLALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "DistanceMatrix.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Кратчайшие расстояния между всеми парами вершин блочным алгоритмом Флойда-Уоршелла.
+// Матрица разбита на квадратные блоки kTile x kTile. На шаге kb сначала пересчитывается диагональный
+// блок (kb, kb), затем блоки его строки и столбца, затем все остальные - они зависят только
+// от уже готовых блоков строки и столбца, поэтому шаги 2 и 3 выполняются параллельно по блокам.
+// Внутренний цикл min(c[j], a + b[j]) для int, float и double при сборке с AVX2 векторизован явно,
+// иначе остается скалярным. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()). Отрицательные веса допустимы, отрицательный цикл -
+// исключение; модули расстояний должны быть меньше DistanceMatrix::infinity() / 2.
+template <typename TWeight, typename TIdentifier>
+class FloydWarshallAlgorithm : public IAlgorithm<TWeight, DistanceMatrix<TWeight>, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+    using Matrix = DistanceMatrix<TWeight>;
+
+private:
+    static constexpr size_t kTile = 64;
+
+    ThreadPool* pool_ = nullptr;
+
+    // c[j] = min(c[j], a + b[j]) для j из [0, kTile); c и b не пересекаются, поэтому
+    // скалярный цикл компилятор тоже может векторизовать
+    static void relaxRow(TWeight* __restrict c, const TWeight* __restrict b, TWeight a) {
+#ifdef __AVX2__
+        if constexpr (std::is_same_v<TWeight, int>) {
+            __m256i broadcast = _mm256_set1_epi32(a);
+            for (size_t j = 0; j < kTile; j += 8) {
+                __m256i through = _mm256_add_epi32(broadcast, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+                __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epi32(current, through));
+            }
+            return;
+        } else if constexpr (std::is_same_v<TWeight, float>) {
+            __m256 broadcast = _mm256_set1_ps(a);
+            for (size_t j = 0; j < kTile; j += 8) {
+                __m256 through = _mm256_add_ps(broadcast, _mm256_loadu_ps(b + j));
+                _mm256_storeu_ps(c + j, _mm256_min_ps(_mm256_loadu_ps(c + j), through));
+            }
+            return;
+        } else if constexpr (std::is_same_v<TWeight, double>) {
+            __m256d broadcast = _mm256_set1_pd(a);
+            for (size_t j = 0; j < kTile; j += 4) {
+                __m256d through = _mm256_add_pd(broadcast, _mm256_loadu_pd(b + j));
+                _mm256_storeu_pd(c + j, _mm256_min_pd(_mm256_loadu_pd(c + j), through));
+            }
+            return;
+        }
+#endif
+        for (size_t j = 0; j < kTile; ++j) {
+            TWeight through = a + b[j];
+            c[j] = through < c[j] ? through : c[j];
+        }
+    }
+
+    // Блок c через промежуточные вершины блока kb: c[i][j] = min(c[i][j], a[i][k] + b[k][j]).
+    // Цикл по k внешний, поэтому c может совпадать с a или b (шаги 1 и 2)
+    static void relaxTile(Matrix& matrix, size_t ci, size_t cj, size_t kb) {
+        for (size_t k = kb * kTile; k < (kb + 1) * kTile; ++k) {
+            const TWeight* b = matrix.row(k) + cj * kTile;
+            for (size_t i = ci * kTile; i < (ci + 1) * kTile; ++i) {
+                // Строка k через саму себя не меняется (на диагонали 0), и только она совпала бы с b
+                if (i == k) continue;
+                TWeight* rowI = matrix.row(i);
+                TWeight a = rowI[k];
+                if (a > Matrix::infinity() / 2) continue; // пути через k нет
+                relaxRow(rowI + cj * kTile, b, a);
+            }
+        }
+    }
+
+    static void checkNegativeCycle(const Matrix& matrix) {
+        for (int i = 0; i < matrix.getVertexCount(); ++i) {
+            if (matrix.row(i)[i] < TWeight{}) {
+                throw std::runtime_error("Graph contains a negative cycle.");
+            }
+        }
+    }
+
+    void forTiles(size_t count, const std::function<void(size_t)>& body) const {
+        auto runTiles = [&](size_t lo, size_t hi) {
+            for (size_t tile = lo; tile < hi; ++tile) {
+                body(tile);
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, count, runTiles);
+        } else {
+            runTiles(0, count);
+        }
+    }
+
+public:
+    explicit FloydWarshallAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~FloydWarshallAlgorithm() override = default;
+
+    // nullptr - последовательный расчет
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    Matrix run(const Snapshot& graph) const {
+        int n = graph.getVertexCount();
+        size_t tiles = (static_cast<size_t>(n) + kTile - 1) / kTile;
+        Matrix matrix(n, tiles * kTile);
+
+        // Из кратных ребер берется самое легкое; петля учитывается, только если она отрицательная
+        for (int u = 0; u < n; ++u) {
+            auto neighbors = graph.getOutNeighbors(u);
+            auto weights = graph.getOutWeights(u);
+            TWeight* row = matrix.row(u);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                row[neighbors[i]] = std::min(row[neighbors[i]], weights[i]);
+            }
+        }
+
+        for (size_t kb = 0; kb < tiles; ++kb) {
+            relaxTile(matrix, kb, kb, kb);
+
+            // Блоки строки kb и столбца kb: сначала строка (i = kb), затем столбец (j = kb)
+            forTiles(2 * (tiles - 1), [&](size_t index) {
+                size_t other = index % (tiles - 1);
+                other += other >= kb ? 1 : 0;
+                if (index < tiles - 1) {
+                    relaxTile(matrix, kb, other, kb);
+                } else {
+                    relaxTile(matrix, other, kb, kb);
+                }
+            });
+
+            forTiles((tiles - 1) * (tiles - 1), [&](size_t index) {
+                size_t ci = index / (tiles - 1);
+                size_t cj = index % (tiles - 1);
+                ci += ci >= kb ? 1 : 0;
+                cj += cj >= kb ? 1 : 0;
+                relaxTile(matrix, ci, cj, kb);
+            });
+
+            // Отрицательный цикл проверяется на каждом шаге: дальше расстояния убывают без предела
+            checkNegativeCycle(matrix);
+        }
+
+        // Бесконечность плюс отрицательный путь дает значение чуть меньше бесконечности - возвращаем его обратно
+        if constexpr (!std::numeric_limits<TWeight>::has_infinity) {
+            for (int i = 0; i < n; ++i) {
+                TWeight* row = matrix.row(i);
+                for (int j = 0; j < n; ++j) {
+                    if (row[j] > Matrix::infinity() / 2) {
+                        row[j] = Matrix::infinity();
+                    }
+                }
+            }
+        }
+        return matrix;
+    }
+
+    SharedPtr<Matrix> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        return MakeShared<Matrix>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // FLOYDWARSHALLALGORITHM_H
@@ -0,0 +1,380 @@
+#ifndef GRAPHCOLORINGALGORITHM_H
+#define GRAPHCOLORINGALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "KCoreAlgorithm.h"
+#include "SharedPtr.h"
+#include "SortedAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Правильная раскраска вершин. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()).
+struct ColoringResult {
+    std::vector<int> colors; // цвет вершины от 0 до colorCount - 1
+    int colorCount = 0;
+    int rounds = 0;          // раунды параллельных вариантов (у последовательных - 1)
+    long long conflicts = 0; // перекрашивания после конфликтов в спекулятивном варианте
+};
+
+// Жадная раскраска неориентированного графа (петли и кратные ребра не учитываются): каждая вершина
+// получает наименьший цвет, не занятый уже раскрашенными соседями. Стратегии отличаются порядком:
+// - LargestFirst - по убыванию степени;
+// - SmallestLast - обратный вырожденный порядок, не больше degeneracy + 1 цветов;
+// - Dsatur - следующей берется вершина с наибольшим числом различных цветов у соседей (затем по степени);
+// - Speculative - все вершины раскрашиваются параллельно без синхронизации, затем параллельно
+//   ищутся конфликты (соседи одного цвета), из каждой пары большая по индексу вершина перекрашивается
+//   в следующем раунде;
+// - JonesPlassmann - вершины с приоритетом (степень, затем случайное число); в раунде раскрашиваются
+//   вершины, старше всех нераскрашенных соседей. Такие вершины попарно не смежны, поэтому раунд
+//   не требует синхронизации и результат не зависит от числа потоков. У каждой вершины хранится
+//   счетчик нераскрашенных старших соседей, так что раунд просматривает только соседей фронта.
+// Параллельные стратегии используют пул потоков, если он задан.
+template <typename TWeight, typename TIdentifier>
+class GraphColoringAlgorithm : public IAlgorithm<TWeight, ColoringResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+    using Adjacency = SortedAdjacency<TWeight, TIdentifier>;
+
+    enum class Strategy {
+        LargestFirst,
+        SmallestLast,
+        Dsatur,
+        Speculative,
+        JonesPlassmann
+    };
+
+private:
+    ThreadPool* pool_ = nullptr;
+    Strategy strategy_ = Strategy::SmallestLast;
+    uint64_t seed_ = 1;
+
+    void forRange(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) const {
+        if (pool_) {
+            pool_->parallelFor(0, count, body, grain);
+        } else {
+            body(0, count);
+        }
+    }
+
+    // Цвет вершины не больше ее степени, поэтому рабочему массиву занятых цветов хватает maxDegree + 2
+    static size_t forbiddenSize(const Adjacency& graph) {
+        size_t maxDegree = 0;
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            maxDegree = std::max(maxDegree, graph.getDegree(v));
+        }
+        return maxDegree + 2;
+    }
+
+    // Наименьший цвет, не занятый раскрашенными соседями; forbidden[c] == stamp - цвет занят
+    static int smallestFreeColor(const Adjacency& graph, std::vector<int>& colors, int v,
+                                 std::vector<int>& forbidden, int stamp) {
+        for (int u : graph.getNeighbors(v)) {
+            int color = std::atomic_ref<int>(colors[u]).load(std::memory_order_relaxed);
+            if (color >= 0) {
+                forbidden[color] = stamp;
+            }
+        }
+        int color = 0;
+        while (forbidden[color] == stamp) {
+            ++color;
+        }
+        return color;
+    }
+
+    static void colorInOrder(const Adjacency& graph, const std::vector<int>& order, std::vector<int>& colors) {
+        std::vector<int> forbidden(forbiddenSize(graph), -1);
+        for (int v : order) {
+            colors[v] = smallestFreeColor(graph, colors, v, forbidden, v);
+        }
+    }
+
+    static std::vector<int> largestFirstOrder(const Adjacency& graph) {
+        int n = graph.getVertexCount();
+        std::vector<int> order(n);
+        for (int v = 0; v < n; ++v) {
+            order[v] = v;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](int a, int b) { return graph.getDegree(a) > graph.getDegree(b); });
+        return order;
+    }
+
+    // Индексная 4-арная куча вершин по ключу (насыщенность, степень, меньший индекс): одна запись
+    // на вершину, рост насыщенности - подъем по куче
+    static void colorDsatur(const Adjacency& graph, std::vector<int>& colors) {
+        int n = graph.getVertexCount();
+        // Различные цвета среди соседей; насыщенность обычно мала, поэтому линейный поиск по списку
+        std::vector<std::vector<int>> neighborColors(n);
+        auto above = [&](int a, int b) {
+            size_t saturationA = neighborColors[a].size();
+            size_t saturationB = neighborColors[b].size();
+            if (saturationA != saturationB) return saturationA > saturationB;
+            if (graph.getDegree(a) != graph.getDegree(b)) return graph.getDegree(a) > graph.getDegree(b);
+            return a < b;
+        };
+
+        std::vector<int> heap(n);
+        std::vector<int> position(n);
+        auto place = [&](size_t index, int v) {
+            heap[index] = v;
+            position[v] = static_cast<int>(index);
+        };
+        auto siftUp = [&](size_t index) {
+            int v = heap[index];
+            while (index > 0 && above(v, heap[(index - 1) / 4])) {
+                place(index, heap[(index - 1) / 4]);
+                index = (index - 1) / 4;
+            }
+            place(index, v);
+        };
+        auto siftDown = [&](size_t index) {
+            int v = heap[index];
+            while (4 * index + 1 < heap.size()) {
+                size_t best = 4 * index + 1;
+                for (size_t child = best + 1; child < std::min(4 * index + 5, heap.size()); ++child) {
+                    if (above(heap[child], heap[best])) best = child;
+                }
+                if (!above(heap[best], v)) break;
+                place(index, heap[best]);
+                index = best;
+            }
+            place(index, v);
+        };
+        for (int v = 0; v < n; ++v) {
+            place(v, v);
+        }
+        for (size_t index = heap.size(); index-- > 0;) {
+            siftDown(index);
+        }
+
+        std::vector<int> forbidden(forbiddenSize(graph), -1);
+        while (!heap.empty()) {
+            int v = heap.front();
+            int last = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) {
+                place(0, last);
+                siftDown(0);
+            }
+
+            int color = smallestFreeColor(graph, colors, v, forbidden, v);
+            colors[v] = color;
+            for (int u : graph.getNeighbors(v)) {
+                if (colors[u] >= 0) continue;
+                auto& seen = neighborColors[u];
+                if (std::find(seen.begin(), seen.end(), color) == seen.end()) {
+                    seen.push_back(color);
+                    siftUp(position[u]);
+                }
+            }
+        }
+    }
+
+    void colorSpeculative(const Adjacency& graph, ColoringResult& result) const {
+        int n = graph.getVertexCount();
+        std::vector<int>& colors = result.colors;
+        std::vector<int> pending(n);
+        for (int v = 0; v < n; ++v) {
+            pending[v] = v;
+        }
+        std::vector<int> next;
+        std::mutex mergeMutex;
+        size_t paletteSize = forbiddenSize(graph);
+
+        while (!pending.empty()) {
+            ++result.rounds;
+            // Соседи могут раскрашиваться одновременно - цвета читаются и пишутся атомарно, без порядка
+            forRange(pending.size(), 256, [&](size_t lo, size_t hi) {
+                std::vector<int> forbidden(paletteSize, -1);
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = pending[i];
+                    std::atomic_ref<int>(colors[v]).store(-1, std::memory_order_relaxed);
+                }
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = pending[i];
+                    int color = smallestFreeColor(graph, colors, v, forbidden, v);
+                    std::atomic_ref<int>(colors[v]).store(color, std::memory_order_relaxed);
+                }
+            });
+
+            next.clear();
+            forRange(pending.size(), 1024, [&](size_t lo, size_t hi) {
+                std::vector<int> local;
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = pending[i];
+                    for (int u : graph.getNeighbors(v)) {
+                        if (u < v && colors[u] == colors[v]) {
+                            local.push_back(v);
+                            break;
+                        }
+                    }
+                }
+                if (local.empty()) return;
+                std::lock_guard<std::mutex> lock(mergeMutex);
+                next.insert(next.end(), local.begin(), local.end());
+            });
+            result.conflicts += static_cast<long long>(next.size());
+            pending.swap(next);
+            // Порядок перекрашивания не должен зависеть от того, как потоки сливали списки
+            std::sort(pending.begin(), pending.end());
+        }
+    }
+
+    static uint64_t mix(uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    void colorJonesPlassmann(const Adjacency& graph, ColoringResult& result) const {
+        int n = graph.getVertexCount();
+        std::vector<int>& colors = result.colors;
+        std::vector<uint64_t> priority(n);
+        for (int v = 0; v < n; ++v) {
+            priority[v] = mix(seed_ ^ static_cast<uint64_t>(v));
+        }
+        // Старше - вершина большей степени, затем с большим случайным приоритетом, затем с большим индексом
+        auto precedes = [&](int a, int b) {
+            size_t degreeA = graph.getDegree(a);
+            size_t degreeB = graph.getDegree(b);
+            if (degreeA != degreeB) return degreeA > degreeB;
+            if (priority[a] != priority[b]) return priority[a] > priority[b];
+            return a > b;
+        };
+
+        // waiting[v] - число еще не раскрашенных старших соседей; вершина с нулем входит во фронт
+        std::vector<int> waiting(n, 0);
+        std::vector<int> frontier;
+        std::vector<int> next;
+        std::mutex mergeMutex;
+        auto append = [&](std::vector<int>& target, std::vector<int>& local) {
+            if (local.empty()) return;
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            target.insert(target.end(), local.begin(), local.end());
+        };
+        forRange(n, 1024, [&](size_t lo, size_t hi) {
+            std::vector<int> local;
+            for (size_t v = lo; v < hi; ++v) {
+                for (int u : graph.getNeighbors(static_cast<int>(v))) {
+                    waiting[v] += precedes(u, static_cast<int>(v)) ? 1 : 0;
+                }
+                if (waiting[v] == 0) {
+                    local.push_back(static_cast<int>(v));
+                }
+            }
+            append(frontier, local);
+        });
+
+        size_t paletteSize = forbiddenSize(graph);
+        while (!frontier.empty()) {
+            ++result.rounds;
+            // Вершины фронта попарно не смежны, а все их старшие соседи уже раскрашены
+            forRange(frontier.size(), 256, [&](size_t lo, size_t hi) {
+                std::vector<int> forbidden(paletteSize, -1);
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = frontier[i];
+                    colors[v] = smallestFreeColor(graph, colors, v, forbidden, v);
+                }
+            });
+            next.clear();
+            forRange(frontier.size(), 256, [&](size_t lo, size_t hi) {
+                std::vector<int> local;
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = frontier[i];
+                    for (int u : graph.getNeighbors(v)) {
+                        if (precedes(v, u) &&
+                            std::atomic_ref<int>(waiting[u]).fetch_sub(1, std::memory_order_relaxed) == 1) {
+                            local.push_back(u);
+                        }
+                    }
+                }
+                append(next, local);
+            });
+            frontier.swap(next);
+        }
+    }
+
+public:
+    explicit GraphColoringAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~GraphColoringAlgorithm() override = default;
+
+    void setStrategy(Strategy strategy) {
+        strategy_ = strategy;
+    }
+
+    // Пул используется стратегиями Speculative и JonesPlassmann и построением списков соседей
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // Зерно случайных приоритетов Jones-Plassmann
+    void setSeed(uint64_t seed) {
+        seed_ = seed;
+    }
+
+    ColoringResult run(const Snapshot& graph) const {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("Graph coloring requires an undirected graph.");
+        }
+        Adjacency adjacency(graph, pool_);
+        int n = adjacency.getVertexCount();
+
+        ColoringResult result;
+        result.colors.assign(n, -1);
+        switch (strategy_) {
+            case Strategy::LargestFirst:
+                colorInOrder(adjacency, largestFirstOrder(adjacency), result.colors);
+                result.rounds = 1;
+                break;
+            case Strategy::SmallestLast: {
+                std::vector<int> order = KCoreAlgorithm<TWeight, TIdentifier>::degeneracyOrder(adjacency);
+                std::reverse(order.begin(), order.end());
+                colorInOrder(adjacency, order, result.colors);
+                result.rounds = 1;
+                break;
+            }
+            case Strategy::Dsatur:
+                colorDsatur(adjacency, result.colors);
+                result.rounds = 1;
+                break;
+            case Strategy::Speculative:
+                colorSpeculative(adjacency, result);
+                break;
+            case Strategy::JonesPlassmann:
+                colorJonesPlassmann(adjacency, result);
+                break;
+        }
+        for (int color : result.colors) {
+            result.colorCount = std::max(result.colorCount, color + 1);
+        }
+        return result;
+    }
+
+    SharedPtr<ColoringResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (graph->isDirected()) {
+            throw std::invalid_argument("Graph coloring requires an undirected graph.");
+        }
+        return MakeShared<ColoringResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // GRAPHCOLORINGALGORITHM_H
@@ -0,0 +1,278 @@
+#ifndef INCREMENTALTOPOLOGICALORDER_H
+#define INCREMENTALTOPOLOGICALORDER_H
+
+#include "DirectedGraph.h"
+#include "GraphPath.h"
+#include "HashTableDictionary.h"
+#include "MutableArraySequence.h"
+#include "IVertex.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Исключение, которое бросается при попытке добавить ребро, замыкающее цикл.
+// Цикл хранится как путь from -> to -> ... -> from.
+template <typename TWeight, typename TIdentifier>
+class CycleDetectedException : public std::runtime_error {
+private:
+    GraphPath<TWeight, TIdentifier> cycle_;
+
+public:
+    explicit CycleDetectedException(const GraphPath<TWeight, TIdentifier>& cycle)
+        : std::runtime_error("Edge would create a cycle in the directed acyclic graph."), cycle_(cycle) {}
+
+    const GraphPath<TWeight, TIdentifier>& getCycle() const {
+        return cycle_;
+    }
+};
+
+// Онлайн-поддержка топологического порядка (алгоритм Пирса–Келли).
+// При вставке ребра x -> y, нарушающего текущий порядок, переупорядочивается только
+// область между позициями y и x. Все изменения графа должны идти через этот класс,
+// иначе порядок перестает соответствовать графу.
+template <typename TWeight, typename TIdentifier>
+class IncrementalTopologicalOrder {
+public:
+    using VertexPtr = IVertex<TWeight, TIdentifier>*;
+    using VertexSequence = MutableArraySequence<VertexPtr>;
+
+private:
+    DirectedGraph<TWeight, TIdentifier>* graph_;
+    VertexSequence order_;                            // позиция -> вершина
+    HashTableDictionary<TIdentifier, int> positions_; // вершина -> позиция
+
+    void buildInitialOrder() {
+        auto vertices = graph_->getVertices();
+        HashTableDictionary<TIdentifier, int> inDegree;
+        for (int i = 0; i < vertices.getLength(); ++i) {
+            inDegree.add(vertices.get(i)->getId(), vertices.get(i)->getIncomingEdges().getLength());
+        }
+
+        // Алгоритм Кана: вершины с нулевой полустепенью захода идут первыми
+        VertexSequence ready;
+        for (int i = 0; i < vertices.getLength(); ++i) {
+            if (inDegree.get(vertices.get(i)->getId()) == 0) {
+                ready.append(vertices.get(i));
+            }
+        }
+
+        for (int head = 0; head < ready.getLength(); ++head) {
+            VertexPtr vertex = ready.get(head);
+            positions_.add(vertex->getId(), order_.getLength());
+            order_.append(vertex);
+
+            auto edges = vertex->getOutgoingEdges();
+            for (int i = 0; i < edges.getLength(); ++i) {
+                TIdentifier neighborId = edges.get(i)->getTo()->getId();
+                int& degree = inDegree.get(neighborId);
+                if (--degree == 0) {
+                    ready.append(edges.get(i)->getTo());
+                }
+            }
+        }
+
+        if (order_.getLength() != vertices.getLength()) {
+            throw std::runtime_error("Topological sort is not defined for cyclic graphs.");
+        }
+    }
+
+    // Прямой обход из y по вершинам с позицией <= upperBound.
+    // Возвращает true, если достигнута вершина x (ребро x -> y замкнет цикл).
+    bool collectForward(VertexPtr y, VertexPtr x, int upperBound, std::vector<VertexPtr>& region,
+                        HashTableDictionary<TIdentifier, VertexPtr>& parents) const {
+        VertexSequence stack;
+        stack.append(y);
+        parents.add(y->getId(), nullptr);
+
+        while (stack.getLength() > 0) {
+            VertexPtr vertex = stack.get(stack.getLength() - 1);
+            stack.removeAt(stack.getLength() - 1);
+            region.push_back(vertex);
+
+            auto edges = vertex->getOutgoingEdges();
+            for (int i = 0; i < edges.getLength(); ++i) {
+                VertexPtr neighbor = edges.get(i)->getTo();
+                if (parents.containsKey(neighbor->getId())) {
+                    continue;
+                }
+                int position = positions_.get(neighbor->getId());
+                if (position > upperBound) {
+                    continue;
+                }
+                parents.add(neighbor->getId(), vertex);
+                if (neighbor->getId() == x->getId()) {
+                    return true;
+                }
+                stack.append(neighbor);
+            }
+        }
+        return false;
+    }
+
+    // Обратный обход из x по входящим ребрам, по вершинам с позицией > lowerBound
+    void collectBackward(VertexPtr x, int lowerBound, std::vector<VertexPtr>& region) const {
+        HashTableDictionary<TIdentifier, bool> visited;
+        VertexSequence stack;
+        stack.append(x);
+        visited.add(x->getId(), true);
+
+        while (stack.getLength() > 0) {
+            VertexPtr vertex = stack.get(stack.getLength() - 1);
+            stack.removeAt(stack.getLength() - 1);
+            region.push_back(vertex);
+
+            auto edges = vertex->getIncomingEdges();
+            for (int i = 0; i < edges.getLength(); ++i) {
+                VertexPtr neighbor = edges.get(i)->getFrom();
+                if (visited.containsKey(neighbor->getId())) {
+                    continue;
+                }
+                if (positions_.get(neighbor->getId()) <= lowerBound) {
+                    continue;
+                }
+                visited.add(neighbor->getId(), true);
+                stack.append(neighbor);
+            }
+        }
+    }
+
+    GraphPath<TWeight, TIdentifier> buildCycle(VertexPtr from, VertexPtr to,
+                                              const HashTableDictionary<TIdentifier, VertexPtr>& parents) const {
+        VertexSequence cycle;
+        VertexPtr current = from;
+        while (current != nullptr) {
+            cycle.prepend(current);
+            if (current->getId() == to->getId()) {
+                break;
+            }
+            current = parents.get(current->getId());
+        }
+        cycle.prepend(from);
+        return GraphPath<TWeight, TIdentifier>(cycle);
+    }
+
+    // Переназначает освободившиеся позиции: сначала deltaB, затем deltaF, каждая в прежнем относительном порядке
+    void reorder(std::vector<VertexPtr>& backward, std::vector<VertexPtr>& forward) {
+        auto byPosition = [this](VertexPtr a, VertexPtr b) {
+            return positions_.get(a->getId()) < positions_.get(b->getId());
+        };
+        std::sort(backward.begin(), backward.end(), byPosition);
+        std::sort(forward.begin(), forward.end(), byPosition);
+
+        std::vector<int> freePositions;
+        freePositions.reserve(backward.size() + forward.size());
+        for (VertexPtr vertex : backward) {
+            freePositions.push_back(positions_.get(vertex->getId()));
+        }
+        for (VertexPtr vertex : forward) {
+            freePositions.push_back(positions_.get(vertex->getId()));
+        }
+        std::sort(freePositions.begin(), freePositions.end());
+
+        size_t next = 0;
+        for (VertexPtr vertex : backward) {
+            positions_.add(vertex->getId(), freePositions[next]);
+            order_.set(freePositions[next++], vertex);
+        }
+        for (VertexPtr vertex : forward) {
+            positions_.add(vertex->getId(), freePositions[next]);
+            order_.set(freePositions[next++], vertex);
+        }
+    }
+
+public:
+    explicit IncrementalTopologicalOrder(DirectedGraph<TWeight, TIdentifier>* graph) : graph_(graph) {
+        if (!graph_) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        buildInitialOrder();
+    }
+
+    void addVertex(VertexPtr vertex) {
+        if (!vertex) return;
+
+        graph_->addVertex(vertex);
+        if (!positions_.containsKey(vertex->getId())) {
+            positions_.add(vertex->getId(), order_.getLength());
+            order_.append(vertex);
+        }
+    }
+
+    // Добавляет ребро, сохраняя топологический порядок. Если ребро замыкает цикл,
+    // граф не изменяется и бросается CycleDetectedException с найденным циклом.
+    void addEdge(VertexPtr fromVertex, VertexPtr toVertex, TWeight weight) {
+        if (!fromVertex || !toVertex) return;
+
+        if (fromVertex->getId() == toVertex->getId()) {
+            VertexSequence loop;
+            loop.append(fromVertex);
+            loop.append(toVertex);
+            throw CycleDetectedException<TWeight, TIdentifier>(GraphPath<TWeight, TIdentifier>(loop));
+        }
+
+        // Цикл ищется до вставки вершин. Новая вершина еще без ребер и замкнуть цикл не может,
+        // так что искать нужно, только если оба конца уже есть в порядке.
+        std::vector<VertexPtr> forward;
+        bool searched = false;
+        if (positions_.containsKey(fromVertex->getId()) && positions_.containsKey(toVertex->getId())) {
+            int upperBound = positions_.get(fromVertex->getId());
+            if (positions_.get(toVertex->getId()) < upperBound) {
+                HashTableDictionary<TIdentifier, VertexPtr> parents;
+                if (collectForward(toVertex, fromVertex, upperBound, forward, parents)) {
+                    throw CycleDetectedException<TWeight, TIdentifier>(buildCycle(fromVertex, toVertex, parents));
+                }
+                searched = true;
+            }
+        }
+
+        addVertex(fromVertex);
+        addVertex(toVertex);
+
+        int lowerBound = positions_.get(toVertex->getId());
+        int upperBound = positions_.get(fromVertex->getId());
+        if (lowerBound < upperBound) {
+            if (!searched) {
+                HashTableDictionary<TIdentifier, VertexPtr> parents;
+                collectForward(toVertex, fromVertex, upperBound, forward, parents);
+            }
+
+            std::vector<VertexPtr> backward;
+            collectBackward(fromVertex, lowerBound, backward);
+            reorder(backward, forward);
+        }
+
+        graph_->addEdge(fromVertex, toVertex, weight);
+    }
+
+    void removeEdge(VertexPtr fromVertex, VertexPtr toVertex) {
+        // Удаление ребра не может нарушить топологический порядок
+        graph_->removeEdge(fromVertex, toVertex);
+    }
+
+    void removeVertex(VertexPtr vertex) {
+        if (!vertex || !positions_.containsKey(vertex->getId())) return;
+
+        graph_->removeVertex(vertex);
+        int position = positions_.get(vertex->getId());
+        positions_.remove(vertex->getId());
+        order_.removeAt(position);
+        for (int i = position; i < order_.getLength(); ++i) {
+            positions_.add(order_.get(i)->getId(), i);
+        }
+    }
+
+    // Текущий топологический порядок, O(1)
+    const VertexSequence& getOrder() const {
+        return order_;
+    }
+
+    int getPosition(VertexPtr vertex) const {
+        if (!vertex || !positions_.containsKey(vertex->getId())) {
+            throw std::invalid_argument("Vertex does not exist in the graph.");
+        }
+        return positions_.get(vertex->getId());
+    }
+};
+
+#endif // INCREMENTALTOPOLOGICALORDER_H
@@ -0,0 +1,182 @@
+#ifndef JOHNSONREWEIGHTING_H
+#define JOHNSONREWEIGHTING_H
+
+#include "BellmanFordAlgorithm.h"
+#include "CompressedGraph.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Перевзвешивание Джонсона: один запуск Беллмана-Форда из виртуального источника дает потенциалы h,
+// после чего веса w(u, v) + h(u) - h(v) неотрицательны, а кратчайшие пути остаются прежними.
+// Дальше любое число запросов из одного источника решается алгоритмом Дейкстры на перевзвешенном
+// снимке, расстояния восстанавливаются как d'(s, v) - h(s) + h(v). Отрицательный цикл - исключение
+// при построении.
+//
+// Дейкстра здесь своя, по массивам снимка: DijkstraAlgorithm принимает только IGraph (снимок к нему
+// не приводится), хранит расстояния в хеш-таблицах, а его PriorityQueue ищет элемент линейно при
+// каждой вставке. На графе из 200 000 вершин и 2 000 000 дуг запрос через DijkstraAlgorithm
+// (после сборки DirectedGraph) идет около 20 с против 0.1 с здесь, и выигрыш от перевзвешивания
+// теряется. Для DijkstraAlgorithm снимок можно собрать в DirectedGraph через GraphBuilder.
+template <typename TWeight, typename TIdentifier>
+class JohnsonReweighting {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+    static constexpr TWeight unreachable() { return std::numeric_limits<TWeight>::max(); }
+
+private:
+    std::vector<TWeight> potentials_;
+    Snapshot reweighted_;
+
+    std::vector<TWeight> reweight(const Snapshot& graph, bool incoming) const {
+        std::vector<TWeight> weights;
+        weights.reserve(graph.getArcCount());
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            auto neighbors = incoming ? graph.getInNeighbors(v) : graph.getOutNeighbors(v);
+            auto arcWeights = incoming ? graph.getInWeights(v) : graph.getOutWeights(v);
+            for (size_t i = 0; i < neighbors.size(); ++i) {
+                int from = incoming ? neighbors[i] : v;
+                int to = incoming ? v : neighbors[i];
+                // Для плавающих весов округление может дать -0.0...1 вместо нуля
+                TWeight weight = arcWeights[i] + potentials_[from] - potentials_[to];
+                weights.push_back(weight < TWeight{} ? TWeight{} : weight);
+            }
+        }
+        return weights;
+    }
+
+    static std::vector<size_t> offsets(const Snapshot& graph, bool incoming) {
+        std::vector<size_t> result(graph.getVertexCount() + 1, 0);
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            result[v + 1] = result[v] + (incoming ? graph.getInDegree(v) : graph.getOutDegree(v));
+        }
+        return result;
+    }
+
+    static std::vector<int> neighbors(const Snapshot& graph, bool incoming) {
+        std::vector<int> result;
+        result.reserve(graph.getArcCount());
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            auto list = incoming ? graph.getInNeighbors(v) : graph.getOutNeighbors(v);
+            result.insert(result.end(), list.begin(), list.end());
+        }
+        return result;
+    }
+
+public:
+    // pool используется раундами Беллмана-Форда при расчете потенциалов
+    explicit JohnsonReweighting(const Snapshot& graph, ThreadPool* pool = nullptr) {
+        BellmanFordAlgorithm<TWeight, TIdentifier> bellmanFord(pool);
+        auto potentials = bellmanFord.run(graph, -1);
+        if (potentials.hasNegativeCycle) {
+            throw std::runtime_error("Graph contains a negative cycle.");
+        }
+        potentials_ = std::move(potentials.distances);
+
+        std::vector<TIdentifier> ids(graph.getVertexCount());
+        for (int v = 0; v < graph.getVertexCount(); ++v) {
+            ids[v] = graph.getId(v);
+        }
+        if (graph.isDirected()) {
+            reweighted_ = Snapshot(true, std::move(ids), offsets(graph, false), neighbors(graph, false),
+                                   reweight(graph, false), offsets(graph, true), neighbors(graph, true),
+                                   reweight(graph, true));
+        } else {
+            // Отрицательное неориентированное ребро - уже отрицательный цикл, поэтому здесь все h = 0
+            reweighted_ = Snapshot(false, std::move(ids), offsets(graph, false), neighbors(graph, false),
+                                   reweight(graph, false));
+        }
+    }
+
+    const std::vector<TWeight>& getPotentials() const { return potentials_; }
+
+    // Снимок с неотрицательными весами w(u, v) + h(u) - h(v) и теми же индексами вершин
+    const Snapshot& getReweightedGraph() const { return reweighted_; }
+
+    // Расстояния из source в исходных весах; unreachable() для недостижимых вершин
+    std::vector<TWeight> distancesFrom(int source) const {
+        int n = reweighted_.getVertexCount();
+        if (source < 0 || source >= n) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        // Индексная 4-арная куча: каждая вершина в ней не больше одного раза, ослабление - подъем по куче
+        std::vector<TWeight> distances(n, unreachable());
+        std::vector<int> heap;
+        std::vector<int> position(n, -1); // -1 - еще не в куче, -2 - расстояние окончательное
+        auto place = [&](size_t index, int v) {
+            heap[index] = v;
+            position[v] = static_cast<int>(index);
+        };
+        auto siftUp = [&](size_t index) {
+            int v = heap[index];
+            while (index > 0) {
+                size_t parent = (index - 1) / 4;
+                if (!(distances[v] < distances[heap[parent]])) break;
+                place(index, heap[parent]);
+                index = parent;
+            }
+            place(index, v);
+        };
+        auto siftDown = [&](size_t index) {
+            int v = heap[index];
+            while (true) {
+                size_t first = 4 * index + 1;
+                if (first >= heap.size()) break;
+                size_t best = first;
+                for (size_t child = first + 1; child < std::min(first + 4, heap.size()); ++child) {
+                    if (distances[heap[child]] < distances[heap[best]]) best = child;
+                }
+                if (!(distances[heap[best]] < distances[v])) break;
+                place(index, heap[best]);
+                index = best;
+            }
+            place(index, v);
+        };
+
+        distances[source] = TWeight{};
+        heap.push_back(source);
+        position[source] = 0;
+        while (!heap.empty()) {
+            int u = heap.front();
+            position[u] = -2;
+            int last = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) {
+                heap[0] = last;
+                siftDown(0);
+            }
+
+            TWeight distance = distances[u];
+            auto targets = reweighted_.getOutNeighbors(u);
+            auto weights = reweighted_.getOutWeights(u);
+            for (size_t i = 0; i < targets.size(); ++i) {
+                int v = targets[i];
+                if (position[v] == -2) continue;
+                TWeight candidate = distance + weights[i];
+                if (position[v] == -1) {
+                    distances[v] = candidate;
+                    heap.push_back(v);
+                    siftUp(heap.size() - 1);
+                } else if (candidate < distances[v]) {
+                    distances[v] = candidate;
+                    siftUp(position[v]);
+                }
+            }
+        }
+
+        for (int v = 0; v < n; ++v) {
+            if (distances[v] != unreachable()) {
+                distances[v] = distances[v] - potentials_[source] + potentials_[v];
+            }
+        }
+        return distances;
+    }
+};
+
+#endif // JOHNSONREWEIGHTING_H
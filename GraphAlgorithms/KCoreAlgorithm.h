@@ -0,0 +1,218 @@
+#ifndef KCOREALGORITHM_H
+#define KCOREALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "SortedAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Ядерное разложение. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()).
+struct KCoreResult {
+    std::vector<int> coreNumbers;     // наибольшее k, при котором вершина входит в k-ядро
+    int maxCore = 0;
+    std::vector<int> maxCoreVertices; // вершины maxCore-ядра по возрастанию индекса
+};
+
+// k-ядерное разложение неориентированного графа (кратные ребра и петли не учитываются).
+// Последовательно - алгоритм Батагеля-Заверсника: вершины разложены по корзинам степеней,
+// вершина минимальной степени снимается, степени ее соседей уменьшаются перестановкой внутри
+// массива корзин, всего O(V + E).
+// С пулом потоков - поуровневое снятие: для k = 0, 1, ... параллельно снимается фронт вершин
+// степени не больше k, соседи, чья степень опускается до k, попадают в следующий фронт того же уровня.
+// Оба варианта дают одинаковые номера ядер.
+template <typename TWeight, typename TIdentifier>
+class KCoreAlgorithm : public IAlgorithm<TWeight, KCoreResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+    using Adjacency = SortedAdjacency<TWeight, TIdentifier>;
+
+private:
+    ThreadPool* pool_ = nullptr;
+
+    // order, если задан, получает вершины в порядке снятия
+    static std::vector<int> peelSequential(const Adjacency& graph, std::vector<int>* order = nullptr) {
+        int n = graph.getVertexCount();
+        std::vector<int> degree(n);
+        int maxDegree = 0;
+        for (int v = 0; v < n; ++v) {
+            degree[v] = static_cast<int>(graph.getDegree(v));
+            maxDegree = std::max(maxDegree, degree[v]);
+        }
+
+        // bin[d] - начало корзины степени d в массиве vertices, position[v] - место вершины в нем
+        std::vector<int> bin(maxDegree + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            ++bin[degree[v]];
+        }
+        int start = 0;
+        for (int d = 0; d <= maxDegree; ++d) {
+            int count = bin[d];
+            bin[d] = start;
+            start += count;
+        }
+        std::vector<int> vertices(n);
+        std::vector<int> position(n);
+        for (int v = 0; v < n; ++v) {
+            position[v] = bin[degree[v]]++;
+            vertices[position[v]] = v;
+        }
+        // Заполнение сдвинуло начала корзин на их размер - возвращаем
+        for (int d = maxDegree; d > 0; --d) {
+            bin[d] = bin[d - 1];
+        }
+        bin[0] = 0;
+
+        for (int i = 0; i < n; ++i) {
+            int v = vertices[i];
+            for (int u : graph.getNeighbors(v)) {
+                if (degree[u] > degree[v]) {
+                    // Меняем u с первой вершиной ее корзины и сдвигаем границу корзины
+                    int degreeU = degree[u];
+                    int positionU = position[u];
+                    int firstPosition = bin[degreeU];
+                    int first = vertices[firstPosition];
+                    if (u != first) {
+                        position[u] = firstPosition;
+                        vertices[positionU] = first;
+                        position[first] = positionU;
+                        vertices[firstPosition] = u;
+                    }
+                    ++bin[degreeU];
+                    --degree[u];
+                }
+            }
+        }
+        if (order) {
+            *order = std::move(vertices);
+        }
+        return degree;
+    }
+
+    std::vector<int> peelParallel(const Adjacency& graph) const {
+        int n = graph.getVertexCount();
+        std::vector<int> degree(n);
+        std::vector<int> core(n, -1);
+        for (int v = 0; v < n; ++v) {
+            degree[v] = static_cast<int>(graph.getDegree(v));
+        }
+
+        std::vector<int> remaining(n);
+        for (int v = 0; v < n; ++v) {
+            remaining[v] = v;
+        }
+        std::vector<int> frontier;
+        std::vector<int> next;
+        std::mutex mergeMutex;
+
+        auto forRange = [&](size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+            pool_->parallelFor(0, count, body, grain);
+        };
+        auto append = [&](std::vector<int>& target, std::vector<int>& local) {
+            if (local.empty()) return;
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            target.insert(target.end(), local.begin(), local.end());
+        };
+
+        for (int k = 0; !remaining.empty(); ++k) {
+            frontier.clear();
+            forRange(remaining.size(), 1024, [&](size_t lo, size_t hi) {
+                std::vector<int> local;
+                for (size_t i = lo; i < hi; ++i) {
+                    int v = remaining[i];
+                    if (degree[v] <= k) {
+                        core[v] = k;
+                        local.push_back(v);
+                    }
+                }
+                append(frontier, local);
+            });
+
+            while (!frontier.empty()) {
+                next.clear();
+                forRange(frontier.size(), 64, [&](size_t lo, size_t hi) {
+                    std::vector<int> local;
+                    for (size_t i = lo; i < hi; ++i) {
+                        for (int u : graph.getNeighbors(frontier[i])) {
+                            if (std::atomic_ref<int>(core[u]).load(std::memory_order_relaxed) != -1) continue;
+                            // Переход степени через k + 1 -> k происходит ровно один раз, его видит один поток
+                            if (std::atomic_ref<int>(degree[u]).fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                                std::atomic_ref<int>(core[u]).store(k, std::memory_order_relaxed);
+                                local.push_back(u);
+                            }
+                        }
+                    }
+                    append(next, local);
+                });
+                frontier.swap(next);
+            }
+
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](int v) { return core[v] != -1; }),
+                            remaining.end());
+        }
+        return core;
+    }
+
+public:
+    explicit KCoreAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~KCoreAlgorithm() override = default;
+
+    // nullptr - последовательный алгоритм Батагеля-Заверсника
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // Вырожденный порядок: вершины в порядке снятия вершины минимальной степени.
+    // Обратный к нему - порядок smallest-last для жадной раскраски
+    static std::vector<int> degeneracyOrder(const Adjacency& graph) {
+        std::vector<int> order;
+        peelSequential(graph, &order);
+        return order;
+    }
+
+    KCoreResult run(const Snapshot& graph) const {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("k-core decomposition requires an undirected graph.");
+        }
+        Adjacency adjacency(graph, pool_);
+
+        KCoreResult result;
+        result.coreNumbers = pool_ ? peelParallel(adjacency) : peelSequential(adjacency);
+        for (int core : result.coreNumbers) {
+            result.maxCore = std::max(result.maxCore, core);
+        }
+        for (int v = 0; v < adjacency.getVertexCount(); ++v) {
+            if (result.coreNumbers[v] == result.maxCore) {
+                result.maxCoreVertices.push_back(v);
+            }
+        }
+        return result;
+    }
+
+    SharedPtr<KCoreResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (graph->isDirected()) {
+            throw std::invalid_argument("k-core decomposition requires an undirected graph.");
+        }
+        return MakeShared<KCoreResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // KCOREALGORITHM_H
@@ -0,0 +1,399 @@
+#ifndef LOUVAINALGORITHM_H
+#define LOUVAINALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Разбиение на сообщества. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()).
+struct LouvainResult {
+    // levels[l][v] - сообщество вершины v после уровня l; номера сообществ плотные, от 0
+    std::vector<std::vector<int>> levels;
+    std::vector<int> communities;         // последний уровень (без уровней - каждая вершина отдельно)
+    int communityCount = 0;
+    std::vector<double> levelModularity;  // модулярность после каждого уровня
+    double modularity = 0;
+};
+
+// Алгоритм Louvain для взвешенного неориентированного графа. Уровень состоит из двух фаз:
+// - локальные перемещения: вершина переходит в соседнее сообщество с наибольшим приростом модулярности
+//   k(v, c) - resolution * k(v) * tot(c) / 2m, пока проходы по вершинам заметно увеличивают модулярность;
+//   повторно просматриваются только вершины, у которых переместился сосед;
+// - стягивание: сообщества становятся вершинами нового графа, веса ребер между ними суммируются,
+//   внутренние ребра становятся петлями.
+// Суммарные степени сообществ лежат в плоском массиве, веса соседних сообществ вершины собираются
+// в небольшой хеш-таблице с открытой адресацией. С пулом потоков локальные перемещения идут
+// параллельно по блокам вершин с атомарным обновлением сообществ и их степеней (асинхронно, как
+// в последовательном варианте, но порядок ходов зависит от потоков), стягивание - параллельно по сообществам.
+template <typename TWeight, typename TIdentifier>
+class LouvainAlgorithm : public IAlgorithm<TWeight, LouvainResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+private:
+    static constexpr int kMaxSweeps = 32;
+
+    // Граф уровня: симметричная матрица смежности A в CSR, петля хранится одной дугой v -> v
+    struct Level {
+        std::vector<size_t> offsets;
+        std::vector<int> targets;
+        std::vector<double> weights;
+        std::vector<double> degrees; // k(v) = сумма A(v, u) по всем u, включая петлю
+        double totalWeight = 0;      // 2m = сумма всех A(u, v)
+
+        int getVertexCount() const { return static_cast<int>(offsets.size()) - 1; }
+    };
+
+    // Веса соседних сообществ одной вершины; очищается только по занятым ячейкам
+    class CommunityWeights {
+    private:
+        std::vector<int> keys_;
+        std::vector<double> values_;
+        std::vector<int> used_;
+        size_t mask_ = 0;
+
+    public:
+        explicit CommunityWeights(size_t maxDegree) {
+            size_t capacity = 4;
+            while (capacity < 2 * maxDegree + 2) {
+                capacity *= 2;
+            }
+            keys_.assign(capacity, -1);
+            values_.assign(capacity, 0.0);
+            mask_ = capacity - 1;
+        }
+
+        void add(int community, double weight) {
+            size_t slot = (static_cast<uint32_t>(community) * 0x9E3779B1u) & mask_;
+            while (keys_[slot] != community) {
+                if (keys_[slot] == -1) {
+                    keys_[slot] = community;
+                    used_.push_back(static_cast<int>(slot));
+                    break;
+                }
+                slot = (slot + 1) & mask_;
+            }
+            values_[slot] += weight;
+        }
+
+        double get(int community) const {
+            size_t slot = (static_cast<uint32_t>(community) * 0x9E3779B1u) & mask_;
+            while (keys_[slot] != -1) {
+                if (keys_[slot] == community) return values_[slot];
+                slot = (slot + 1) & mask_;
+            }
+            return 0.0;
+        }
+
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            for (int slot : used_) {
+                visit(keys_[slot], values_[slot]);
+            }
+        }
+
+        void clear() {
+            for (int slot : used_) {
+                keys_[slot] = -1;
+                values_[slot] = 0.0;
+            }
+            used_.clear();
+        }
+    };
+
+    ThreadPool* pool_ = nullptr;
+    double resolution_ = 1.0;
+    double tolerance_ = 1e-7;
+
+    void forRange(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) const {
+        if (pool_) {
+            pool_->parallelFor(0, count, body, grain);
+        } else {
+            body(0, count);
+        }
+    }
+
+    static Level fromSnapshot(const Snapshot& graph) {
+        Level level;
+        level.offsets = graph.getOutOffsets();
+        level.targets = graph.getOutTargets();
+        const auto& weights = graph.getOutWeights();
+        level.weights.resize(weights.size());
+        for (size_t i = 0; i < weights.size(); ++i) {
+            if (weights[i] < TWeight{}) {
+                throw std::runtime_error("Louvain requires non-negative edge weights.");
+            }
+            level.weights[i] = static_cast<double>(weights[i]);
+        }
+        computeDegrees(level);
+        return level;
+    }
+
+    static void computeDegrees(Level& level) {
+        int n = level.getVertexCount();
+        level.degrees.assign(n, 0.0);
+        level.totalWeight = 0;
+        for (int v = 0; v < n; ++v) {
+            for (size_t i = level.offsets[v]; i < level.offsets[v + 1]; ++i) {
+                level.degrees[v] += level.weights[i];
+            }
+            level.totalWeight += level.degrees[v];
+        }
+    }
+
+    double modularity(const Level& level, const std::vector<int>& community) const {
+        if (level.totalWeight <= 0) return 0.0;
+        int n = level.getVertexCount();
+        std::vector<double> inside(n, 0.0);
+        std::vector<double> total(n, 0.0);
+        for (int v = 0; v < n; ++v) {
+            total[community[v]] += level.degrees[v];
+            for (size_t i = level.offsets[v]; i < level.offsets[v + 1]; ++i) {
+                if (community[level.targets[i]] == community[v]) {
+                    inside[community[v]] += level.weights[i];
+                }
+            }
+        }
+        double q = 0;
+        for (int c = 0; c < n; ++c) {
+            double share = total[c] / level.totalWeight;
+            q += inside[c] / level.totalWeight - resolution_ * share * share;
+        }
+        return q;
+    }
+
+    // Локальные перемещения; возвращает разбиение вершин уровня (номера - вершины-представители)
+    std::vector<int> moveVertices(const Level& level) const {
+        int n = level.getVertexCount();
+        std::vector<int> community(n);
+        std::vector<double> total(level.degrees);
+        for (int v = 0; v < n; ++v) {
+            community[v] = v;
+        }
+        if (level.totalWeight <= 0) return community;
+
+        size_t maxDegree = 0;
+        for (int v = 0; v < n; ++v) {
+            maxDegree = std::max(maxDegree, level.offsets[v + 1] - level.offsets[v]);
+        }
+        double scale = resolution_ / level.totalWeight;
+        // Вершина пересматривается, только если после ее прошлого просмотра переместился кто-то из соседей
+        std::vector<char> active(n, 1);
+
+        for (int sweep = 0; sweep < kMaxSweeps; ++sweep) {
+            std::atomic<int> moved{0};
+            std::atomic<double> sweepGain{0.0};
+            forRange(n, 256, [&](size_t lo, size_t hi) {
+                CommunityWeights neighbors(maxDegree);
+                int localMoved = 0;
+                double localGain = 0;
+                for (size_t index = lo; index < hi; ++index) {
+                    int v = static_cast<int>(index);
+                    if (!std::atomic_ref<char>(active[v]).exchange(0, std::memory_order_relaxed)) continue;
+                    for (size_t i = level.offsets[v]; i < level.offsets[v + 1]; ++i) {
+                        int u = level.targets[i];
+                        if (u != v) {
+                            neighbors.add(std::atomic_ref<int>(community[u]).load(std::memory_order_relaxed),
+                                          level.weights[i]);
+                        }
+                    }
+
+                    // Вершина сначала выходит из своего сообщества, затем выбирает лучшее, включая прежнее
+                    int current = community[v];
+                    double degree = level.degrees[v];
+                    std::atomic_ref<double>(total[current]).fetch_sub(degree, std::memory_order_relaxed);
+                    auto gain = [&](int c, double weight) {
+                        return weight - degree * scale * std::atomic_ref<double>(total[c]).load(std::memory_order_relaxed);
+                    };
+                    int best = current;
+                    double currentGain = gain(current, neighbors.get(current));
+                    double bestGain = currentGain;
+                    neighbors.forEach([&](int c, double weight) {
+                        double candidate = gain(c, weight);
+                        if (candidate > bestGain || (candidate == bestGain && c < best)) {
+                            best = c;
+                            bestGain = candidate;
+                        }
+                    });
+                    std::atomic_ref<double>(total[best]).fetch_add(degree, std::memory_order_relaxed);
+                    if (best != current) {
+                        std::atomic_ref<int>(community[v]).store(best, std::memory_order_relaxed);
+                        ++localMoved;
+                        localGain += bestGain - currentGain;
+                        for (size_t i = level.offsets[v]; i < level.offsets[v + 1]; ++i) {
+                            std::atomic_ref<char>(active[level.targets[i]]).store(1, std::memory_order_relaxed);
+                        }
+                    }
+                    neighbors.clear();
+                }
+                moved.fetch_add(localMoved, std::memory_order_relaxed);
+                sweepGain.fetch_add(localGain, std::memory_order_relaxed);
+            });
+
+            // Прирост модулярности от перехода - 2 / 2m от разности выигрышей
+            if (moved.load() == 0 || 2 * sweepGain.load() / level.totalWeight <= tolerance_) break;
+        }
+        return community;
+    }
+
+    // Плотные номера сообществ от 0; возвращает число сообществ
+    static int renumber(std::vector<int>& community) {
+        std::vector<int> index(community.size(), -1);
+        int count = 0;
+        for (int& c : community) {
+            if (index[c] == -1) {
+                index[c] = count++;
+            }
+            c = index[c];
+        }
+        return count;
+    }
+
+    // Граф сообществ: A'(C, D) = сумма A(u, v) по u из C и v из D; A'(C, C) - петля
+    Level contract(const Level& level, const std::vector<int>& community, int count) const {
+        int n = level.getVertexCount();
+        std::vector<size_t> memberOffsets(count + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            ++memberOffsets[community[v] + 1];
+        }
+        for (int c = 0; c < count; ++c) {
+            memberOffsets[c + 1] += memberOffsets[c];
+        }
+        std::vector<int> members(n);
+        std::vector<size_t> fill(memberOffsets.begin(), memberOffsets.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            members[fill[community[v]]++] = v;
+        }
+
+        std::vector<std::vector<std::pair<int, double>>> rows(count);
+        size_t maxDegree = 0;
+        for (int c = 0; c < count; ++c) {
+            size_t degree = 0;
+            for (size_t i = memberOffsets[c]; i < memberOffsets[c + 1]; ++i) {
+                degree += level.offsets[members[i] + 1] - level.offsets[members[i]];
+            }
+            maxDegree = std::max(maxDegree, degree);
+        }
+        forRange(count, 64, [&](size_t lo, size_t hi) {
+            CommunityWeights neighbors(maxDegree);
+            for (size_t c = lo; c < hi; ++c) {
+                for (size_t i = memberOffsets[c]; i < memberOffsets[c + 1]; ++i) {
+                    int v = members[i];
+                    for (size_t j = level.offsets[v]; j < level.offsets[v + 1]; ++j) {
+                        neighbors.add(community[level.targets[j]], level.weights[j]);
+                    }
+                }
+                neighbors.forEach([&](int d, double weight) { rows[c].push_back({d, weight}); });
+                std::sort(rows[c].begin(), rows[c].end());
+                neighbors.clear();
+            }
+        });
+
+        Level next;
+        next.offsets.assign(count + 1, 0);
+        for (int c = 0; c < count; ++c) {
+            next.offsets[c + 1] = next.offsets[c] + rows[c].size();
+        }
+        next.targets.resize(next.offsets[count]);
+        next.weights.resize(next.offsets[count]);
+        for (int c = 0; c < count; ++c) {
+            for (size_t i = 0; i < rows[c].size(); ++i) {
+                next.targets[next.offsets[c] + i] = rows[c][i].first;
+                next.weights[next.offsets[c] + i] = rows[c][i].second;
+            }
+        }
+        computeDegrees(next);
+        return next;
+    }
+
+public:
+    explicit LouvainAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~LouvainAlgorithm() override = default;
+
+    // nullptr - последовательный расчет
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    // Параметр разрешения: больше 1 - мельче сообщества, меньше 1 - крупнее
+    void setResolution(double resolution) {
+        if (!(resolution > 0)) {
+            throw std::invalid_argument("Resolution must be positive.");
+        }
+        resolution_ = resolution;
+    }
+
+    // Минимальный прирост модулярности, ради которого продолжаются проходы и уровни
+    void setTolerance(double tolerance) {
+        if (!(tolerance >= 0)) {
+            throw std::invalid_argument("Tolerance must be non-negative.");
+        }
+        tolerance_ = tolerance;
+    }
+
+    LouvainResult run(const Snapshot& graph) const {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("Louvain requires an undirected graph.");
+        }
+        Level level = fromSnapshot(graph);
+        int n = level.getVertexCount();
+
+        LouvainResult result;
+        std::vector<int> membership(n);
+        for (int v = 0; v < n; ++v) {
+            membership[v] = v;
+        }
+        double quality = modularity(level, membership);
+        result.modularity = quality;
+        result.communityCount = n;
+
+        while (level.getVertexCount() > 0) {
+            std::vector<int> community = moveVertices(level);
+            int count = renumber(community);
+            if (count == level.getVertexCount()) break;
+
+            double next = modularity(level, community);
+            if (next - quality <= tolerance_ && !result.levels.empty()) break;
+            for (int& c : membership) {
+                c = community[c];
+            }
+            result.levels.push_back(membership);
+            result.levelModularity.push_back(next);
+            result.modularity = next;
+            result.communityCount = count;
+            quality = next;
+            level = contract(level, community, count);
+        }
+
+        result.communities = result.levels.empty() ? membership : result.levels.back();
+        return result;
+    }
+
+    SharedPtr<LouvainResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (graph->isDirected()) {
+            throw std::invalid_argument("Louvain requires an undirected graph.");
+        }
+        return MakeShared<LouvainResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // LOUVAINALGORITHM_H
@@ -0,0 +1,453 @@
+#ifndef MAXFLOWALGORITHM_H
+#define MAXFLOWALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Максимальный поток и минимальный разрез; веса ребер - пропускные способности.
+// Индексы - плотные индексы снимка CompressedGraph (для execute это порядок graph->getVertices()).
+template <typename TWeight>
+struct MaxFlowResult {
+    TWeight flowValue{};
+    // Поток по каждой дуге снимка в порядке getOutTargets(); неориентированное ребро - две дуги,
+    // поток по ребру равен разности потоков по ним
+    std::vector<TWeight> flows;
+    std::vector<int> sourceSide; // вершины, достижимые из истока в остаточной сети, по возрастанию индекса
+    std::vector<int> cutArcs;    // дуги снимка из sourceSide в остальные вершины; их сумма равна flowValue
+
+    long long pushes = 0;
+    long long relabels = 0;
+    int globalRelabels = 0;
+    int gaps = 0;
+};
+
+// Алгоритм проталкивания предпотока с выбором активной вершины наибольшей высоты.
+// Остаточная сеть хранится одним массивом дуг, сгруппированных по вершине: сначала дуги снимка,
+// затем обратные к входящим; у каждой дуги хранится индекс парной, поэтому обратная дуга
+// находится за O(1). Эвристики:
+// - глобальная перенумерация: высоты пересчитываются обходом в ширину от стока по остаточной сети
+//   после объема работы порядка 6V + E (как в HIPR Черкасского-Гольдберга);
+// - разрыв: если высота h опустела, все вершины выше h не достигают стока и сразу получают высоту V.
+// Первая фаза находит предпоток, величина которого уже равна максимальному потоку; вторая возвращает
+// излишки в исток, чтобы поток по дугам был корректным.
+template <typename TWeight, typename TIdentifier>
+class MaxFlowAlgorithm : public IAlgorithm<TWeight, MaxFlowResult<TWeight>, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+    using Result = MaxFlowResult<TWeight>;
+
+private:
+    static constexpr int kRelabelWork = 12; // условная стоимость перенумерации сверх просмотра ее дуг
+    static constexpr int kVertexWork = 6;
+
+    struct Arc {
+        int head;          // конец дуги
+        int pair;          // индекс парной дуги в массиве
+        TWeight residual;  // остаточная пропускная способность
+    };
+
+    // Рабочее состояние одного запуска
+    struct Network {
+        int n = 0;
+        int source = 0;
+        int sink = 0;
+        std::vector<size_t> offsets;
+        std::vector<Arc> arcs;
+        std::vector<size_t> forward; // дуга снимка -> ее индекс в arcs
+
+        std::vector<TWeight> excess;
+        std::vector<int> label;
+        std::vector<size_t> current; // текущая дуга вершины
+
+        // Списки по высотам: активные вершины (односвязные) и все вершины ниже V (двусвязные, для разрывов)
+        std::vector<int> activeHead;
+        std::vector<int> activeNext;
+        std::vector<int> allHead;
+        std::vector<int> allNext;
+        std::vector<int> allPrev;
+        int maxLabel = 0;  // наибольшая непустая высота в списках всех вершин
+        int maxActive = -1;
+        double work = 0;
+    };
+
+    double globalRelabelFrequency_ = 0.5;
+
+    static Network buildNetwork(const Snapshot& graph, int source, int sink) {
+        Network net;
+        int n = graph.getVertexCount();
+        net.n = n;
+        net.source = source;
+        net.sink = sink;
+        net.offsets.assign(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            net.offsets[v + 1] = net.offsets[v] + graph.getOutDegree(v) + graph.getInDegree(v);
+        }
+        net.arcs.resize(net.offsets[n]);
+        net.forward.resize(graph.getArcCount());
+
+        // Обратные дуги вершины идут после ее дуг снимка
+        std::vector<size_t> reverseFill(n);
+        for (int v = 0; v < n; ++v) {
+            reverseFill[v] = net.offsets[v] + graph.getOutDegree(v);
+        }
+        const auto& outOffsets = graph.getOutOffsets();
+        const auto& targets = graph.getOutTargets();
+        const auto& capacities = graph.getOutWeights();
+        for (int u = 0; u < n; ++u) {
+            for (size_t k = outOffsets[u]; k < outOffsets[u + 1]; ++k) {
+                if (capacities[k] < TWeight{}) {
+                    throw std::runtime_error("Max flow requires non-negative capacities.");
+                }
+                int v = targets[k];
+                size_t arc = net.offsets[u] + (k - outOffsets[u]);
+                size_t reverse = reverseFill[v]++;
+                // Петля не влияет на поток - оставляем ей нулевую пропускную способность
+                net.arcs[arc] = Arc{v, static_cast<int>(reverse), u == v ? TWeight{} : capacities[k]};
+                net.arcs[reverse] = Arc{u, static_cast<int>(arc), TWeight{}};
+                net.forward[k] = arc;
+            }
+        }
+
+        net.excess.assign(n, TWeight{});
+        net.label.assign(n, 0);
+        net.current.assign(net.offsets.begin(), net.offsets.end() - 1);
+        net.activeHead.assign(n + 1, -1);
+        net.activeNext.assign(n, -1);
+        net.allHead.assign(n + 1, -1);
+        net.allNext.assign(n, -1);
+        net.allPrev.assign(n, -1);
+        return net;
+    }
+
+    static void addActive(Network& net, int v) {
+        int h = net.label[v];
+        net.activeNext[v] = net.activeHead[h];
+        net.activeHead[h] = v;
+        net.maxActive = std::max(net.maxActive, h);
+    }
+
+    static void addToLabel(Network& net, int v) {
+        int h = net.label[v];
+        net.allPrev[v] = -1;
+        net.allNext[v] = net.allHead[h];
+        if (net.allHead[h] != -1) {
+            net.allPrev[net.allHead[h]] = v;
+        }
+        net.allHead[h] = v;
+        net.maxLabel = std::max(net.maxLabel, h);
+    }
+
+    static void removeFromLabel(Network& net, int v) {
+        int h = net.label[v];
+        if (net.allPrev[v] != -1) {
+            net.allNext[net.allPrev[v]] = net.allNext[v];
+        } else {
+            net.allHead[h] = net.allNext[v];
+        }
+        if (net.allNext[v] != -1) {
+            net.allPrev[net.allNext[v]] = net.allPrev[v];
+        }
+    }
+
+    // Высота - расстояние до стока по остаточной сети; недостижимые вершины получают V
+    static void globalRelabel(Network& net, Result& result) {
+        int n = net.n;
+        ++result.globalRelabels;
+        net.work = 0;
+        std::fill(net.label.begin(), net.label.end(), n);
+        std::fill(net.activeHead.begin(), net.activeHead.end(), -1);
+        std::fill(net.allHead.begin(), net.allHead.end(), -1);
+        net.maxLabel = 0;
+        net.maxActive = -1;
+
+        std::vector<int> queue{net.sink};
+        net.label[net.sink] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int w = queue[head];
+            int next = net.label[w] + 1;
+            for (size_t a = net.offsets[w]; a < net.offsets[w + 1]; ++a) {
+                int x = net.arcs[a].head;
+                // Дуга x -> w парна дуге w -> x
+                if (net.label[x] == n && x != net.source && net.arcs[net.arcs[a].pair].residual > TWeight{}) {
+                    net.label[x] = next;
+                    queue.push_back(x);
+                    addToLabel(net, x);
+                    net.current[x] = net.offsets[x];
+                    if (net.excess[x] > TWeight{}) {
+                        addActive(net, x);
+                    }
+                }
+            }
+        }
+    }
+
+    // Все вершины выше опустевшей высоты gap отрезаны от стока
+    static void applyGap(Network& net, int gap, Result& result) {
+        ++result.gaps;
+        for (int h = gap + 1; h <= net.maxLabel; ++h) {
+            for (int u = net.allHead[h]; u != -1; u = net.allNext[u]) {
+                net.label[u] = net.n;
+            }
+            net.allHead[h] = -1;
+            net.activeHead[h] = -1;
+        }
+        net.maxLabel = gap - 1;
+    }
+
+    // Новая высота: на единицу больше минимальной среди концов остаточных дуг
+    static int relabel(Network& net, int v, Result& result) {
+        ++result.relabels;
+        int best = net.n;
+        size_t bestArc = net.offsets[v];
+        for (size_t a = net.offsets[v]; a < net.offsets[v + 1]; ++a) {
+            const Arc& arc = net.arcs[a];
+            if (arc.residual > TWeight{} && net.label[arc.head] + 1 < best) {
+                best = net.label[arc.head] + 1;
+                bestArc = a;
+            }
+        }
+        net.current[v] = bestArc;
+        net.work += kRelabelWork + static_cast<double>(net.offsets[v + 1] - net.offsets[v]);
+        return best;
+    }
+
+    static void push(Network& net, int v, Arc& arc, Result& result) {
+        TWeight delta = std::min(net.excess[v], arc.residual);
+        arc.residual -= delta;
+        net.arcs[arc.pair].residual += delta;
+        net.excess[v] -= delta;
+        ++result.pushes;
+        int w = arc.head;
+        bool wasInactive = !(net.excess[w] > TWeight{});
+        net.excess[w] += delta;
+        if (wasInactive && w != net.sink && w != net.source && net.label[w] < net.n) {
+            addActive(net, w);
+        }
+    }
+
+    // Проталкивает излишек v по допустимым дугам (высота конца на единицу меньше), иначе поднимает v
+    static void discharge(Network& net, int v, Result& result) {
+        while (true) {
+            int h = net.label[v];
+            size_t end = net.offsets[v + 1];
+            size_t a = net.current[v];
+            for (; a < end; ++a) {
+                Arc& arc = net.arcs[a];
+                if (arc.residual > TWeight{} && net.label[arc.head] == h - 1) {
+                    push(net, v, arc, result);
+                    if (!(net.excess[v] > TWeight{})) break;
+                }
+            }
+            if (a < end) {
+                net.current[v] = a;
+                return;
+            }
+
+            removeFromLabel(net, v);
+            if (net.allHead[h] == -1) {
+                applyGap(net, h, result);
+                net.label[v] = net.n;
+                return;
+            }
+            int next = relabel(net, v, result);
+            net.label[v] = next;
+            if (next >= net.n) {
+                return;
+            }
+            addToLabel(net, v);
+        }
+    }
+
+    void findPreflow(Network& net, Result& result) const {
+        int n = net.n;
+        double threshold = static_cast<double>(kVertexWork) * n + static_cast<double>(net.arcs.size());
+
+        for (size_t a = net.offsets[net.source]; a < net.offsets[net.source + 1]; ++a) {
+            Arc& arc = net.arcs[a];
+            if (arc.residual > TWeight{}) {
+                net.excess[net.source] += arc.residual;
+                push(net, net.source, arc, result);
+            }
+        }
+        net.excess[net.source] = TWeight{};
+        globalRelabel(net, result);
+        net.label[net.source] = n;
+
+        while (net.maxActive >= 0) {
+            int v = net.activeHead[net.maxActive];
+            if (v == -1) {
+                --net.maxActive;
+                continue;
+            }
+            net.activeHead[net.maxActive] = net.activeNext[v];
+            discharge(net, v, result);
+            if (globalRelabelFrequency_ > 0 && net.work * globalRelabelFrequency_ > threshold) {
+                globalRelabel(net, result);
+            }
+        }
+    }
+
+    // Излишки вершин, отрезанных от стока, возвращаются в исток: высота - расстояние до истока по
+    // остаточной сети, обработка в порядке очереди. Сток из таких вершин недостижим, поэтому поток в него не меняется
+    static void returnExcess(Network& net, Result& result) {
+        int n = net.n;
+        int unset = 2 * n + 1;
+        std::fill(net.label.begin(), net.label.end(), unset);
+        std::vector<int> queue{net.source};
+        net.label[net.source] = 0;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int w = queue[head];
+            for (size_t a = net.offsets[w]; a < net.offsets[w + 1]; ++a) {
+                int x = net.arcs[a].head;
+                if (net.label[x] == unset && net.arcs[net.arcs[a].pair].residual > TWeight{}) {
+                    net.label[x] = net.label[w] + 1;
+                    queue.push_back(x);
+                }
+            }
+        }
+
+        queue.clear();
+        for (int v = 0; v < n; ++v) {
+            net.current[v] = net.offsets[v];
+            if (v != net.source && v != net.sink && net.excess[v] > TWeight{}) {
+                queue.push_back(v);
+            }
+        }
+        std::vector<char> queued(n, 0);
+        for (int v : queue) {
+            queued[v] = 1;
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            queued[v] = 0;
+            while (net.excess[v] > TWeight{}) {
+                size_t end = net.offsets[v + 1];
+                size_t a = net.current[v];
+                for (; a < end && net.excess[v] > TWeight{}; ++a) {
+                    Arc& arc = net.arcs[a];
+                    int w = arc.head;
+                    if (!(arc.residual > TWeight{}) || net.label[w] + 1 != net.label[v]) continue;
+                    TWeight delta = std::min(net.excess[v], arc.residual);
+                    arc.residual -= delta;
+                    net.arcs[arc.pair].residual += delta;
+                    net.excess[v] -= delta;
+                    net.excess[w] += delta;
+                    ++result.pushes;
+                    if (w != net.source && !queued[w]) {
+                        queued[w] = 1;
+                        queue.push_back(w);
+                    }
+                }
+                if (net.excess[v] > TWeight{}) {
+                    ++result.relabels;
+                    int best = unset;
+                    for (size_t b = net.offsets[v]; b < end; ++b) {
+                        if (net.arcs[b].residual > TWeight{}) {
+                            best = std::min(best, net.label[net.arcs[b].head] + 1);
+                        }
+                    }
+                    if (best == unset) {
+                        break; // излишек всегда связан с истоком; защита от зацикливания на погрешностях
+                    }
+                    net.label[v] = best;
+                    net.current[v] = net.offsets[v];
+                } else {
+                    net.current[v] = a > net.offsets[v] ? a - 1 : a;
+                }
+            }
+        }
+    }
+
+    static void extractResult(const Snapshot& graph, const Network& net, Result& result) {
+        result.flowValue = net.excess[net.sink];
+        const auto& capacities = graph.getOutWeights();
+        result.flows.resize(capacities.size());
+        for (size_t k = 0; k < capacities.size(); ++k) {
+            const Arc& arc = net.arcs[net.forward[k]];
+            result.flows[k] = net.arcs[arc.pair].residual;
+        }
+
+        // Исходная сторона разреза - достижимые из истока по остаточным дугам
+        std::vector<char> reached(net.n, 0);
+        std::vector<int> queue{net.source};
+        reached[net.source] = 1;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int v = queue[head];
+            for (size_t a = net.offsets[v]; a < net.offsets[v + 1]; ++a) {
+                int w = net.arcs[a].head;
+                if (!reached[w] && net.arcs[a].residual > TWeight{}) {
+                    reached[w] = 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        const auto& outOffsets = graph.getOutOffsets();
+        const auto& targets = graph.getOutTargets();
+        for (int v = 0; v < net.n; ++v) {
+            if (!reached[v]) continue;
+            result.sourceSide.push_back(v);
+            for (size_t k = outOffsets[v]; k < outOffsets[v + 1]; ++k) {
+                if (!reached[targets[k]]) {
+                    result.cutArcs.push_back(static_cast<int>(k));
+                }
+            }
+        }
+    }
+
+public:
+    MaxFlowAlgorithm() = default;
+    ~MaxFlowAlgorithm() override = default;
+
+    // Частота глобальной перенумерации относительно работы 6V + E; 0 - только начальная перенумерация
+    void setGlobalRelabelFrequency(double frequency) {
+        if (frequency < 0) {
+            throw std::invalid_argument("Global relabel frequency must be non-negative.");
+        }
+        globalRelabelFrequency_ = frequency;
+    }
+
+    Result run(const Snapshot& graph, int source, int sink) const {
+        int n = graph.getVertexCount();
+        if (source < 0 || source >= n || sink < 0 || sink >= n) {
+            throw std::invalid_argument("Source or sink does not exist in the graph.");
+        }
+        if (source == sink) {
+            throw std::invalid_argument("Source and sink must be different vertices.");
+        }
+
+        Result result;
+        Network net = buildNetwork(graph, source, sink);
+        findPreflow(net, result);
+        returnExcess(net, result);
+        extractResult(graph, net, result);
+        return result;
+    }
+
+    SharedPtr<Result> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (!startVertex || !endVertex) {
+            throw std::invalid_argument("Source and sink must be specified.");
+        }
+        if (!graph->hasVertex(startVertex) || !graph->hasVertex(endVertex)) {
+            throw std::invalid_argument("Source or sink does not exist in the graph.");
+        }
+        Snapshot snapshot = Snapshot::fromGraph(graph);
+        return MakeShared<Result>(run(snapshot, snapshot.getIndex(startVertex->getId()),
+                                      snapshot.getIndex(endVertex->getId())));
+    }
+};
+
+#endif // MAXFLOWALGORITHM_H
@@ -0,0 +1,223 @@
+#ifndef PAGERANKALGORITHM_H
+#define PAGERANKALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Результат PageRank. Индексы - плотные индексы снимка CompressedGraph
+// (для execute это порядок graph->getVertices()), сумма рангов равна 1.
+struct PageRankResult {
+    std::vector<double> ranks;
+    int iterations = 0;
+    double residual = 0;   // L1-норма изменения рангов на последней итерации
+    bool converged = false;
+};
+
+// PageRank методом степенных итераций с вытягиванием (pull): ранг вершины собирается по ее
+// входящим дугам, поэтому каждая вершина пишет только свою ячейку и строки можно делить между
+// потоками без синхронизации. Ранг висячих вершин (без исходящих дуг) распределяется по вектору
+// телепортации. Персонализированный и тематический PageRank - тот же движок с другим вектором
+// телепортации. Веса ребер не учитываются, кратные ребра учитываются с кратностью.
+// Суммы по блокам строк складываются в фиксированном порядке, поэтому результат не зависит
+// от числа потоков.
+template <typename TWeight, typename TIdentifier>
+class PageRankAlgorithm : public IAlgorithm<TWeight, PageRankResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+private:
+    static constexpr size_t kRowBlock = 2048;
+
+    ThreadPool* pool_ = nullptr;
+    double damping_ = 0.85;
+    double tolerance_ = 1e-9;
+    int maxIterations_ = 100;
+
+    // body(block, lo, hi) для блоков строк по kRowBlock
+    void forBlocks(size_t rowCount, const std::function<void(size_t, size_t, size_t)>& body) const {
+        size_t blockCount = (rowCount + kRowBlock - 1) / kRowBlock;
+        auto runBlocks = [&](size_t first, size_t last) {
+            for (size_t block = first; block < last; ++block) {
+                body(block, block * kRowBlock, std::min(rowCount, (block + 1) * kRowBlock));
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, blockCount, runBlocks);
+        } else {
+            runBlocks(0, blockCount);
+        }
+    }
+
+    static double sum(const std::vector<double>& values) {
+        double total = 0;
+        for (double value : values) {
+            total += value;
+        }
+        return total;
+    }
+
+public:
+    explicit PageRankAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~PageRankAlgorithm() override = default;
+
+    // nullptr - последовательный расчет
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    void setDamping(double damping) {
+        if (!(damping >= 0 && damping < 1)) {
+            throw std::invalid_argument("Damping factor must be in [0, 1).");
+        }
+        damping_ = damping;
+    }
+
+    // Итерации останавливаются, когда L1-норма изменения рангов меньше tolerance
+    void setTolerance(double tolerance) {
+        if (!(tolerance > 0)) {
+            throw std::invalid_argument("Tolerance must be positive.");
+        }
+        tolerance_ = tolerance;
+    }
+
+    void setMaxIterations(int maxIterations) {
+        if (maxIterations <= 0) {
+            throw std::invalid_argument("Iteration limit must be positive.");
+        }
+        maxIterations_ = maxIterations;
+    }
+
+    // teleport - неотрицательные веса телепортации по вершинам (нормируются), пустой - равномерный PageRank
+    PageRankResult run(const Snapshot& graph, std::span<const double> teleport = {}) const {
+        size_t n = static_cast<size_t>(graph.getVertexCount());
+        PageRankResult result;
+        if (n == 0) {
+            result.converged = true;
+            return result;
+        }
+
+        std::vector<double> jump(n, 1.0 / n);
+        if (!teleport.empty()) {
+            if (teleport.size() != n) {
+                throw std::invalid_argument("Teleport vector size must match the vertex count.");
+            }
+            double total = 0;
+            for (double weight : teleport) {
+                if (!(weight >= 0) || std::isinf(weight)) {
+                    throw std::invalid_argument("Teleport weights must be finite and non-negative.");
+                }
+                total += weight;
+            }
+            if (!(total > 0)) {
+                throw std::invalid_argument("Teleport vector must have a positive weight.");
+            }
+            for (size_t v = 0; v < n; ++v) {
+                jump[v] = teleport[v] / total;
+            }
+        }
+
+        // 1 / степень и признак висячей вершины - плоские массивы, чтобы циклы по строкам векторизовались
+        const std::vector<size_t>& outOffsets = graph.getOutOffsets();
+        std::vector<double> inverseDegree(n);
+        std::vector<double> dangling(n);
+        for (size_t v = 0; v < n; ++v) {
+            size_t degree = outOffsets[v + 1] - outOffsets[v];
+            inverseDegree[v] = degree ? 1.0 / degree : 0.0;
+            dangling[v] = degree ? 0.0 : 1.0;
+        }
+
+        const size_t* inOffsets = graph.getInOffsets().data();
+        const int* inSources = graph.getInSources().data();
+        std::vector<double> rank(jump);
+        std::vector<double> next(n);
+        std::vector<double> contribution(n);
+        size_t blockCount = (n + kRowBlock - 1) / kRowBlock;
+        std::vector<double> partial(blockCount);
+
+        while (result.iterations < maxIterations_) {
+            forBlocks(n, [&](size_t block, size_t lo, size_t hi) {
+                double danglingMass = 0;
+                for (size_t v = lo; v < hi; ++v) {
+                    contribution[v] = rank[v] * inverseDegree[v];
+                    danglingMass += rank[v] * dangling[v];
+                }
+                partial[block] = danglingMass;
+            });
+            double danglingMass = sum(partial);
+
+            double base = 1.0 - damping_ + damping_ * danglingMass;
+            forBlocks(n, [&](size_t block, size_t lo, size_t hi) {
+                double change = 0;
+                for (size_t v = lo; v < hi; ++v) {
+                    double incoming = 0;
+                    for (size_t i = inOffsets[v]; i < inOffsets[v + 1]; ++i) {
+                        incoming += contribution[inSources[i]];
+                    }
+                    next[v] = base * jump[v] + damping_ * incoming;
+                    change += std::abs(next[v] - rank[v]);
+                }
+                partial[block] = change;
+            });
+
+            rank.swap(next);
+            ++result.iterations;
+            result.residual = sum(partial);
+            if (result.residual < tolerance_) {
+                result.converged = true;
+                break;
+            }
+        }
+
+        result.ranks = std::move(rank);
+        return result;
+    }
+
+    // Персонализированный PageRank: телепортация равномерно на вершины-семена
+    PageRankResult runPersonalized(const Snapshot& graph, std::span<const int> seeds) const {
+        if (seeds.empty()) {
+            throw std::invalid_argument("Seed set is empty.");
+        }
+        std::vector<double> teleport(graph.getVertexCount(), 0.0);
+        for (int seed : seeds) {
+            if (seed < 0 || seed >= graph.getVertexCount()) {
+                throw std::invalid_argument("Seed vertex does not exist in the graph.");
+            }
+            teleport[seed] += 1.0;
+        }
+        return run(graph, teleport);
+    }
+
+    // Без стартовой вершины - обычный PageRank, со стартовой - персонализированный относительно нее
+    SharedPtr<PageRankResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (startVertex && !graph->hasVertex(startVertex)) {
+            throw std::invalid_argument("Start vertex does not exist in the graph.");
+        }
+
+        Snapshot snapshot = Snapshot::fromGraph(graph);
+        if (!startVertex) {
+            return MakeShared<PageRankResult>(run(snapshot));
+        }
+        int seed = snapshot.getIndex(startVertex->getId());
+        return MakeShared<PageRankResult>(runPersonalized(snapshot, std::span<const int>(&seed, 1)));
+    }
+};
+
+#endif // PAGERANKALGORITHM_H
@@ -0,0 +1,278 @@
+#ifndef REACHABILITYINDEX_H
+#define REACHABILITYINDEX_H
+
+#include "CompressedGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Индекс достижимости "может ли u дойти до v" по снимку CompressedGraph (индексы - плотные индексы снимка).
+// Граф сжимается в конденсацию по сильно связным компонентам (итеративный Тарьян, компоненты нумеруются
+// в обратном топологическом порядке: ребро между компонентами всегда идет от большего номера к меньшему).
+// На конденсации строятся метки GRAIL: несколько рандомизированных обходов в глубину, в каждом вершина
+// получает интервал [low, post], где post - номер в обратном порядке обхода, а low - минимум по потомкам.
+// Если u достигает v, интервал v вложен в интервал u во всех обходах, поэтому невложенность - точный
+// отрицательный ответ за O(d). Положительный ответ за O(1) дает дерево первого обхода (v в поддереве u).
+// Остальные запросы решаются поиском в глубину по конденсации, отсеченным теми же метками; поиск
+// останавливается, как только v попадает в поддерево дерева первого обхода у очередной компоненты.
+// Запросы не потокобезопасны: поиск использует общий буфер отметок.
+template <typename TWeight, typename TIdentifier>
+class ReachabilityIndex {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+    struct Statistics {
+        size_t queries = 0;
+        size_t labelAnswers = 0;  // ответов только по меткам
+        size_t searches = 0;      // запросов, дошедших до поиска в глубину
+        size_t searchVisits = 0;  // компонент, просмотренных поисками
+    };
+
+private:
+    struct Interval {
+        int low;
+        int post;
+    };
+
+    int labelings_ = 0;
+    std::vector<int> component_;        // вершина -> компонента
+    int componentCount_ = 0;
+    std::vector<size_t> dagOffsets_;    // конденсация в CSR, без повторных дуг
+    std::vector<int> dagTargets_;
+    std::vector<Interval> labels_;      // labels_[c * labelings_ + i] - интервал компоненты c в обходе i
+    std::vector<int> treeLow_;          // наименьший post в поддереве компоненты в дереве первого обхода
+    double buildSeconds_ = 0;
+
+    mutable std::vector<uint32_t> marks_;
+    mutable uint32_t stamp_ = 0;
+    mutable std::vector<int> stack_;
+    mutable Statistics statistics_;
+
+    void findComponents(const Snapshot& graph) {
+        int n = graph.getVertexCount();
+        component_.assign(n, -1);
+        std::vector<int> order(n, -1);
+        std::vector<int> low(n, 0);
+        std::vector<size_t> next(n, 0);
+        std::vector<int> stack;
+        std::vector<int> path;
+        int counter = 0;
+
+        for (int root = 0; root < n; ++root) {
+            if (order[root] != -1) continue;
+            order[root] = low[root] = counter++;
+            stack.push_back(root);
+            path.push_back(root);
+            while (!path.empty()) {
+                int u = path.back();
+                auto neighbors = graph.getOutNeighbors(u);
+                if (next[u] < neighbors.size()) {
+                    int w = neighbors[next[u]++];
+                    if (order[w] == -1) {
+                        order[w] = low[w] = counter++;
+                        stack.push_back(w);
+                        path.push_back(w);
+                    } else if (component_[w] == -1) {
+                        low[u] = std::min(low[u], order[w]);
+                    }
+                    continue;
+                }
+                path.pop_back();
+                if (!path.empty()) {
+                    low[path.back()] = std::min(low[path.back()], low[u]);
+                }
+                if (low[u] == order[u]) {
+                    int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        component_[w] = componentCount_;
+                    } while (w != u);
+                    ++componentCount_;
+                }
+            }
+        }
+    }
+
+    void buildCondensation(const Snapshot& graph) {
+        std::vector<std::vector<int>> successors(componentCount_);
+        for (int u = 0; u < graph.getVertexCount(); ++u) {
+            for (int w : graph.getOutNeighbors(u)) {
+                if (component_[u] != component_[w]) {
+                    successors[component_[u]].push_back(component_[w]);
+                }
+            }
+        }
+        dagOffsets_.assign(componentCount_ + 1, 0);
+        for (int c = 0; c < componentCount_; ++c) {
+            auto& list = successors[c];
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+            dagOffsets_[c + 1] = dagOffsets_[c] + list.size();
+        }
+        dagTargets_.reserve(dagOffsets_[componentCount_]);
+        for (const auto& list : successors) {
+            dagTargets_.insert(dagTargets_.end(), list.begin(), list.end());
+        }
+    }
+
+    // Обход i: корни в случайном порядке, дети каждой компоненты - с случайного сдвига по кругу
+    void label(int labeling, std::mt19937& generator) {
+        int c = componentCount_;
+        std::vector<int> roots(c);
+        for (int v = 0; v < c; ++v) {
+            roots[v] = v;
+        }
+        std::shuffle(roots.begin(), roots.end(), generator);
+
+        std::vector<char> visited(c, 0);
+        std::vector<size_t> start(c, 0);
+        std::vector<size_t> step(c, 0);
+        std::vector<int> path;
+        std::vector<int> subtreeSize(labeling == 0 ? c : 0, 1);
+        int counter = 0;
+        for (int root : roots) {
+            if (visited[root]) continue;
+            visited[root] = 1;
+            path.push_back(root);
+            while (!path.empty()) {
+                int u = path.back();
+                size_t degree = dagOffsets_[u + 1] - dagOffsets_[u];
+                if (step[u] == 0 && degree > 0) {
+                    start[u] = generator() % degree;
+                }
+                if (step[u] < degree) {
+                    int w = dagTargets_[dagOffsets_[u] + (start[u] + step[u]++) % degree];
+                    if (!visited[w]) {
+                        visited[w] = 1;
+                        path.push_back(w);
+                    }
+                    continue;
+                }
+                path.pop_back();
+
+                // Все потомки уже пронумерованы: low - минимум по своему номеру и low детей
+                Interval& interval = labels_[static_cast<size_t>(u) * labelings_ + labeling];
+                interval.post = counter++;
+                interval.low = interval.post;
+                for (size_t i = dagOffsets_[u]; i < dagOffsets_[u + 1]; ++i) {
+                    interval.low = std::min(interval.low, labels_[static_cast<size_t>(dagTargets_[i]) * labelings_ + labeling].low);
+                }
+                if (labeling == 0) {
+                    treeLow_[u] = interval.post - subtreeSize[u] + 1;
+                    if (!path.empty()) {
+                        subtreeSize[path.back()] += subtreeSize[u];
+                    }
+                }
+            }
+        }
+    }
+
+    // Интервал to вложен в интервал from во всех обходах
+    bool mayReach(int from, int to) const {
+        const Interval* outer = &labels_[static_cast<size_t>(from) * labelings_];
+        const Interval* inner = &labels_[static_cast<size_t>(to) * labelings_];
+        for (int i = 0; i < labelings_; ++i) {
+            if (inner[i].low < outer[i].low || inner[i].post > outer[i].post) return false;
+        }
+        return true;
+    }
+
+    // to лежит в поддереве from в дереве первого обхода
+    bool inTree(int from, int to) const {
+        int post = labels_[static_cast<size_t>(to) * labelings_].post;
+        return treeLow_[from] <= post && post <= labels_[static_cast<size_t>(from) * labelings_].post;
+    }
+
+    bool search(int from, int to) const {
+        if (++stamp_ == 0) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            stamp_ = 1;
+        }
+        ++statistics_.searches;
+        stack_.assign(1, from);
+        marks_[from] = stamp_;
+        while (!stack_.empty()) {
+            int u = stack_.back();
+            stack_.pop_back();
+            ++statistics_.searchVisits;
+            for (size_t i = dagOffsets_[u]; i < dagOffsets_[u + 1]; ++i) {
+                int w = dagTargets_[i];
+                if (w == to) return true;
+                // Номера компонент убывают вдоль дуг, поэтому компоненты с номером меньше to бесполезны
+                if (marks_[w] == stamp_ || w < to || !mayReach(w, to)) continue;
+                if (inTree(w, to)) return true;
+                marks_[w] = stamp_;
+                stack_.push_back(w);
+            }
+        }
+        return false;
+    }
+
+public:
+    // labelings - число рандомизированных обходов (больше - точнее отсечение, но больше индекс)
+    explicit ReachabilityIndex(const Snapshot& graph, int labelings = 3, uint32_t seed = 1) {
+        if (labelings < 1) {
+            throw std::invalid_argument("Reachability index requires at least one labeling.");
+        }
+        auto begin = std::chrono::steady_clock::now();
+        labelings_ = labelings;
+        findComponents(graph);
+        buildCondensation(graph);
+
+        labels_.resize(static_cast<size_t>(componentCount_) * labelings_);
+        treeLow_.resize(componentCount_);
+        std::mt19937 generator(seed);
+        for (int i = 0; i < labelings_; ++i) {
+            label(i, generator);
+        }
+        marks_.assign(componentCount_, 0);
+        buildSeconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    bool reaches(int from, int to) const {
+        int n = static_cast<int>(component_.size());
+        if (from < 0 || from >= n || to < 0 || to >= n) {
+            throw std::invalid_argument("Vertex does not exist in the graph.");
+        }
+        ++statistics_.queries;
+        int cu = component_[from];
+        int cv = component_[to];
+        if (cu == cv) {
+            ++statistics_.labelAnswers;
+            return true;
+        }
+        if (cu < cv || !mayReach(cu, cv)) {
+            ++statistics_.labelAnswers;
+            return false;
+        }
+        if (inTree(cu, cv)) {
+            ++statistics_.labelAnswers;
+            return true;
+        }
+        return search(cu, cv);
+    }
+
+    int getComponent(int vertex) const { return component_.at(vertex); }
+    int getComponentCount() const { return componentCount_; }
+    size_t getCondensationArcCount() const { return dagTargets_.size(); }
+    int getLabelingCount() const { return labelings_; }
+
+    // Память индекса в байтах: отображение в компоненты, конденсация, метки и буфер поиска
+    size_t getIndexSize() const {
+        return component_.size() * sizeof(int) + dagOffsets_.size() * sizeof(size_t) +
+               dagTargets_.size() * sizeof(int) + labels_.size() * sizeof(Interval) +
+               treeLow_.size() * sizeof(int) + marks_.size() * sizeof(uint32_t);
+    }
+
+    double getBuildSeconds() const { return buildSeconds_; }
+
+    const Statistics& getStatistics() const { return statistics_; }
+    void resetStatistics() { statistics_ = Statistics{}; }
+};
+
+#endif // REACHABILITYINDEX_H
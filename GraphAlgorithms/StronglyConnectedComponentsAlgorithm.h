@@ -55,8 +55,7 @@ private:
     }
 
     IGraph<TWeight, TIdentifier>* getTransposedGraph(const IGraph<TWeight, TIdentifier>* graph) const {
-        const auto* directedGraph = dynamic_cast<const DirectedGraph<TWeight, TIdentifier>*>(graph);
-        if (!directedGraph) {
+        if (!graph->isDirected()) {
             throw std::runtime_error("Cannot transpose non-directed graph");
         }
 
@@ -65,7 +64,7 @@ private:
 
         for (size_t i = 0; i < vertices.getLength(); ++i) {
             IVertex<TWeight, TIdentifier>* originalVertex = vertices.get(i);
-            transposedGraph->addVertex(new Vertex<TWeight, TIdentifier>(originalVertex->getId()));
+            transposedGraph->createVertex(originalVertex->getId());
         }
 
         for (size_t i = 0; i < vertices.getLength(); ++i) {
@@ -116,8 +115,7 @@ public:
         IVertex<TWeight, TIdentifier>* startVertex = nullptr,
         IVertex<TWeight, TIdentifier>* endVertex = nullptr
     ) const override {
-        const auto* directedGraph = dynamic_cast<const DirectedGraph<TWeight, TIdentifier>*>(graph);
-        if (!directedGraph) {
+        if (!graph->isDirected()) {
             throw std::runtime_error("Strongly connected components algorithm can be applied to directed graphs only");
         }
 
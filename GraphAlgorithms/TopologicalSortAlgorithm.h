@@ -42,8 +42,7 @@ private:
 
 
     bool hasCycle(const IGraph<TWeight, TIdentifier>* graph) const {
-        const DirectedGraph<TWeight, TIdentifier>* directedGraph = dynamic_cast<const DirectedGraph<TWeight, TIdentifier>*>(graph);
-        if (!directedGraph) {
+        if (!graph->isDirected()) {
             return false;
         }
 
@@ -76,8 +75,7 @@ public:
         IVertex<TWeight, TIdentifier>* endVertex = nullptr
     ) const override {
 
-        const DirectedGraph<TWeight, TIdentifier>* directedGraph = dynamic_cast<const DirectedGraph<TWeight, TIdentifier>*>(graph);
-        if (!directedGraph) {
+        if (!graph->isDirected()) {
             throw std::runtime_error("Topological sort can be applied to directed graphs only");
         }
 
@@ -0,0 +1,233 @@
+#ifndef TRIANGLECOUNTINGALGORITHM_H
+#define TRIANGLECOUNTINGALGORITHM_H
+
+#include "IAlgorithm.h"
+#include "IGraph.h"
+#include "CompressedGraph.h"
+#include "IVertex.h"
+#include "SharedPtr.h"
+#include "SortedAdjacency.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Треугольники и локальный коэффициент кластеризации. Индексы - плотные индексы снимка
+// CompressedGraph (для execute это порядок graph->getVertices()).
+struct TriangleCountResult {
+    std::vector<long long> triangles;  // число треугольников, содержащих вершину
+    std::vector<double> clustering;    // 2 * t / (d * (d - 1)), 0 при степени меньше 2
+    long long totalTriangles = 0;
+    double averageClustering = 0;      // среднее по всем вершинам, включая вершины степени меньше 2
+};
+
+// Подсчет треугольников неориентированного графа через пересечение отсортированных списков соседей.
+// Каждое ребро ориентируется от вершины меньшего ранга (степень, затем индекс) к большей, поэтому
+// у любой вершины не больше O(sqrt(E)) исходящих соседей и каждый треугольник находится ровно один раз.
+// Пересечение - слиянием для списков сравнимой длины и галопирующим поиском, когда один список
+// намного длиннее. Кратные ребра и петли не учитываются.
+template <typename TWeight, typename TIdentifier>
+class TriangleCountingAlgorithm : public IAlgorithm<TWeight, TriangleCountResult, TIdentifier> {
+public:
+    using Snapshot = CompressedGraph<TWeight, TIdentifier>;
+
+    // Отсортированные соседи простого графа и их часть, ориентированная по рангу (только соседи большего ранга)
+    class NeighborView {
+    private:
+        SortedAdjacency<TWeight, TIdentifier> adjacency_;
+        std::vector<size_t> orientedOffsets_;
+        std::vector<int> oriented_;
+
+    public:
+        NeighborView(const Snapshot& graph, ThreadPool* pool) : adjacency_(graph, pool) {
+            int n = adjacency_.getVertexCount();
+            auto forVertices = [&](const std::function<void(size_t, size_t)>& body) {
+                if (pool) {
+                    pool->parallelFor(0, n, body, 256);
+                } else {
+                    body(0, n);
+                }
+            };
+
+            std::vector<size_t> orientedDegree(n);
+            forVertices([&](size_t lo, size_t hi) {
+                for (size_t v = lo; v < hi; ++v) {
+                    size_t count = 0;
+                    for (int u : getNeighbors(static_cast<int>(v))) {
+                        count += precedes(static_cast<int>(v), u) ? 1 : 0;
+                    }
+                    orientedDegree[v] = count;
+                }
+            });
+            orientedOffsets_.assign(n + 1, 0);
+            for (int v = 0; v < n; ++v) {
+                orientedOffsets_[v + 1] = orientedOffsets_[v] + orientedDegree[v];
+            }
+            oriented_.resize(orientedOffsets_[n]);
+            forVertices([&](size_t lo, size_t hi) {
+                for (size_t v = lo; v < hi; ++v) {
+                    size_t position = orientedOffsets_[v];
+                    for (int u : getNeighbors(static_cast<int>(v))) {
+                        if (precedes(static_cast<int>(v), u)) {
+                            oriented_[position++] = u;
+                        }
+                    }
+                }
+            });
+        }
+
+        int getVertexCount() const { return adjacency_.getVertexCount(); }
+
+        size_t getDegree(int vertex) const { return adjacency_.getDegree(vertex); }
+
+        // Ранг вершины: степень, при равенстве - индекс
+        bool precedes(int a, int b) const {
+            size_t degreeA = getDegree(a);
+            size_t degreeB = getDegree(b);
+            return degreeA < degreeB || (degreeA == degreeB && a < b);
+        }
+
+        std::span<const int> getNeighbors(int vertex) const {
+            return adjacency_.getNeighbors(vertex);
+        }
+
+        std::span<const int> getOrientedNeighbors(int vertex) const {
+            return {oriented_.data() + orientedOffsets_[vertex], orientedOffsets_[vertex + 1] - orientedOffsets_[vertex]};
+        }
+    };
+
+private:
+    // Во сколько раз один список должен быть длиннее другого, чтобы галоп выигрывал у слияния
+    static constexpr size_t kGallopRatio = 16;
+
+    ThreadPool* pool_ = nullptr;
+
+    // Первая позиция в sorted[from..) со значением не меньше value: экспоненциальный шаг, затем бинарный поиск
+    static size_t gallop(std::span<const int> sorted, size_t from, int value) {
+        size_t step = 1;
+        size_t hi = from;
+        while (hi < sorted.size() && sorted[hi] < value) {
+            from = hi + 1;
+            hi += step;
+            step *= 2;
+        }
+        hi = std::min(hi, sorted.size());
+        return std::lower_bound(sorted.begin() + from, sorted.begin() + hi, value) - sorted.begin();
+    }
+
+    template <typename OnCommon>
+    static void intersect(std::span<const int> a, std::span<const int> b, OnCommon onCommon) {
+        if (a.size() > b.size()) {
+            std::swap(a, b);
+        }
+        if (a.empty()) return;
+
+        if (b.size() >= a.size() * kGallopRatio) {
+            size_t position = 0;
+            for (int value : a) {
+                position = gallop(b, position, value);
+                if (position == b.size()) return;
+                if (b[position] == value) {
+                    onCommon(value);
+                }
+            }
+            return;
+        }
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i] < b[j]) {
+                ++i;
+            } else if (b[j] < a[i]) {
+                ++j;
+            } else {
+                onCommon(a[i]);
+                ++i;
+                ++j;
+            }
+        }
+    }
+
+public:
+    explicit TriangleCountingAlgorithm(ThreadPool* pool = nullptr) : pool_(pool) {}
+    ~TriangleCountingAlgorithm() override = default;
+
+    // nullptr - последовательный подсчет
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    TriangleCountResult run(const Snapshot& graph) const {
+        if (graph.isDirected()) {
+            throw std::invalid_argument("Triangle counting requires an undirected graph.");
+        }
+        NeighborView view(graph, pool_);
+        int n = view.getVertexCount();
+
+        TriangleCountResult result;
+        result.triangles.assign(n, 0);
+        result.clustering.assign(n, 0.0);
+
+        // Треугольник v < u < w (по рангу) находится один раз при обходе ребра v -> u
+        auto countTriangles = [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) {
+                auto vNeighbors = view.getOrientedNeighbors(static_cast<int>(v));
+                long long local = 0;
+                for (int u : vNeighbors) {
+                    long long shared = 0;
+                    intersect(vNeighbors, view.getOrientedNeighbors(u), [&](int w) {
+                        std::atomic_ref<long long>(result.triangles[w]).fetch_add(1, std::memory_order_relaxed);
+                        ++shared;
+                    });
+                    if (shared) {
+                        std::atomic_ref<long long>(result.triangles[u]).fetch_add(shared, std::memory_order_relaxed);
+                        local += shared;
+                    }
+                }
+                if (local) {
+                    std::atomic_ref<long long>(result.triangles[v]).fetch_add(local, std::memory_order_relaxed);
+                }
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, n, countTriangles, 64);
+        } else {
+            countTriangles(0, n);
+        }
+
+        long long cornerCount = 0;
+        double clusteringSum = 0;
+        for (int v = 0; v < n; ++v) {
+            double degree = static_cast<double>(view.getDegree(v));
+            if (degree >= 2) {
+                result.clustering[v] = 2.0 * result.triangles[v] / (degree * (degree - 1));
+            }
+            cornerCount += result.triangles[v];
+            clusteringSum += result.clustering[v];
+        }
+        result.totalTriangles = cornerCount / 3;
+        result.averageClustering = n ? clusteringSum / n : 0.0;
+        return result;
+    }
+
+    SharedPtr<TriangleCountResult> execute(
+        const IGraph<TWeight, TIdentifier>* graph,
+        IVertex<TWeight, TIdentifier>* startVertex = nullptr,
+        IVertex<TWeight, TIdentifier>* endVertex = nullptr
+    ) const override {
+        if (!graph) {
+            throw std::invalid_argument("Graph is not specified.");
+        }
+        if (graph->isDirected()) {
+            throw std::invalid_argument("Triangle counting requires an undirected graph.");
+        }
+        return MakeShared<TriangleCountResult>(run(Snapshot::fromGraph(graph)));
+    }
+};
+
+#endif // TRIANGLECOUNTINGALGORITHM_H
@@ -0,0 +1,82 @@
+#ifndef BARABASIALBERTGRAPHGENERATOR_H
+#define BARABASIALBERTGRAPHGENERATOR_H
+
+#include "IGraphGenerator.h"
+#include "CounterRandom.h"
+#include "WeightDistribution.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Неориентированный граф Барабаши-Альберт: каждая новая вершина присоединяется к edgesPerVertex различным
+// уже существующим вершинам с вероятностью, пропорциональной их степени. Первые edgesPerVertex + 1 вершин
+// образуют клику. Выбор по степени - равномерный выбор из массива концов всех ребер (метод Батагеля-Брандеса),
+// поэтому генерация идет за O(n * edgesPerVertex) без пересчета распределения.
+template <typename Weight, typename TIdentifier>
+class BarabasiAlbertGraphGenerator : public IGraphGenerator<Weight, TIdentifier> {
+private:
+    size_t numVertices_;
+    size_t edgesPerVertex_;
+    uint64_t seed_;
+    WeightDistribution<Weight> weights_ = WeightDistribution<Weight>::uniform(1, 10);
+
+public:
+    BarabasiAlbertGraphGenerator(size_t numVertices, size_t edgesPerVertex, uint64_t seed)
+        : numVertices_(numVertices), edgesPerVertex_(edgesPerVertex), seed_(seed) {
+        if (edgesPerVertex_ == 0 || numVertices_ <= edgesPerVertex_) {
+            throw std::invalid_argument("Number of vertices must exceed the number of edges per vertex.");
+        }
+    }
+
+    void setWeightDistribution(const WeightDistribution<Weight>& weights) {
+        weights_ = weights;
+    }
+
+    bool isDirected() const override {
+        return false;
+    }
+
+    void generateInto(GraphBuilder<Weight, TIdentifier>& builder) override {
+        size_t m = edgesPerVertex_;
+        for (size_t i = 0; i < numVertices_; ++i) {
+            builder.addVertex(static_cast<TIdentifier>(i));
+        }
+        builder.reserveEdges(builder.getEdgeCount() + m * (m + 1) / 2 + (numVertices_ - m - 1) * m);
+
+        CounterRandom random(seed_, 0);
+        std::vector<size_t> endpoints; // каждая вершина встречается столько раз, какова ее степень
+        endpoints.reserve(2 * m * numVertices_);
+        for (size_t u = 0; u <= m; ++u) {
+            for (size_t v = 0; v < u; ++v) {
+                builder.addEdge(static_cast<TIdentifier>(u), static_cast<TIdentifier>(v), weights_.sample(random));
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+
+        std::vector<size_t> chosen;
+        for (size_t u = m + 1; u < numVertices_; ++u) {
+            // Концы ребер u добавляются после выбора, поэтому петель нет; повторный выбор соседа отбрасывается
+            size_t existing = endpoints.size();
+            chosen.clear();
+            while (chosen.size() < m) {
+                size_t v = endpoints[random.nextBelow(existing)];
+                bool repeated = false;
+                for (size_t w : chosen) {
+                    repeated = repeated || w == v;
+                }
+                if (!repeated) {
+                    chosen.push_back(v);
+                }
+            }
+            for (size_t v : chosen) {
+                builder.addEdge(static_cast<TIdentifier>(u), static_cast<TIdentifier>(v), weights_.sample(random));
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        }
+    }
+};
+
+#endif // BARABASIALBERTGRAPHGENERATOR_H
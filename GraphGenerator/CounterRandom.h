@@ -0,0 +1,43 @@
+#ifndef COUNTERRANDOM_H
+#define COUNTERRANDOM_H
+
+#include <cstdint>
+
+// Счетчиковый генератор случайных чисел: i-е число потока - хеш от (seed, stream, i).
+// Потоки с разными номерами независимы и не требуют общего состояния, поэтому блоки работы
+// можно генерировать параллельно и в любом порядке, а результат зависит только от seed.
+class CounterRandom {
+private:
+    uint64_t key_;
+    uint64_t counter_ = 0;
+
+    // Финализатор SplitMix64
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+public:
+    CounterRandom(uint64_t seed, uint64_t stream)
+        : key_(mix(seed + 0x9E3779B97F4A7C15ull * (mix(stream) | 1))) {}
+
+    uint64_t next() {
+        return mix(key_ + 0x9E3779B97F4A7C15ull * ++counter_);
+    }
+
+    // Равномерно в [0, 1)
+    double nextDouble() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    // Равномерно в [0, bound); смещение остатка пренебрежимо для небольших bound
+    uint64_t nextBelow(uint64_t bound) {
+        return next() % bound;
+    }
+};
+
+#endif // COUNTERRANDOM_H
@@ -2,53 +2,81 @@
 #define DIRECTEDGRAPHGENERATOR_H
 
 #include "IGraphGenerator.h"
-#include "DirectedGraph.h"
+#include "ErdosRenyiSampler.h"
+#include "IStreamingGraphGenerator.h"
+#include "ThreadPool.h"
+#include "WeightDistribution.h"
+#include <cstdint>
+#include <optional>
 #include <random>
+#include <stdexcept>
 
+// Случайный ориентированный граф G(n, p) без петель. Без явного seed генератор берет его из random_device;
+// getSeed позволяет повторить такую генерацию.
 template <typename Weight, typename TIdentifier>
-class DirectedGraphGenerator : public IGraphGenerator<Weight, TIdentifier> {
+class DirectedGraphGenerator : public IGraphGenerator<Weight, TIdentifier>, public IStreamingGraphGenerator<Weight> {
 private:
     size_t numVertices_;
     double edgeProbability_;
-    std::mt19937 gen_;
-    std::uniform_real_distribution<> dist_;
+    uint64_t seed_;
+    WeightDistribution<Weight> weights_ = WeightDistribution<Weight>::uniform(1, 10);
+    ThreadPool* pool_ = nullptr;
+    std::optional<ErdosRenyiSampler<Weight>> stream_;
 
 public:
-    DirectedGraphGenerator(size_t numVertices, double edgeProbability)
-      : numVertices_(numVertices), edgeProbability_(edgeProbability),
-        gen_(std::random_device{}()), dist_(0.0, 1.0)
+    DirectedGraphGenerator(size_t numVertices, double edgeProbability, uint64_t seed)
+      : numVertices_(numVertices), edgeProbability_(edgeProbability), seed_(seed)
     {
         if (numVertices_ == 0) {
             throw std::invalid_argument("Number of vertices must be greater than 0.");
         }
-        if (edgeProbability_ < 0.0 || edgeProbability_ > 1.0)
-        {
+        if (edgeProbability_ < 0.0 || edgeProbability_ > 1.0) {
             throw std::invalid_argument("Probability must be within 0 and 1 inclusive");
         }
     }
 
-    IGraph<Weight, TIdentifier>* generate() override {
-        auto graph = new DirectedGraph<Weight, TIdentifier>();
+    DirectedGraphGenerator(size_t numVertices, double edgeProbability)
+      : DirectedGraphGenerator(numVertices, edgeProbability, (uint64_t(std::random_device{}()) << 32) | std::random_device{}()) {}
 
-        for (size_t i = 0; i < numVertices_; ++i) {
-            graph->addVertex(new Vertex<Weight, TIdentifier>(static_cast<TIdentifier>(i)));
-        }
+    uint64_t getSeed() const {
+        return seed_;
+    }
 
-        auto vertices = graph->getVertices();
-        for (size_t i = 0; i < vertices.getLength(); ++i) {
-            for (size_t j = 0; j < vertices.getLength(); ++j) {
-                if (i != j) {
-                    if (dist_(gen_) < edgeProbability_) {
-                        std::uniform_int_distribution<Weight> weightDist(1, 10);
-                        Weight weight = weightDist(gen_);
-                        graph->addEdge(vertices.get(i), vertices.get(j), weight);
-                    }
-                }
-            }
-        }
+    void setWeightDistribution(const WeightDistribution<Weight>& weights) {
+        weights_ = weights;
+    }
+
+    // С пулом пары перебираются параллельно; граф от этого не меняется
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    size_t getVertexCount() const override {
+        return numVertices_;
+    }
+
+    bool isDirected() const override {
+        return true;
+    }
+
+    // Время пропорционально числу ребер, а не числу пар вершин
+    void generateInto(GraphBuilder<Weight, TIdentifier>& builder) override {
+        ErdosRenyiSampler<Weight> sampler(numVertices_, edgeProbability_, true, seed_, weights_);
+        this->emitChunks(builder, numVertices_, sampler.sample(pool_));
+    }
+
+protected:
+    void beginStreaming() override {
+        stream_.emplace(numVertices_, edgeProbability_, true, seed_, weights_);
+    }
+
+    size_t getShardCount() const override {
+        return stream_->getChunkCount();
+    }
 
-        return graph;
+    void generateShard(size_t shard, EdgeBuffer<Weight>& buffer) const override {
+        stream_->forEachEdge(shard, [&](size_t from, size_t to, Weight weight) { buffer.push(from, to, weight); });
     }
 };
 
-#endif // DIRECTEDGRAPHGENERATOR_H
\ No newline at end of file
+#endif // DIRECTEDGRAPHGENERATOR_H
@@ -0,0 +1,183 @@
+#ifndef EDGEFILESINKS_H
+#define EDGEFILESINKS_H
+
+#include "EdgeSink.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Текстовый список ребер: строка "from to weight" на ребро. Строки собираются в буфере через to_chars
+// и пишутся одним вызовом на порцию.
+template <typename Weight>
+class TextEdgeListSink : public IEdgeSink<Weight> {
+private:
+    std::ofstream out_;
+    std::string path_;
+    std::vector<char> text_;
+
+public:
+    explicit TextEdgeListSink(const std::string& path) : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+        if (!out_) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+    }
+
+    void write(std::span<const GeneratedEdge<Weight>> edges) override {
+        // 20 цифр на число без знака; запас на знак, дробную часть и разделители
+        text_.resize(edges.size() * 96);
+        char* cursor = text_.data();
+        for (const auto& edge : edges) {
+            cursor = std::to_chars(cursor, cursor + 24, edge.from).ptr;
+            *cursor++ = ' ';
+            cursor = std::to_chars(cursor, cursor + 24, edge.to).ptr;
+            *cursor++ = ' ';
+            cursor = std::to_chars(cursor, cursor + 40, edge.weight).ptr;
+            *cursor++ = '\n';
+        }
+        out_.write(text_.data(), cursor - text_.data());
+        if (!out_) {
+            throw std::runtime_error("Failed to write edge list: " + path_);
+        }
+    }
+
+    void close() override {
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("Failed to write edge list: " + path_);
+        }
+    }
+};
+
+// Двоичный список ребер: сигнатура "EDGE", версия, код типа и размер веса, затем записи
+// (uint64 from, uint64 to, вес) без выравнивания. Порядок байтов - порядок байтов машины.
+// Число ребер не хранится, поэтому файл можно склеить из частей, но заголовок должен быть один:
+// первая часть пишется с заголовком, остальные - с withHeader = false. Части, записанные каждая
+// со своим заголовком, читаются только по отдельности.
+template <typename Weight>
+class BinaryEdgeFormat {
+public:
+    static constexpr char kMagic[4] = {'E', 'D', 'G', 'E'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kHeaderSize = sizeof(kMagic) + 3 * sizeof(uint32_t);
+    static constexpr size_t kRecordSize = 2 * sizeof(uint64_t) + sizeof(Weight);
+
+    // Код типа веса: 1 - целое со знаком, 2 - беззнаковое, 3 - с плавающей точкой
+    static constexpr uint32_t typeCode() {
+        if constexpr (std::is_floating_point_v<Weight>) {
+            return 3;
+        } else if constexpr (std::is_signed_v<Weight>) {
+            return 1;
+        } else {
+            return 2;
+        }
+    }
+};
+
+template <typename Weight>
+class BinaryEdgeSink : public IEdgeSink<Weight> {
+private:
+    using Format = BinaryEdgeFormat<Weight>;
+
+    std::ofstream out_;
+    std::string path_;
+    std::vector<char> bytes_;
+
+public:
+    // withHeader = false - часть файла без заголовка, для дописывания после другой части
+    explicit BinaryEdgeSink(const std::string& path, bool withHeader = true)
+        : out_(path, std::ios::binary | std::ios::trunc), path_(path) {
+        if (!out_) {
+            throw std::runtime_error("Cannot open file for writing: " + path);
+        }
+        if (withHeader) {
+            uint32_t header[3] = {Format::kVersion, Format::typeCode(), static_cast<uint32_t>(sizeof(Weight))};
+            out_.write(Format::kMagic, sizeof(Format::kMagic));
+            out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+        }
+    }
+
+    void write(std::span<const GeneratedEdge<Weight>> edges) override {
+        bytes_.resize(edges.size() * Format::kRecordSize);
+        char* cursor = bytes_.data();
+        for (const auto& edge : edges) {
+            uint64_t ends[2] = {edge.from, edge.to};
+            std::memcpy(cursor, ends, sizeof(ends));
+            std::memcpy(cursor + sizeof(ends), &edge.weight, sizeof(Weight));
+            cursor += Format::kRecordSize;
+        }
+        out_.write(bytes_.data(), bytes_.size());
+        if (!out_) {
+            throw std::runtime_error("Failed to write edge file: " + path_);
+        }
+    }
+
+    void close() override {
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("Failed to write edge file: " + path_);
+        }
+    }
+};
+
+// Чтение файла BinaryEdgeSink порциями по chunkEdges ребер
+template <typename Weight>
+class BinaryEdgeReader {
+private:
+    using Format = BinaryEdgeFormat<Weight>;
+
+    std::ifstream in_;
+    std::string path_;
+
+public:
+    explicit BinaryEdgeReader(const std::string& path) : in_(path, std::ios::binary), path_(path) {
+        if (!in_) {
+            throw std::runtime_error("Cannot open file for reading: " + path);
+        }
+        char magic[4];
+        uint32_t header[3];
+        in_.read(magic, sizeof(magic));
+        in_.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!in_ || std::memcmp(magic, Format::kMagic, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not an edge file: " + path);
+        }
+        if (header[0] != Format::kVersion || header[1] != Format::typeCode() || header[2] != sizeof(Weight)) {
+            throw std::runtime_error("Unsupported edge file format: " + path);
+        }
+    }
+
+    template <typename Visitor>
+    void forEachChunk(Visitor visit, size_t chunkEdges = size_t(1) << 16) {
+        std::vector<char> bytes(chunkEdges * Format::kRecordSize);
+        std::vector<GeneratedEdge<Weight>> edges;
+        edges.reserve(chunkEdges);
+        while (in_) {
+            in_.read(bytes.data(), bytes.size());
+            size_t count = static_cast<size_t>(in_.gcount());
+            if (count % Format::kRecordSize != 0) {
+                throw std::runtime_error("Edge file is truncated: " + path_);
+            }
+            edges.clear();
+            for (size_t offset = 0; offset < count; offset += Format::kRecordSize) {
+                uint64_t ends[2];
+                GeneratedEdge<Weight> edge{};
+                std::memcpy(ends, bytes.data() + offset, sizeof(ends));
+                std::memcpy(&edge.weight, bytes.data() + offset + sizeof(ends), sizeof(Weight));
+                edge.from = static_cast<size_t>(ends[0]);
+                edge.to = static_cast<size_t>(ends[1]);
+                edges.push_back(edge);
+            }
+            if (!edges.empty()) {
+                visit(std::span<const GeneratedEdge<Weight>>(edges));
+            }
+        }
+    }
+};
+
+#endif // EDGEFILESINKS_H
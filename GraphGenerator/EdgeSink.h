@@ -0,0 +1,79 @@
+#ifndef EDGESINK_H
+#define EDGESINK_H
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Ребро генератора: концы - номера вершин 0 .. n - 1
+template <typename Weight>
+struct GeneratedEdge {
+    size_t from;
+    size_t to;
+    Weight weight;
+
+    bool operator==(const GeneratedEdge&) const = default;
+};
+
+// Приемник потока ребер. Ребра приходят порциями не больше размера буфера EdgeBuffer,
+// close вызывается после последней порции.
+template <typename Weight>
+class IEdgeSink {
+public:
+    virtual ~IEdgeSink() = default;
+
+    virtual void write(std::span<const GeneratedEdge<Weight>> edges) = 0;
+
+    virtual void close() {}
+};
+
+// Буфер фиксированной емкости перед приемником: память не зависит от числа ребер
+template <typename Weight>
+class EdgeBuffer {
+private:
+    IEdgeSink<Weight>& sink_;
+    std::vector<GeneratedEdge<Weight>> edges_;
+    size_t capacity_;
+
+public:
+    EdgeBuffer(IEdgeSink<Weight>& sink, size_t capacity) : sink_(sink), capacity_(capacity) {
+        if (capacity_ == 0) {
+            throw std::invalid_argument("Edge buffer capacity must be greater than 0.");
+        }
+        edges_.reserve(capacity_);
+    }
+
+    void push(size_t from, size_t to, Weight weight) {
+        edges_.push_back({from, to, weight});
+        if (edges_.size() == capacity_) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (!edges_.empty()) {
+            sink_.write(edges_);
+            edges_.clear();
+        }
+    }
+};
+
+// Приемник-функция: например, подсчет степеней или запись в собственное хранилище
+template <typename Weight>
+class CallbackEdgeSink : public IEdgeSink<Weight> {
+private:
+    std::function<void(std::span<const GeneratedEdge<Weight>>)> callback_;
+
+public:
+    explicit CallbackEdgeSink(std::function<void(std::span<const GeneratedEdge<Weight>>)> callback)
+        : callback_(std::move(callback)) {}
+
+    void write(std::span<const GeneratedEdge<Weight>> edges) override {
+        callback_(edges);
+    }
+};
+
+#endif // EDGESINK_H
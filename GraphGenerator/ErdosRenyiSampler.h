@@ -0,0 +1,119 @@
+#ifndef ERDOSRENYISAMPLER_H
+#define ERDOSRENYISAMPLER_H
+
+#include "CounterRandom.h"
+#include "EdgeSink.h"
+#include "ThreadPool.h"
+#include "WeightDistribution.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Ребра графа G(n, p) за O(n + m) методом Батагеля-Брандеса: вместо броска монеты для каждой пары
+// генерируется длина пропуска до следующего ребра, floor(log(1 - r) / log(1 - p)), с геометрическим
+// распределением. Пространство пар (u, v) без петель разбито на блоки строк примерно по kChunkPairs пар,
+// у каждого блока свой поток CounterRandom, поэтому результат зависит только от seed, а не от числа потоков.
+// Для ориентированного графа строка u - пары (u, v), v != u; для неориентированного - пары (u, v), v < u.
+template <typename Weight>
+class ErdosRenyiSampler {
+public:
+    using Edge = GeneratedEdge<Weight>;
+
+private:
+    static constexpr uint64_t kChunkPairs = uint64_t(1) << 22;
+
+    size_t numVertices_;
+    double edgeProbability_;
+    bool directed_;
+    uint64_t seed_;
+    WeightDistribution<Weight> weights_;
+    std::vector<size_t> chunkRows_; // блок i - строки [chunkRows_[i], chunkRows_[i + 1])
+
+    uint64_t rowLength(size_t row) const {
+        return directed_ ? numVertices_ - 1 : row;
+    }
+
+public:
+    ErdosRenyiSampler(size_t numVertices, double edgeProbability, bool directed, uint64_t seed,
+                      const WeightDistribution<Weight>& weights = WeightDistribution<Weight>::uniform(1, 10))
+        : numVertices_(numVertices), edgeProbability_(edgeProbability), directed_(directed), seed_(seed),
+          weights_(weights) {
+        if (edgeProbability_ < 0.0 || edgeProbability_ > 1.0) {
+            throw std::invalid_argument("Edge probability must be between 0.0 and 1.0.");
+        }
+        chunkRows_.push_back(0);
+        uint64_t pairs = 0;
+        for (size_t row = 0; row < numVertices_; ++row) {
+            pairs += rowLength(row);
+            if (pairs >= kChunkPairs) {
+                chunkRows_.push_back(row + 1);
+                pairs = 0;
+            }
+        }
+        if (chunkRows_.back() != numVertices_) {
+            chunkRows_.push_back(numVertices_);
+        }
+    }
+
+    size_t getChunkCount() const {
+        return chunkRows_.size() - 1;
+    }
+
+    // Ребра блока chunk в порядке возрастания (from, to): visit(from, to, weight)
+    template <typename Visitor>
+    void forEachEdge(size_t chunk, Visitor visit) const {
+        if (edgeProbability_ <= 0.0) return;
+        size_t row = chunkRows_[chunk];
+        size_t lastRow = chunkRows_[chunk + 1];
+        uint64_t chunkPairs = 0;
+        for (size_t r = row; r < lastRow; ++r) {
+            chunkPairs += rowLength(r);
+        }
+
+        CounterRandom random(seed_, chunk);
+        double logMiss = std::log1p(-edgeProbability_);
+        uint64_t position = 0; // следующая пара блока
+        uint64_t rowBase = 0;  // номер первой пары строки row
+        while (true) {
+            if (edgeProbability_ < 1.0) {
+                double skip = std::floor(std::log1p(-random.nextDouble()) / logMiss);
+                if (skip >= static_cast<double>(chunkPairs - position)) break;
+                position += static_cast<uint64_t>(skip);
+            }
+            if (position >= chunkPairs) break;
+            while (position - rowBase >= rowLength(row)) {
+                rowBase += rowLength(row);
+                ++row;
+            }
+            size_t column = static_cast<size_t>(position - rowBase);
+            size_t to = directed_ && column >= row ? column + 1 : column;
+            visit(row, to, weights_.sample(random));
+            ++position;
+        }
+    }
+
+    // Ребра блока chunk дописываются в edges
+    void sampleChunk(size_t chunk, std::vector<Edge>& edges) const {
+        forEachEdge(chunk, [&](size_t from, size_t to, Weight weight) { edges.push_back({from, to, weight}); });
+    }
+
+    // Ребра по блокам; с пулом блоки генерируются параллельно, результат тот же
+    std::vector<std::vector<Edge>> sample(ThreadPool* pool = nullptr) const {
+        std::vector<std::vector<Edge>> chunks(getChunkCount());
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                sampleChunk(chunk, chunks[chunk]);
+            }
+        };
+        if (pool) {
+            pool->parallelFor(0, chunks.size(), body, 1);
+        } else {
+            body(0, chunks.size());
+        }
+        return chunks;
+    }
+};
+
+#endif // ERDOSRENYISAMPLER_H
@@ -0,0 +1,91 @@
+#ifndef GRIDGRAPHGENERATOR_H
+#define GRIDGRAPHGENERATOR_H
+
+#include "IGraphGenerator.h"
+#include "CounterRandom.h"
+#include "IStreamingGraphGenerator.h"
+#include "WeightDistribution.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Решетка width x height x depth (depth = 1 - плоская) - модель дорожной сети: малые степени и большой
+// диаметр. Вершина (x, y, z) имеет идентификатор x + width * (y + height * z) и связана с соседями по осям.
+// В ориентированном варианте каждое ребро решетки - две встречные дуги с независимыми весами.
+// Ряд вершин (y, z) - блок со своим потоком CounterRandom: ребра от вершин ряда к соседям справа, ниже и глубже.
+template <typename Weight, typename TIdentifier>
+class GridGraphGenerator : public IGraphGenerator<Weight, TIdentifier>, public IStreamingGraphGenerator<Weight> {
+private:
+    size_t width_;
+    size_t height_;
+    size_t depth_;
+    uint64_t seed_;
+    bool directed_;
+    WeightDistribution<Weight> weights_ = WeightDistribution<Weight>::uniform(1, 10);
+
+    // Ребра ряда row = y + height * z: visit(from, to, weight)
+    template <typename Visitor>
+    void forEachRowEdge(size_t row, Visitor visit) const {
+        CounterRandom random(seed_, row);
+        auto connect = [&](size_t u, size_t v) {
+            visit(u, v, weights_.sample(random));
+            if (directed_) {
+                visit(v, u, weights_.sample(random));
+            }
+        };
+        size_t y = row % height_;
+        size_t z = row / height_;
+        size_t layer = width_ * height_;
+        for (size_t x = 0; x < width_; ++x) {
+            size_t u = x + width_ * row;
+            if (x + 1 < width_) connect(u, u + 1);
+            if (y + 1 < height_) connect(u, u + width_);
+            if (z + 1 < depth_) connect(u, u + layer);
+        }
+    }
+
+public:
+    GridGraphGenerator(size_t width, size_t height, size_t depth, uint64_t seed, bool directed = false)
+        : width_(width), height_(height), depth_(depth), seed_(seed), directed_(directed) {
+        if (width_ == 0 || height_ == 0 || depth_ == 0) {
+            throw std::invalid_argument("Grid dimensions must be greater than 0.");
+        }
+    }
+
+    void setWeightDistribution(const WeightDistribution<Weight>& weights) {
+        weights_ = weights;
+    }
+
+    size_t getVertexCount() const override { return width_ * height_ * depth_; }
+
+    bool isDirected() const override {
+        return directed_;
+    }
+
+    void generateInto(GraphBuilder<Weight, TIdentifier>& builder) override {
+        size_t n = getVertexCount();
+        for (size_t i = 0; i < n; ++i) {
+            builder.addVertex(static_cast<TIdentifier>(i));
+        }
+        size_t lattice = (width_ - 1) * height_ * depth_ + width_ * (height_ - 1) * depth_ +
+                         width_ * height_ * (depth_ - 1);
+        builder.reserveEdges(builder.getEdgeCount() + (directed_ ? 2 : 1) * lattice);
+
+        for (size_t row = 0; row < height_ * depth_; ++row) {
+            forEachRowEdge(row, [&](size_t from, size_t to, Weight weight) {
+                builder.addEdge(static_cast<TIdentifier>(from), static_cast<TIdentifier>(to), weight);
+            });
+        }
+    }
+
+protected:
+    size_t getShardCount() const override {
+        return height_ * depth_;
+    }
+
+    void generateShard(size_t shard, EdgeBuffer<Weight>& buffer) const override {
+        forEachRowEdge(shard, [&](size_t from, size_t to, Weight weight) { buffer.push(from, to, weight); });
+    }
+};
+
+#endif // GRIDGRAPHGENERATOR_H
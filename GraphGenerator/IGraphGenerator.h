@@ -4,13 +4,55 @@
 #include "IGraph.h"
 #include "Vertex.h"
 #include "Edge.h"
+#include "CompressedGraph.h"
+#include "DirectedGraph.h"
+#include "GraphBuilder.h"
+#include "UndirectedGraph.h"
 
+// Генератор пишет ребра сразу в пакетный сборщик GraphBuilder; generate и generateCompressed
+// собирают из него граф нужного вида. Вершины генераторов - идентификаторы 0 .. n - 1.
 template <typename Weight, typename TIdentifier>
 class IGraphGenerator {
 public:
     virtual ~IGraphGenerator() = default;
 
-    virtual IGraph<Weight, TIdentifier>* generate() = 0;
+    virtual bool isDirected() const = 0;
+
+    virtual void generateInto(GraphBuilder<Weight, TIdentifier>& builder) = 0;
+
+    virtual IGraph<Weight, TIdentifier>* generate() {
+        GraphBuilder<Weight, TIdentifier> builder;
+        generateInto(builder);
+        if (isDirected()) {
+            return new DirectedGraph<Weight, TIdentifier>(builder.buildDirected());
+        }
+        return new UndirectedGraph<Weight, TIdentifier>(builder.buildUndirected());
+    }
+
+    CompressedGraph<Weight, TIdentifier> generateCompressed() {
+        GraphBuilder<Weight, TIdentifier> builder;
+        generateInto(builder);
+        return builder.buildCompressed(isDirected());
+    }
+
+protected:
+    // Вершины 0 .. numVertices - 1, затем ребра блоков (поля from, to, weight) в порядке блоков
+    template <typename Chunks>
+    static void emitChunks(GraphBuilder<Weight, TIdentifier>& builder, size_t numVertices, const Chunks& chunks) {
+        for (size_t i = 0; i < numVertices; ++i) {
+            builder.addVertex(static_cast<TIdentifier>(i));
+        }
+        size_t edgeCount = builder.getEdgeCount();
+        for (const auto& chunk : chunks) {
+            edgeCount += chunk.size();
+        }
+        builder.reserveEdges(edgeCount);
+        for (const auto& chunk : chunks) {
+            for (const auto& edge : chunk) {
+                builder.addEdge(static_cast<TIdentifier>(edge.from), static_cast<TIdentifier>(edge.to), edge.weight);
+            }
+        }
+    }
 };
 
-#endif // IGRAPHGENERATOR_H
\ No newline at end of file
+#endif // IGRAPHGENERATOR_H
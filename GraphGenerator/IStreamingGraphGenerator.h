@@ -0,0 +1,73 @@
+#ifndef ISTREAMINGGRAPHGENERATOR_H
+#define ISTREAMINGGRAPHGENERATOR_H
+
+#include "EdgeSink.h"
+#include "ThreadPool.h"
+#include "UniquePtr.h"
+#include <cstddef>
+#include <stdexcept>
+
+// Потоковая генерация: ребра не собираются в граф, а уходят в приемник порциями через буфер
+// фиксированного размера. Ребра разбиты на независимые блоки (shard) со своим потоком случайных чисел,
+// поэтому поток ребер совпадает с графом generateCompressed того же генератора, а блоки можно писать
+// несколькими писателями одновременно.
+template <typename Weight>
+class IStreamingGraphGenerator {
+public:
+    static constexpr size_t kDefaultBufferEdges = size_t(1) << 16;
+
+    virtual ~IStreamingGraphGenerator() = default;
+
+    virtual size_t getVertexCount() const = 0;
+
+    // Все ребра в один приемник в порядке блоков
+    void generateTo(IEdgeSink<Weight>& sink, size_t bufferEdges = kDefaultBufferEdges) {
+        beginStreaming();
+        EdgeBuffer<Weight> buffer(sink, bufferEdges);
+        for (size_t shard = 0; shard < getShardCount(); ++shard) {
+            generateShard(shard, buffer);
+        }
+        buffer.flush();
+        sink.close();
+    }
+
+    // Писатель w получает свой приемник makeSink(w) (UniquePtr<IEdgeSink<Weight>>) и непрерывный диапазон
+    // блоков; склейка приемников в порядке номеров дает тот же поток, что и generateTo.
+    template <typename SinkFactory>
+    void generateSharded(size_t writers, SinkFactory makeSink, ThreadPool* pool = nullptr,
+                         size_t bufferEdges = kDefaultBufferEdges) {
+        if (writers == 0) {
+            throw std::invalid_argument("Number of writers must be greater than 0.");
+        }
+        beginStreaming();
+        size_t shards = getShardCount();
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t writer = begin; writer < end; ++writer) {
+                UniquePtr<IEdgeSink<Weight>> sink = makeSink(writer);
+                EdgeBuffer<Weight> buffer(*sink, bufferEdges);
+                for (size_t shard = shards * writer / writers; shard < shards * (writer + 1) / writers; ++shard) {
+                    generateShard(shard, buffer);
+                }
+                buffer.flush();
+                sink->close();
+            }
+        };
+        if (pool) {
+            pool->parallelFor(0, writers, body, 1);
+        } else {
+            body(0, writers);
+        }
+    }
+
+protected:
+    // Подготовка общего для блоков состояния перед потоком (например, перестановки вершин)
+    virtual void beginStreaming() {}
+
+    // Число блоков; вызывается после beginStreaming
+    virtual size_t getShardCount() const = 0;
+
+    // Вызывается одновременно из нескольких потоков для разных блоков
+    virtual void generateShard(size_t shard, EdgeBuffer<Weight>& buffer) const = 0;
+};
+
+#endif // ISTREAMINGGRAPHGENERATOR_H
@@ -0,0 +1,173 @@
+#ifndef RMATGRAPHGENERATOR_H
+#define RMATGRAPHGENERATOR_H
+
+#include "IGraphGenerator.h"
+#include "CounterRandom.h"
+#include "IStreamingGraphGenerator.h"
+#include "ThreadPool.h"
+#include "WeightDistribution.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// R-MAT (стохастический Кронекер с матрицей-затравкой 2 x 2): 2^scale вершин и edgeFactor * 2^scale ребер.
+// Каждое ребро - спуск по scale уровням матрицы смежности, на каждом уровне выбирается четверть
+// с вероятностями a, b, c, d = 1 - a - b - c. По умолчанию параметры Graph500 (0.57, 0.19, 0.19) - степени
+// распределены по степенному закону. Номера вершин перемешиваются случайной перестановкой, чтобы
+// высокие степени не собирались у малых номеров. Петли и повторные ребра не удаляются, как в Graph500.
+// Ребра генерируются блоками по kChunkEdges со своим потоком CounterRandom, поэтому с пулом потоков
+// граф тот же; в потоковом режиме блок - единица записи, а память - только перестановка O(V).
+template <typename Weight, typename TIdentifier>
+class RMatGraphGenerator : public IGraphGenerator<Weight, TIdentifier>, public IStreamingGraphGenerator<Weight> {
+public:
+    using Edge = GeneratedEdge<Weight>;
+
+private:
+    static constexpr size_t kChunkEdges = size_t(1) << 16;
+
+    int scale_;
+    size_t edgeCount_;
+    uint64_t seed_;
+    bool directed_;
+    double a_ = 0.57;
+    double b_ = 0.19;
+    double c_ = 0.19;
+    bool permute_ = true;
+    WeightDistribution<Weight> weights_ = WeightDistribution<Weight>::uniform(1, 10);
+    ThreadPool* pool_ = nullptr;
+    std::vector<size_t> streamPermutation_;
+
+    std::vector<size_t> makePermutation() const {
+        size_t n = size_t(1) << scale_;
+        std::vector<size_t> permutation(n);
+        for (size_t i = 0; i < n; ++i) {
+            permutation[i] = i;
+        }
+        if (permute_) {
+            // Поток за последним блоком ребер
+            CounterRandom random(seed_, chunkCount());
+            for (size_t i = n - 1; i > 0; --i) {
+                std::swap(permutation[i], permutation[random.nextBelow(i + 1)]);
+            }
+        }
+        return permutation;
+    }
+
+    size_t chunkCount() const {
+        return (edgeCount_ + kChunkEdges - 1) / kChunkEdges;
+    }
+
+    // Ребра блока chunk в порядке генерации, концы уже переставлены: visit(from, to, weight)
+    template <typename Visitor>
+    void forEachEdge(size_t chunk, const std::vector<size_t>& permutation, Visitor visit) const {
+        // Четверть на уровне выбирается по 16 битам случайного числа: одно 64-битное число на 4 уровня
+        auto threshold = [](double probability) { return static_cast<uint32_t>(probability * 65536.0 + 0.5); };
+        uint32_t a = threshold(a_);
+        uint32_t ab = threshold(a_ + b_);
+        uint32_t abc = threshold(a_ + b_ + c_);
+        CounterRandom random(seed_, chunk);
+        size_t count = std::min(kChunkEdges, edgeCount_ - chunk * kChunkEdges);
+        for (size_t i = 0; i < count; ++i) {
+            size_t row = 0;
+            size_t column = 0;
+            uint64_t bits = 0;
+            for (int level = 0; level < scale_; ++level) {
+                if (level % 4 == 0) {
+                    bits = random.next();
+                }
+                uint32_t r = static_cast<uint32_t>(bits & 0xFFFF);
+                bits >>= 16;
+                row <<= 1;
+                column <<= 1;
+                if (r >= abc) {
+                    row |= 1;
+                    column |= 1;
+                } else if (r >= ab) {
+                    row |= 1;
+                } else if (r >= a) {
+                    column |= 1;
+                }
+            }
+            visit(permutation[row], permutation[column], weights_.sample(random));
+        }
+    }
+
+public:
+    RMatGraphGenerator(int scale, size_t edgeFactor, uint64_t seed, bool directed = true)
+        : scale_(scale), edgeCount_(0), seed_(seed), directed_(directed) {
+        if (scale < 1 || scale > 32) {
+            throw std::invalid_argument("R-MAT scale must be between 1 and 32.");
+        }
+        edgeCount_ = edgeFactor << scale;
+    }
+
+    // Вероятности четвертей a (левая верхняя), b (правая верхняя), c (левая нижняя); d = 1 - a - b - c
+    void setProbabilities(double a, double b, double c) {
+        if (a < 0 || b < 0 || c < 0 || a + b + c > 1.0) {
+            throw std::invalid_argument("R-MAT probabilities must be non-negative and sum to at most 1.");
+        }
+        a_ = a;
+        b_ = b;
+        c_ = c;
+    }
+
+    void setPermutation(bool enabled) {
+        permute_ = enabled;
+    }
+
+    void setWeightDistribution(const WeightDistribution<Weight>& weights) {
+        weights_ = weights;
+    }
+
+    void setThreadPool(ThreadPool* pool) {
+        pool_ = pool;
+    }
+
+    size_t getVertexCount() const override { return size_t(1) << scale_; }
+    size_t getEdgeCount() const { return edgeCount_; }
+
+    bool isDirected() const override {
+        return directed_;
+    }
+
+    // Ребра по блокам в порядке генерации, концы уже переставлены
+    std::vector<std::vector<Edge>> sample() const {
+        std::vector<size_t> permutation = makePermutation();
+        std::vector<std::vector<Edge>> chunks(chunkCount());
+        auto body = [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                chunks[chunk].reserve(std::min(kChunkEdges, edgeCount_ - chunk * kChunkEdges));
+                forEachEdge(chunk, permutation, [&](size_t from, size_t to, Weight weight) {
+                    chunks[chunk].push_back({from, to, weight});
+                });
+            }
+        };
+        if (pool_) {
+            pool_->parallelFor(0, chunks.size(), body, 1);
+        } else {
+            body(0, chunks.size());
+        }
+        return chunks;
+    }
+
+    void generateInto(GraphBuilder<Weight, TIdentifier>& builder) override {
+        this->emitChunks(builder, getVertexCount(), sample());
+    }
+
+protected:
+    void beginStreaming() override {
+        streamPermutation_ = makePermutation();
+    }
+
+    size_t getShardCount() const override {
+        return chunkCount();
+    }
+
+    void generateShard(size_t shard, EdgeBuffer<Weight>& buffer) const override {
+        forEachEdge(shard, streamPermutation_, [&](size_t from, size_t to, Weight weight) { buffer.push(from, to, weight); });
+    }
+};
+
+#endif // RMATGRAPHGENERATOR_H
@@ -0,0 +1,143 @@
+#ifndef RANDOMGEOMETRICGRAPHGENERATOR_H
+#define RANDOMGEOMETRICGRAPHGENERATOR_H
+
+#include "IGraphGenerator.h"
+#include "CounterRandom.h"
+#include "WeightDistribution.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Случайный геометрический граф: n точек равномерно в единичном квадрате (dimensions = 2) или кубе (3),
+// ребро соединяет точки на расстоянии не больше radius. Точки раскладываются по ячейкам со стороной
+// не меньше radius, и пары проверяются только в соседних ячейках, поэтому время O(n + m) вместо O(n^2).
+// Веса берутся из распределения либо, после setDistanceWeights(scale), равны ceil(scale * расстояние).
+template <typename Weight, typename TIdentifier>
+class RandomGeometricGraphGenerator : public IGraphGenerator<Weight, TIdentifier> {
+private:
+    size_t numVertices_;
+    double radius_;
+    int dimensions_;
+    uint64_t seed_;
+    WeightDistribution<Weight> weights_ = WeightDistribution<Weight>::uniform(1, 10);
+    double distanceScale_ = 0; // 0 - веса из weights_
+    std::vector<double> points_;
+
+public:
+    RandomGeometricGraphGenerator(size_t numVertices, double radius, int dimensions, uint64_t seed)
+        : numVertices_(numVertices), radius_(radius), dimensions_(dimensions), seed_(seed) {
+        if (numVertices_ == 0) {
+            throw std::invalid_argument("Number of vertices must be greater than 0.");
+        }
+        if (!(radius_ > 0)) {
+            throw std::invalid_argument("Radius must be positive.");
+        }
+        if (dimensions_ != 2 && dimensions_ != 3) {
+            throw std::invalid_argument("Random geometric graph supports 2 or 3 dimensions.");
+        }
+    }
+
+    void setWeightDistribution(const WeightDistribution<Weight>& weights) {
+        weights_ = weights;
+        distanceScale_ = 0;
+    }
+
+    void setDistanceWeights(double scale) {
+        if (!(scale > 0)) {
+            throw std::invalid_argument("Distance scale must be positive.");
+        }
+        distanceScale_ = scale;
+    }
+
+    // Координаты точки vertex последней генерации
+    const double* getPoint(size_t vertex) const {
+        return &points_.at(vertex * dimensions_);
+    }
+
+    bool isDirected() const override {
+        return false;
+    }
+
+    void generateInto(GraphBuilder<Weight, TIdentifier>& builder) override {
+        size_t n = numVertices_;
+        int d = dimensions_;
+        CounterRandom random(seed_, 0);
+        points_.resize(n * d);
+        for (double& coordinate : points_) {
+            coordinate = random.nextDouble();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            builder.addVertex(static_cast<TIdentifier>(i));
+        }
+
+        // Ячейки со стороной 1 / cells >= radius; число ячеек не больше числа точек
+        size_t cells = std::max<size_t>(1, static_cast<size_t>(std::floor(1.0 / radius_)));
+        size_t cellLimit = std::max<size_t>(1, static_cast<size_t>(std::pow(static_cast<double>(n), 1.0 / d)));
+        cells = std::min(cells, cellLimit);
+        auto cellOf = [&](double coordinate) {
+            return std::min(cells - 1, static_cast<size_t>(coordinate * cells));
+        };
+        size_t cellCount = d == 2 ? cells * cells : cells * cells * cells;
+        std::vector<size_t> cellOffsets(cellCount + 1, 0);
+        std::vector<size_t> cellOfPoint(n);
+        for (size_t i = 0; i < n; ++i) {
+            const double* p = &points_[i * d];
+            size_t cell = cellOf(p[0]) + cells * cellOf(p[1]);
+            if (d == 3) cell += cells * cells * cellOf(p[2]);
+            cellOfPoint[i] = cell;
+            ++cellOffsets[cell + 1];
+        }
+        for (size_t c = 0; c < cellCount; ++c) {
+            cellOffsets[c + 1] += cellOffsets[c];
+        }
+        std::vector<size_t> members(n);
+        std::vector<size_t> fill(cellOffsets.begin(), cellOffsets.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            members[fill[cellOfPoint[i]]++] = i;
+        }
+
+        // Обход по ячейкам: точки одной ячейки и ее соседей лежат рядом в members
+        CounterRandom weightRandom(seed_, 1);
+        double radiusSquared = radius_ * radius_;
+        long long side = static_cast<long long>(cells);
+        for (size_t cell = 0; cell < cellCount; ++cell) {
+            long long cx = static_cast<long long>(cell % cells);
+            long long cy = static_cast<long long>(cell / cells % cells);
+            long long cz = static_cast<long long>(cell / cells / cells);
+            for (long long dz = (d == 3 ? -1 : 0); dz <= (d == 3 ? 1 : 0); ++dz) {
+                for (long long dy = -1; dy <= 1; ++dy) {
+                    for (long long dx = -1; dx <= 1; ++dx) {
+                        long long x = cx + dx;
+                        long long y = cy + dy;
+                        long long z = cz + dz;
+                        if (x < 0 || y < 0 || z < 0 || x >= side || y >= side || z >= side) continue;
+                        size_t neighbor = static_cast<size_t>(x + side * y + side * side * z);
+                        for (size_t a = cellOffsets[cell]; a < cellOffsets[cell + 1]; ++a) {
+                            size_t i = members[a];
+                            const double* p = &points_[i * d];
+                            for (size_t b = cellOffsets[neighbor]; b < cellOffsets[neighbor + 1]; ++b) {
+                                size_t j = members[b];
+                                if (j <= i) continue; // каждая пара один раз
+                                const double* q = &points_[j * d];
+                                double distanceSquared = 0;
+                                for (int axis = 0; axis < d; ++axis) {
+                                    distanceSquared += (p[axis] - q[axis]) * (p[axis] - q[axis]);
+                                }
+                                if (distanceSquared > radiusSquared) continue;
+                                Weight weight = distanceScale_ > 0
+                                    ? static_cast<Weight>(std::ceil(distanceScale_ * std::sqrt(distanceSquared)))
+                                    : weights_.sample(weightRandom);
+                                builder.addEdge(static_cast<TIdentifier>(i), static_cast<TIdentifier>(j), weight);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif // RANDOMGEOMETRICGRAPHGENERATOR_H
@@ -0,0 +1,75 @@
+#ifndef WEIGHTDISTRIBUTION_H
+#define WEIGHTDISTRIBUTION_H
+
+#include "CounterRandom.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+// Распределение весов ребер для генераторов. Значения берутся из переданного потока CounterRandom,
+// поэтому веса воспроизводимы вместе с ребрами. Для целых весов uniform включает обе границы,
+// exponential округляется вверх и не меньше 1.
+template <typename Weight>
+class WeightDistribution {
+public:
+    enum class Kind {
+        Constant,
+        Uniform,
+        Exponential
+    };
+
+private:
+    Kind kind_;
+    double first_;
+    double second_;
+
+    WeightDistribution(Kind kind, double first, double second) : kind_(kind), first_(first), second_(second) {}
+
+public:
+    static WeightDistribution constant(Weight value) {
+        return WeightDistribution(Kind::Constant, static_cast<double>(value), 0.0);
+    }
+
+    static WeightDistribution uniform(Weight min, Weight max) {
+        if (max < min) {
+            throw std::invalid_argument("Weight range is empty.");
+        }
+        return WeightDistribution(Kind::Uniform, static_cast<double>(min), static_cast<double>(max));
+    }
+
+    static WeightDistribution exponential(double mean) {
+        if (!(mean > 0)) {
+            throw std::invalid_argument("Mean weight must be positive.");
+        }
+        return WeightDistribution(Kind::Exponential, mean, 0.0);
+    }
+
+    Kind getKind() const { return kind_; }
+
+    Weight sample(CounterRandom& random) const {
+        switch (kind_) {
+        case Kind::Constant:
+            return static_cast<Weight>(first_);
+        case Kind::Uniform:
+            if constexpr (std::is_integral_v<Weight>) {
+                auto span = static_cast<uint64_t>(second_ - first_) + 1;
+                return static_cast<Weight>(first_ + static_cast<double>(random.nextBelow(span)));
+            } else {
+                return static_cast<Weight>(first_ + (second_ - first_) * random.nextDouble());
+            }
+        case Kind::Exponential: {
+            double value = -first_ * std::log1p(-random.nextDouble());
+            if constexpr (std::is_integral_v<Weight>) {
+                return static_cast<Weight>(std::max(1.0, std::ceil(value)));
+            } else {
+                return static_cast<Weight>(value);
+            }
+        }
+        }
+        return Weight{};
+    }
+};
+
+#endif // WEIGHTDISTRIBUTION_H
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Слаб-аллокатор объектов одного типа.
+// Память выделяется блоками (слабами) растущего размера, освобожденные ячейки
+// попадают в список свободных и переиспользуются. При уничтожении пула все слабы
+// освобождаются разом, без вызова деструкторов оставшихся объектов, поэтому
+// объекты с нетривиальным деструктором нужно явно вернуть через destroy().
+template <typename T>
+class ObjectPool {
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Slab {
+        Slot* slots;
+        size_t capacity;
+        Slab* next;
+    };
+
+    static constexpr size_t kInitialSlabCapacity = 64;
+    static constexpr size_t kMaxSlabCapacity = size_t(1) << 16;
+
+    Slab* slabs_ = nullptr;   // последний выделенный слаб стоит первым
+    size_t used_ = 0;         // занято ячеек в первом слабе
+    Slot* freeList_ = nullptr;
+    size_t count_ = 0;
+    size_t capacity_ = 0;
+
+    void addSlab(size_t minCapacity = 0) {
+        size_t slabCapacity = slabs_ ? slabs_->capacity * 2 : kInitialSlabCapacity;
+        if (slabCapacity > kMaxSlabCapacity) {
+            slabCapacity = kMaxSlabCapacity;
+        }
+        if (slabCapacity < minCapacity) {
+            slabCapacity = minCapacity;
+        }
+        auto slab = new Slab{static_cast<Slot*>(::operator new(slabCapacity * sizeof(Slot))), slabCapacity, slabs_};
+        slabs_ = slab;
+        used_ = 0;
+        capacity_ += slabCapacity;
+    }
+
+    Slot* allocateSlot() {
+        if (freeList_) {
+            Slot* slot = freeList_;
+            freeList_ = slot->next;
+            return slot;
+        }
+        if (!slabs_ || used_ == slabs_->capacity) {
+            addSlab();
+        }
+        return &slabs_->slots[used_++];
+    }
+
+    void releaseAll() {
+        while (slabs_) {
+            Slab* next = slabs_->next;
+            ::operator delete(slabs_->slots);
+            delete slabs_;
+            slabs_ = next;
+        }
+        used_ = 0;
+        freeList_ = nullptr;
+        count_ = 0;
+        capacity_ = 0;
+    }
+
+public:
+    ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ObjectPool(ObjectPool&& other) noexcept
+        : slabs_(other.slabs_), used_(other.used_), freeList_(other.freeList_),
+          count_(other.count_), capacity_(other.capacity_) {
+        other.slabs_ = nullptr;
+        other.used_ = 0;
+        other.freeList_ = nullptr;
+        other.count_ = 0;
+        other.capacity_ = 0;
+    }
+
+    ObjectPool& operator=(ObjectPool&& other) noexcept {
+        if (this != &other) {
+            releaseAll();
+            std::swap(slabs_, other.slabs_);
+            std::swap(used_, other.used_);
+            std::swap(freeList_, other.freeList_);
+            std::swap(count_, other.count_);
+            std::swap(capacity_, other.capacity_);
+        }
+        return *this;
+    }
+
+    ~ObjectPool() {
+        releaseAll();
+    }
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = allocateSlot();
+        try {
+            T* object = new (slot->storage) T(std::forward<Args>(args)...);
+            ++count_;
+            return object;
+        } catch (...) {
+            slot->next = freeList_;
+            freeList_ = slot;
+            throw;
+        }
+    }
+
+    // Гарантирует, что следующие count вызовов create не выделят память.
+    // Недостающее место выделяется одним слабом, поэтому объекты лягут в память подряд.
+    void reserve(size_t count) {
+        size_t available = slabs_ ? slabs_->capacity - used_ : 0;
+        if (available < count) {
+            addSlab(count);
+        }
+    }
+
+    void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        auto slot = reinterpret_cast<Slot*>(object);
+        slot->next = freeList_;
+        freeList_ = slot;
+        --count_;
+    }
+
+    size_t getCount() const { return count_; }
+    size_t getCapacity() const { return capacity_; }
+};
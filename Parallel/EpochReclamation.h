@@ -0,0 +1,141 @@
+#ifndef EPOCHRECLAMATION_H
+#define EPOCHRECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+// Отложенное освобождение памяти по эпохам для структур с одним писателем и читателями без блокировок.
+// Читатель закрепляет текущую эпоху (pin) на время чтения. Писатель не освобождает объект, убранный
+// из структуры, сразу, а передает его в retire с меткой текущей эпохи; advance переходит к следующей
+// эпохе и освобождает объекты, помеченные эпохой меньше самой ранней закрепленной.
+//
+// Читатель: записать эпоху в свою ячейку, затем прочитать указатель на данные.
+// Писатель: опубликовать новые данные, затем retire(старые) с эпохой e, затем эпоха e + 1.
+// Читатель, увидевший эпоху e + 1, увидит и новые данные, а закрепивший e (или раньше) удерживает
+// все объекты, убранные в эпоху e. Все атомарные операции - seq_cst.
+//
+// pin не блокируется: ячейки читателей - список без блокировок, занятая ячейка пропускается, при
+// нехватке добавляется новая. retire и advance вызывает только поток писателя.
+class EpochManager {
+private:
+    static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+
+    struct Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+        std::atomic<bool> busy{false};
+        Slot* next = nullptr;
+    };
+
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    std::atomic<uint64_t> epoch_{1};
+    std::atomic<Slot*> slots_{nullptr};
+    std::deque<Retired> retired_; // упорядочены по эпохе, только поток писателя
+
+    Slot* acquireSlot() {
+        for (Slot* slot = slots_.load(); slot; slot = slot->next) {
+            if (!slot->busy.load(std::memory_order_relaxed) && !slot->busy.exchange(true)) {
+                return slot;
+            }
+        }
+        Slot* slot = new Slot();
+        slot->busy.store(true, std::memory_order_relaxed);
+        slot->next = slots_.load();
+        while (!slots_.compare_exchange_weak(slot->next, slot)) {
+        }
+        return slot;
+    }
+
+public:
+    // Закрепленная эпоха; пока объект жив, данные, прочитанные после pin, не освобождаются
+    class Guard {
+    private:
+        Slot* slot_ = nullptr;
+
+    public:
+        Guard() = default;
+        explicit Guard(Slot* slot) : slot_(slot) {}
+        Guard(Guard&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+
+        Guard& operator=(Guard&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot_ = other.slot_;
+                other.slot_ = nullptr;
+            }
+            return *this;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard() { release(); }
+
+        void release() {
+            if (slot_) {
+                slot_->epoch.store(kIdle);
+                slot_->busy.store(false, std::memory_order_release);
+                slot_ = nullptr;
+            }
+        }
+    };
+
+    EpochManager() = default;
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    // Закрепленных читателей к этому моменту быть не должно
+    ~EpochManager() {
+        for (const Retired& item : retired_) {
+            item.deleter(item.pointer);
+        }
+        for (Slot* slot = slots_.load(); slot;) {
+            Slot* next = slot->next;
+            delete slot;
+            slot = next;
+        }
+    }
+
+    Guard pin() {
+        Slot* slot = acquireSlot();
+        slot->epoch.store(epoch_.load());
+        return Guard(slot);
+    }
+
+    uint64_t getEpoch() const { return epoch_.load(); }
+    size_t getRetiredCount() const { return retired_.size(); }
+
+    void retire(void* pointer, void (*deleter)(void*)) {
+        retired_.push_back({pointer, deleter, epoch_.load()});
+    }
+
+    // Переход к следующей эпохе и освобождение того, что уже никто не читает
+    void advance() {
+        epoch_.fetch_add(1);
+        reclaim();
+    }
+
+    // Освобождает объекты, убранные раньше самой ранней закрепленной эпохи
+    void reclaim() {
+        uint64_t oldest = kIdle;
+        for (Slot* slot = slots_.load(); slot; slot = slot->next) {
+            uint64_t epoch = slot->epoch.load();
+            if (epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+        while (!retired_.empty() && retired_.front().epoch < oldest) {
+            retired_.front().deleter(retired_.front().pointer);
+            retired_.pop_front();
+        }
+    }
+};
+
+#endif // EPOCHRECLAMATION_H
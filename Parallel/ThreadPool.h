@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков фиксированного размера для параллельных циклов по диапазону индексов.
+// parallelFor режет [begin, end) на блоки, блоки разбирают рабочие потоки и вызывающий поток.
+// Одновременно выполняется один цикл; вложенный parallelFor из тела цикла выполняется последовательно.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable finished_;
+    std::mutex jobMutex_; // сериализует вызовы parallelFor
+
+    // Текущее задание
+    const std::function<void(size_t, size_t)>* body_ = nullptr;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    size_t blockSize_ = 1;
+    std::atomic<size_t> nextBlock_{0};
+    size_t blockCount_ = 0;
+    size_t generation_ = 0;
+    size_t activeWorkers_ = 0;
+    std::exception_ptr error_;
+    bool stopping_ = false;
+
+    static bool& insideParallelRegion() {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    void runBlocks() {
+        bool& inside = insideParallelRegion();
+        inside = true;
+        for (size_t block = nextBlock_.fetch_add(1); block < blockCount_; block = nextBlock_.fetch_add(1)) {
+            size_t lo = begin_ + block * blockSize_;
+            size_t hi = std::min(end_, lo + blockSize_);
+            try {
+                (*body_)(lo, hi);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+                nextBlock_.store(blockCount_); // остальные блоки не выполняем
+            }
+        }
+        inside = false;
+    }
+
+    void workerLoop() {
+        size_t seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeUp_.wait(lock, [&]() { return stopping_ || generation_ != seenGeneration; });
+                if (stopping_) return;
+                seenGeneration = generation_;
+            }
+            runBlocks();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--activeWorkers_ == 0) {
+                    finished_.notify_one();
+                }
+            }
+        }
+    }
+
+public:
+    // threadCount - общее число потоков вместе с вызывающим; 0 означает hardware_concurrency
+    explicit ThreadPool(size_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threadCount - 1);
+        for (size_t i = 0; i + 1 < threadCount; ++i) {
+            workers_.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t getThreadCount() const {
+        return workers_.size() + 1;
+    }
+
+    // Вызывает body(lo, hi) для непересекающихся блоков, покрывающих [begin, end).
+    // Блок содержит не меньше grain индексов. Первое брошенное исключение пробрасывается вызывающему.
+    void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grain = 1) {
+        if (begin >= end) return;
+
+        size_t count = end - begin;
+        grain = std::max<size_t>(1, grain);
+        if (workers_.empty() || count <= grain || insideParallelRegion()) {
+            body(begin, end);
+            return;
+        }
+
+        std::lock_guard<std::mutex> job(jobMutex_);
+        // Несколько блоков на поток сглаживают неравномерную нагрузку
+        size_t blockSize = std::max(grain, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            body_ = &body;
+            begin_ = begin;
+            end_ = end;
+            blockSize_ = blockSize;
+            blockCount_ = (count + blockSize - 1) / blockSize;
+            nextBlock_.store(0);
+            error_ = nullptr;
+            activeWorkers_ = workers_.size();
+            ++generation_;
+        }
+        wakeUp_.notify_all();
+
+        runBlocks();
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            finished_.wait(lock, [&]() { return activeWorkers_ == 0; });
+            body_ = nullptr;
+            error = error_;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Общий пул на все ядра машины
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <utility>
 
 template<typename T>
 class DynamicArray {
@@ -9,11 +10,17 @@ private:
     int allocatedMemory;
     int size;
 
+    // Емкость растет геометрически, чтобы серия вставок в конец стоила O(1) амортизированно
+    int grownCapacity(int required) const {
+        int doubled = allocatedMemory * 2;
+        return required > doubled ? required : (doubled < 5 ? 5 : doubled);
+    }
+
     void resize(int capacity) {
         if (capacity < size) throw std::invalid_argument("NegativeResize");
         T *newData = new T[capacity];
         for (int i = 0; i < size; ++i) {
-            newData[i] = data[i];
+            newData[i] = std::move(data[i]);
         }
         delete[] data;
         data = newData;
@@ -101,7 +108,7 @@ public:
     void insertAt(int index, const T &value) {
         if (index < 0 || index > size) throw std::out_of_range("IndexOutOfRange");
         if (size + 1 > allocatedMemory) {
-            resize(allocatedMemory + 5);
+            resize(grownCapacity(size + 1));
         }
         for (int i = size; i > index; --i) {
             data[i] = data[i - 1];
@@ -110,6 +117,17 @@ public:
         size++;
     }
 
+    int getCapacity() const {
+        return allocatedMemory;
+    }
+
+    // Заранее выделяет память под capacity элементов
+    void reserve(int capacity) {
+        if (capacity > allocatedMemory) {
+            resize(capacity);
+        }
+    }
+
     int getSize() const {
         return size;
     }
@@ -119,7 +137,7 @@ public:
             throw std::invalid_argument("NegativeSize");
         }
         if (newSize > allocatedMemory) {
-            resize(newSize + 5);
+            resize(grownCapacity(newSize));
         }
         size = newSize;
     }
@@ -81,6 +81,13 @@ public:
         base.setSize(newSize);
     }
 
+    void reserve(int capacity) {
+        if (capacity < 0) {
+            throw std::invalid_argument("NegativeSize");
+        }
+        base.reserve(capacity);
+    }
+
     void insertAt(int index, const T &item) override {
         base.insertAt(index, item);
     }
@@ -1,13 +1,54 @@
 #include "InternalTests.h"
 
+#include <BarabasiAlbertGraphGenerator.h>
+#include <BFSAlgorithm.h>
+#include <BellmanFordAlgorithm.h>
+#include <BetweennessCentralityAlgorithm.h>
+#include <BipartiteMatchingAlgorithm.h>
 #include <ConnectedComponentsAlgorithm.h>
+#include <CounterRandom.h>
 #include <DijkstraAlgorithm.h>
+#include <DirectedGraphGenerator.h>
+#include <DistanceMatrix.h>
+#include <DurableGraph.h>
+#include <EdgeFileSinks.h>
+#include <EdgeSink.h>
+#include <ErdosRenyiSampler.h>
+#include <FloydWarshallAlgorithm.h>
+#include <GraphBuilder.h>
+#include <GraphColoringAlgorithm.h>
+#include <GraphLoader.h>
 #include <GraphPath.h>
+#include <GridGraphGenerator.h>
+#include <IncrementalTopologicalOrder.h>
+#include <JohnsonReweighting.h>
+#include <KCoreAlgorithm.h>
+#include <LouvainAlgorithm.h>
+#include <MappedGraph.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <MaxFlowAlgorithm.h>
 #include <MSTAlgorithm.h>
+#include <PageRankAlgorithm.h>
+#include <RandomGeometricGraphGenerator.h>
+#include <ReachabilityIndex.h>
+#include <RMatGraphGenerator.h>
+#include <random>
 #include <set>
+#include <span>
 #include <StronglyConnectedComponentsAlgorithm.h>
+#include <thread>
+#include <tuple>
 #include <TopologicalSortAlgorithm.h>
+#include <TriangleCountingAlgorithm.h>
+#include <UndirectedGraphGenerator.h>
+#include <VersionedGraph.h>
+#include <WeightDistribution.h>
 
 #include "DictionaryIterator.h"
 #include "DirectedGraph.h"
@@ -21,6 +62,8 @@
 #include "LinkedList.h"
 #include "MutableArraySequence.h"
 #include "MutableListSequence.h"
+#include "ObjectPool.h"
+#include "ThreadPool.h"
 #include "SharedPtr.h"
 #include "Student.h"
 #include "TestRunner.h"
@@ -225,6 +268,20 @@ namespace internal_tests {
 
         });
 
+        runner.expectNoException("HashTable::swap", []() {
+            HashTable<int, std::string> first;
+            HashTable<int, std::string> second(5);
+            for (int i = 0; i < 40; ++i) {
+                first.add(i, std::to_string(i));
+            }
+            second.add(100, "hundred");
+            first.swap(second);
+            if (first.getCount() != 1 || first.get(100) != "hundred" || first.containsKey(0))
+                throw std::runtime_error("Incorrect first table after swap.");
+            if (second.getCount() != 40 || second.get(39) != "39" || second.containsKey(100))
+                throw std::runtime_error("Incorrect second table after swap.");
+        });
+
         // Тест: Перезапись при коллизиях
         runner.expectNoException("HashTable::Overwrite after collisions", []() {
             struct CustomHash {
@@ -252,6 +309,30 @@ namespace internal_tests {
                     throw std::runtime_error("containsKey returned true after removing all elements");
             }
         });
+
+        // Тест: Надгробия не копятся и не дают дубликатов ключа
+        runner.expectNoException("HashTable::add after remove", []() {
+            struct CustomHash {
+                int operator()(int key) const {
+                    return key % 10;
+                }
+            };
+            HashTable<int, int, CustomHash> hashTable(20);
+            hashTable.add(1, 1);
+            hashTable.add(11, 11);
+            hashTable.remove(1);
+            hashTable.add(11, 111); // 11 лежит за надгробием ключа 1
+            hashTable.remove(11);
+            if (hashTable.containsKey(11) || hashTable.getCount() != 0)
+                throw std::runtime_error("Duplicate key left after overwrite past a tombstone.");
+
+            for (int i = 0; i < 100000; ++i) {
+                hashTable.add(i, i);
+                hashTable.remove(i);
+            }
+            if (hashTable.getCapacity() > 20 || hashTable.getCount() != 0)
+                throw std::runtime_error("Tombstones made the table grow.");
+        });
     }
 
     void testHashTableDictionary() {
@@ -276,6 +357,21 @@ namespace internal_tests {
             if (dict.get(1) != "one") throw std::runtime_error("Incorrect value for key 1");
         });
 
+        // Тест присваивания: копия независима от исходного словаря
+        runner.expectNoException("HashTableDictionary::Assignment", []() {
+            HashTableDictionary<int, std::string> dict;
+            dict.add(1, "one");
+            HashTableDictionary<int, std::string> copy;
+            copy.add(2, "two");
+            copy = dict;
+            dict.add(3, "three");
+            if (copy.getCount() != 1 || copy.get(1) != "one" || copy.containsKey(2) || copy.containsKey(3))
+                throw std::runtime_error("Incorrect copy after assignment");
+            dict = HashTableDictionary<int, std::string>(7);
+            if (dict.getCount() != 0 || dict.getCapacity() != 7)
+                throw std::runtime_error("Incorrect dictionary after assigning a temporary");
+        });
+
         // Тест containsKey
         runner.expectNoException("HashTableDictionary::containsKey", []() {
             HashTableDictionary<int, std::string> dict;
@@ -397,6 +493,90 @@ namespace internal_tests {
             auto edges = graph.getEdges(v1);
         });
 
+        // Тест hasEdge и removeEdge у вершины высокой степени (индекс соседей)
+        runner.expectNoException("DirectedGraph::hub vertex edges", []() {
+            DirectedGraph<int, int> graph;
+            const int degree = 100000;
+            auto hub = graph.createVertex(0);
+            for (int i = 1; i <= degree; ++i) {
+                graph.addEdge(hub, graph.createVertex(i), i);
+            }
+            if (!hub->getOutgoingList().isIndexed()) throw std::runtime_error("Hub adjacency should be indexed");
+            for (int i = 1; i <= degree; i += 2) {
+                graph.removeEdge(hub, graph.findVertex(i));
+            }
+            for (int i = 1; i <= degree; ++i) {
+                bool expected = i % 2 == 0;
+                if (graph.hasEdge(hub, graph.findVertex(i)) != expected)
+                    throw std::runtime_error("Incorrect hasEdge for neighbor " + std::to_string(i));
+                if (graph.findVertex(i)->getIncomingList().getLength() != (expected ? 1 : 0))
+                    throw std::runtime_error("Incorrect incoming edges of neighbor " + std::to_string(i));
+            }
+            if (hub->getOutgoingList().getLength() != degree / 2) throw std::runtime_error("Incorrect hub degree");
+        });
+
+        // Тест removeVertex у хаба: все инцидентные ребра отсоединяются за один проход
+        runner.expectNoException("DirectedGraph::removeVertex of hub", []() {
+            DirectedGraph<int, int> graph;
+            const int degree = 100000;
+            auto hub = graph.createVertex(0);
+            for (int i = 1; i <= degree; ++i) {
+                auto neighbor = graph.createVertex(i);
+                graph.addEdge(hub, neighbor, 1);
+                graph.addEdge(neighbor, hub, 1);
+            }
+            graph.addEdge(hub, hub, 1);
+            graph.addEdge(graph.findVertex(1), graph.findVertex(2), 1);
+            graph.removeVertex(hub);
+            if (graph.getVertexCount() != degree || graph.findVertex(0)) throw std::runtime_error("Hub was not removed");
+            for (int i = 1; i <= degree; ++i) {
+                auto neighbor = graph.findVertex(i);
+                int expectedOut = i == 1 ? 1 : 0;
+                int expectedIn = i == 2 ? 1 : 0;
+                if (neighbor->getOutgoingList().getLength() != expectedOut || neighbor->getIncomingList().getLength() != expectedIn)
+                    throw std::runtime_error("Neighbor " + std::to_string(i) + " keeps edges of the removed hub");
+            }
+        });
+
+        // Тест пакетного удаления ребер
+        runner.expectNoException("DirectedGraph::removeEdges", []() {
+            DirectedGraph<int, int> graph;
+            const int degree = 100000;
+            auto hub = graph.createVertex(0);
+            std::vector<Edge<int, int>*> odd;
+            std::vector<std::pair<Vertex<int, int>*, Vertex<int, int>*>> even;
+            for (int i = 1; i <= degree; ++i) {
+                auto neighbor = graph.createVertex(i);
+                graph.addEdge(neighbor, hub, 1);
+                if (i % 2) {
+                    odd.push_back(static_cast<Edge<int, int>*>(neighbor->findOutgoingEdge(0)));
+                } else if (i % 4 == 0) {
+                    even.push_back({neighbor, hub});
+                }
+            }
+            graph.removeEdges(odd);
+            graph.removeEdges(even);
+            if (hub->getIncomingList().getLength() != degree / 4) throw std::runtime_error("Incorrect hub in-degree");
+            if (graph.hasEdge(graph.findVertex(3), hub) || graph.hasEdge(graph.findVertex(4), hub) ||
+                !graph.hasEdge(graph.findVertex(6), hub))
+                throw std::runtime_error("Incorrect edges after batch removal");
+        });
+
+        // Тест кратных ребер: удаление по одному
+        runner.expectNoException("DirectedGraph::parallel edges", []() {
+            DirectedGraph<int, int> graph;
+            auto hub = graph.createVertex(0);
+            for (int i = 1; i <= 40; ++i) {
+                graph.addEdge(hub, graph.createVertex(i), 1);
+            }
+            auto target = graph.findVertex(5);
+            graph.addEdge(hub, target, 2);
+            graph.removeEdge(hub, target);
+            if (!graph.hasEdge(hub, target)) throw std::runtime_error("Second parallel edge should remain");
+            graph.removeEdge(hub, target);
+            if (graph.hasEdge(hub, target)) throw std::runtime_error("Both parallel edges should be removed");
+        });
+
         // Тест getVertexById
         runner.expectNoException("DirectedGraph::getVertexById", []() {
             DirectedGraph<int, int> graph;
@@ -484,6 +664,37 @@ namespace internal_tests {
             if (!graph.hasEdge(v2, v1)) throw std::runtime_error("Edge should be present (undirected)");
         });
 
+        // Тест removeVertex у хаба
+        runner.expectNoException("UndirectedGraph::removeVertex of hub", []() {
+            UndirectedGraph<int, int> graph;
+            const int degree = 100000;
+            auto hub = graph.createVertex(0);
+            for (int i = 1; i <= degree; ++i) {
+                graph.addEdge(graph.createVertex(i), hub, 1);
+            }
+            graph.addEdge(hub, hub, 1);
+            graph.removeVertex(hub);
+            for (int i = 1; i <= degree; i += 997) {
+                auto neighbor = graph.findVertex(i);
+                if (neighbor->getOutgoingList().getLength() != 0 || neighbor->getIncomingList().getLength() != 0)
+                    throw std::runtime_error("Neighbor keeps edges of the removed hub");
+            }
+        });
+
+        // Тест removeEdge удаляет обе дуги ребра
+        runner.expectNoException("UndirectedGraph::removeEdge", []() {
+            UndirectedGraph<int, int> graph;
+            auto hub = graph.createVertex(0);
+            for (int i = 1; i <= 100; ++i) {
+                graph.addEdge(hub, graph.createVertex(i), 1);
+            }
+            auto v7 = graph.findVertex(7);
+            graph.removeEdge(v7, hub);
+            if (graph.hasEdge(hub, v7) || graph.hasEdge(v7, hub)) throw std::runtime_error("Edge should be removed in both directions");
+            if (hub->getOutgoingList().getLength() != 99 || hub->getIncomingList().getLength() != 99)
+                throw std::runtime_error("Incorrect hub degree after removal");
+        });
+
         // Тест getVertexById
         runner.expectNoException("UndirectedGraph::getVertexById", []() {
             UndirectedGraph<int, int> graph;
@@ -535,138 +746,2932 @@ namespace internal_tests {
         return graph;
     }
 
+    // Случайный граф на вершинах 0..vertexCount-1: edgeCount ребер с равновероятными концами
+    // (петли и кратные ребра возможны) и весами от 1 до maxWeight
+    GraphBuilder<int, int> createRandomGraphBuilderForTests(int vertexCount, int edgeCount, unsigned seed, int maxWeight) {
+        GraphBuilder<int, int> builder(vertexCount);
+        for (int v = 0; v < vertexCount; ++v) {
+            builder.addVertex(v);
+        }
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> vertexDist(0, vertexCount - 1);
+        std::uniform_int_distribution<int> weightDist(1, maxWeight);
+        for (int i = 0; i < edgeCount; ++i) {
+            int from = vertexDist(generator);
+            int to = vertexDist(generator);
+            builder.addEdge(from, to, maxWeight > 1 ? weightDist(generator) : 1);
+        }
+        return builder;
+    }
+
+    CompressedGraph<int, int> createRandomDirectedGraphForTests(int vertexCount, int edgeCount, unsigned seed, int maxWeight = 1) {
+        return createRandomGraphBuilderForTests(vertexCount, edgeCount, seed, maxWeight).buildCompressed(true);
+    }
+
+    CompressedGraph<int, int> createRandomUndirectedGraphForTests(int vertexCount, int edgeCount, unsigned seed, int maxWeight = 1) {
+        return createRandomGraphBuilderForTests(vertexCount, edgeCount, seed, maxWeight).buildCompressed(false);
+    }
+
+    // Случайный ориентированный граф без отрицательных циклов: вес ребра u -> v равен w + p(v) - p(u)
+    // при неотрицательном w, то есть может быть отрицательным, а вес любого цикла неотрицателен
+    CompressedGraph<int, int> createRandomPotentialGraphForTests(int vertexCount, int edgeCount, unsigned seed) {
+        GraphBuilder<int, int> builder(vertexCount);
+        for (int v = 0; v < vertexCount; ++v) {
+            builder.addVertex(v);
+        }
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> vertexDist(0, vertexCount - 1);
+        std::uniform_int_distribution<int> weightDist(0, 20);
+        std::vector<int> potential(vertexCount);
+        for (int& value : potential) {
+            value = weightDist(generator);
+        }
+        for (int i = 0; i < edgeCount; ++i) {
+            int u = vertexDist(generator);
+            int v = vertexDist(generator);
+            builder.addEdge(u, v, weightDist(generator) + potential[v] - potential[u]);
+        }
+        return builder.buildCompressed(true);
+    }
+
     void testDijkstraAlgorithm() {
         TestRunner runner;
 
-        runner.expectNoException("DijkstraAlgorithm::Find shortest path", []() {
-            DirectedGraph<int, int> graph = createDirectedGraphForTests();
-            DijkstraAlgorithm<int, int> dijkstra;
+        runner.expectNoException("DijkstraAlgorithm::Find shortest path", []() {
+            DirectedGraph<int, int> graph = createDirectedGraphForTests();
+            DijkstraAlgorithm<int, int> dijkstra;
+
+            IVertex<int, int> *startVertex = graph.getVertexById(1);
+            IVertex<int, int> *endVertex = graph.getVertexById(5);
+
+            if (!startVertex || !endVertex) {
+                throw std::runtime_error("Start or end vertex not found in graph.");
+            }
+
+            auto dijkstraResult = dijkstra.execute(&graph, startVertex, endVertex);
+            if (!dijkstraResult) {
+                throw std::runtime_error("Dijkstra's algorithm returned nullptr.");
+            }
+            auto distances = dijkstraResult->first;
+            auto path = dijkstraResult->second;
+
+            std::map<int, int> expectedDistances = {
+            {1, 0}, {2, 8}, {3, 8}, {4, 5}, {5, 7}
+            };
+            std::vector<int> expectedPath = {1, 4, 5};
+
+
+            auto vertices = graph.getVertices();
+            for (size_t i = 0; i < vertices.getLength(); ++i) {
+                int vertexId = vertices.get(i)->getId();
+                if (distances.get(i) != expectedDistances[vertexId]){
+                    throw std::runtime_error("Incorrect shortest path distance for vertex " + std::to_string(vertexId) +
+                                             ", expected: " + std::to_string(expectedDistances[vertexId]) +
+                                             ", actual: " + std::to_string(distances.get(i)));
+                }
+            }
+
+            if (path.getLength() != expectedPath.size()) {
+                throw std::runtime_error("Shortest path length is incorrect.");
+            }
+            for (size_t i = 0; i < path.getLength(); ++i) {
+                if (path.getVertices().get(i)->getId() != expectedPath[i]) {
+                    throw std::runtime_error("Incorrect vertex in shortest path at position " + std::to_string(i));
+                }
+            }
+        });
+    }
+
+    void testMSTAlgorithm() {
+        TestRunner runner;
+        runner.expectNoException("MSTAlgorithm::Find MST", []() {
+            UndirectedGraph<int, int> graph = createUndirectedGraphForTests();
+            MSTAlgorithm<int, int> mstAlgo;
+            auto mstEdges = mstAlgo.execute(&graph);
+            if (!mstEdges) {
+                throw std::runtime_error("MST Algorithm returned nullptr");
+            }
+        });
+    }
+
+    void testConnectedComponentsAlgorithm() {
+        TestRunner runner;
+        runner.expectNoException("ConnectedComponentsAlgorithm::Find CC", []() {
+            UndirectedGraph<int, int> graph = createUndirectedGraphForTests();
+            ConnectedComponentsAlgorithm<int, int> ccAlgo;
+            auto components = ccAlgo.execute(&graph);
+            if (!components) {
+                throw std::runtime_error("Connected Components Algorithm returned nullptr");
+            }
+        });
+    }
+
+    void testStronglyConnectedComponentsAlgorithm() {
+        TestRunner runner;
+        runner.expectNoException("StronglyConnectedComponentsAlgorithm::Find SCC", []() {
+            DirectedGraph<int, int> graph = createDirectedGraphForTests();
+            StronglyConnectedComponentsAlgorithm<int, int> sccAlgo;
+            auto components = sccAlgo.execute(&graph);
+            if(!components) {
+                throw std::runtime_error("Strongly Connected Components Algorithm returned nullptr");
+            }
+
+            // Проверяем количество компонент
+            if (components->getLength() != 2) {
+                throw std::runtime_error("Incorrect number of strongly connected components. Expected 2, got " +
+                                         std::to_string(components->getLength()));
+            }
+
+            // Проверяем состав компонент.
+            std::set<int> component1;
+            std::set<int> component2;
+
+            // Заполняем наборы из результата алгоритма
+            for (size_t i = 0; i < components->getLength(); ++i) {
+                auto& component = components->get(i); // component - ссылка на MutableArraySequence<IVertex<int, int>*>
+
+                if (component.getLength() == 1)
+                {
+                    IVertex<int, int>* vertex = component.get(0);
+                    if (!vertex) {
+                        throw std::runtime_error("component.get(0) returned nullptr");
+                    }
+                    component1.insert(vertex->getId());
+                }
+                else if(component.getLength() == 4)
+                {
+                    for(size_t j = 0; j < component.getLength(); j++)
+                    {
+                        IVertex<int, int>* vertex = component.get(j);
+                         if (!vertex) {
+                            throw std::runtime_error("component.get(" + std::to_string(j) + ") returned nullptr");
+                         }
+                          component2.insert(vertex->getId());
+                    }
+                }
+                else
+                   throw std::runtime_error("Incorrect component size");
+            }
+
+
+            // Ожидаемые компоненты
+            std::set<int> expectedComponent1 = {1};
+            std::set<int> expectedComponent2 = {2, 3, 4, 5};
+
+
+            if (component1 != expectedComponent1) {
+               throw std::runtime_error("Incorrect component 1.  Expected {1}");
+            }
+
+             if (component2 != expectedComponent2) {
+               throw std::runtime_error("Incorrect component 2.  Expected {2, 3, 4, 5}");
+            }
+        });
+    }
+
+    void testIncrementalTopologicalOrder() {
+        TestRunner runner;
+
+        auto checkOrder = [](const DirectedGraph<int, int>& graph, const IncrementalTopologicalOrder<int, int>& order) {
+            auto vertices = graph.getVertices();
+            if (order.getOrder().getLength() != vertices.getLength()) {
+                throw std::runtime_error("Order does not contain all vertices");
+            }
+            for (int i = 0; i < vertices.getLength(); ++i) {
+                auto edges = vertices.get(i)->getOutgoingEdges();
+                for (int j = 0; j < edges.getLength(); ++j) {
+                    if (order.getPosition(edges.get(j)->getFrom()) >= order.getPosition(edges.get(j)->getTo())) {
+                        throw std::runtime_error("Edge " + std::to_string(edges.get(j)->getFrom()->getId()) + " -> " +
+                                                 std::to_string(edges.get(j)->getTo()->getId()) + " violates the order");
+                    }
+                }
+            }
+        };
+
+        runner.expectNoException("IncrementalTopologicalOrder::Initial order", [&]() {
+            DirectedGraph<int, int> graph;
+            auto vertices = createVertices({1, 2, 3, 4});
+            graph.addEdge(vertices.get(3), vertices.get(2), 1); // 4 -> 3
+            graph.addEdge(vertices.get(2), vertices.get(1), 1); // 3 -> 2
+            graph.addEdge(vertices.get(1), vertices.get(0), 1); // 2 -> 1
+            IncrementalTopologicalOrder<int, int> order(&graph);
+            checkOrder(graph, order);
+        });
+
+        runner.expectNoException("IncrementalTopologicalOrder::Add edges against order", [&]() {
+            DirectedGraph<int, int> graph;
+            auto vertices = createVertices({1, 2, 3, 4, 5, 6});
+            IncrementalTopologicalOrder<int, int> order(&graph);
+            for (int i = 0; i < vertices.getLength(); ++i) {
+                order.addVertex(vertices.get(i));
+            }
+            order.addEdge(vertices.get(5), vertices.get(0), 1); // 6 -> 1
+            order.addEdge(vertices.get(4), vertices.get(5), 1); // 5 -> 6
+            order.addEdge(vertices.get(3), vertices.get(1), 1); // 4 -> 2
+            order.addEdge(vertices.get(1), vertices.get(4), 1); // 2 -> 5
+            order.addEdge(vertices.get(2), vertices.get(3), 1); // 3 -> 4
+            checkOrder(graph, order);
+        });
+
+        runner.expectException<CycleDetectedException<int, int>>("IncrementalTopologicalOrder::Reject cycle", []() {
+            DirectedGraph<int, int> graph;
+            auto vertices = createVertices({1, 2, 3});
+            IncrementalTopologicalOrder<int, int> order(&graph);
+            order.addEdge(vertices.get(0), vertices.get(1), 1);
+            order.addEdge(vertices.get(1), vertices.get(2), 1);
+            order.addEdge(vertices.get(2), vertices.get(0), 1);
+        });
+
+        runner.expectNoException("IncrementalTopologicalOrder::Cycle path", [&]() {
+            DirectedGraph<int, int> graph;
+            auto vertices = createVertices({1, 2, 3});
+            IncrementalTopologicalOrder<int, int> order(&graph);
+            order.addEdge(vertices.get(0), vertices.get(1), 1);
+            order.addEdge(vertices.get(1), vertices.get(2), 1);
+            try {
+                order.addEdge(vertices.get(2), vertices.get(0), 1);
+                throw std::runtime_error("Cycle was not detected");
+            } catch (const CycleDetectedException<int, int>& e) {
+                std::vector<int> expectedCycle = {3, 1, 2, 3};
+                const auto& cycle = e.getCycle().getVertices();
+                if (cycle.getLength() != static_cast<int>(expectedCycle.size())) {
+                    throw std::runtime_error("Incorrect cycle length");
+                }
+                for (int i = 0; i < cycle.getLength(); ++i) {
+                    if (cycle.get(i)->getId() != expectedCycle[i]) {
+                        throw std::runtime_error("Incorrect vertex in cycle at position " + std::to_string(i));
+                    }
+                }
+            }
+            if (graph.hasEdge(vertices.get(2), vertices.get(0))) {
+                throw std::runtime_error("Rejected edge was added to the graph");
+            }
+            checkOrder(graph, order);
+        });
+
+        runner.expectNoException("IncrementalTopologicalOrder::Rejected edge adds no vertices", [&]() {
+            DirectedGraph<int, int> graph;
+            auto vertices = createVertices({1, 2});
+            IncrementalTopologicalOrder<int, int> order(&graph);
+            order.addEdge(vertices.get(0), vertices.get(1), 1);
+
+            Vertex<int, int> loopVertex(3);
+            try {
+                order.addEdge(&loopVertex, &loopVertex, 1);
+                throw std::runtime_error("Self-loop was not detected");
+            } catch (const CycleDetectedException<int, int>&) {
+            }
+            try {
+                order.addEdge(vertices.get(1), vertices.get(0), 1);
+                throw std::runtime_error("Cycle was not detected");
+            } catch (const CycleDetectedException<int, int>&) {
+            }
+            if (graph.getVertexCount() != 2 || order.getOrder().getLength() != 2 || graph.findVertex(3)) {
+                throw std::runtime_error("Rejected edge changed the vertex set");
+            }
+
+            // Новый конец ребра перед уже упорядоченной вершиной
+            auto source = new Vertex<int, int>(0);
+            order.addEdge(source, vertices.get(0), 1);
+            if (graph.getVertexCount() != 3) {
+                throw std::runtime_error("Accepted edge did not add its new vertex");
+            }
+            checkOrder(graph, order);
+        });
+    }
+
+    void testGraphBuilder() {
+        TestRunner runner;
+
+        auto makeBuilder = []() {
+            GraphBuilder<int, int> builder(4);
+            std::vector<GraphBuilder<int, int>::EdgeRecord> edges = {{1, 2, 5}, {1, 3, 7}, {3, 2, 1}, {2, 4, 2}};
+            builder.addEdges(edges);
+            builder.addVertex(10); // изолированная вершина
+            return builder;
+        };
+
+        runner.expectNoException("GraphBuilder::Build directed graph", [&]() {
+            auto graph = makeBuilder().buildDirected();
+            auto v1 = graph.findVertex(1);
+            auto v2 = graph.findVertex(2);
+            if (graph.getVertexCount() != 5 || !graph.findVertex(10)) {
+                throw std::runtime_error("Incorrect vertex set");
+            }
+            if (!graph.hasEdge(v1, v2) || graph.hasEdge(v2, v1) || !graph.hasEdge(v2, graph.findVertex(4))) {
+                throw std::runtime_error("Incorrect edge set");
+            }
+            auto outgoing = v1->getOutgoingEdges();
+            if (outgoing.getLength() != 2 || outgoing.get(0)->getTo()->getId() != 2 || outgoing.get(1)->getWeight() != 7) {
+                throw std::runtime_error("Outgoing edges must keep insertion order");
+            }
+            if (v2->getIncomingEdges().getLength() != 2) {
+                throw std::runtime_error("Incorrect incoming edges");
+            }
+            graph.removeEdge(v1, v2);
+            if (graph.hasEdge(v1, v2)) {
+                throw std::runtime_error("Built graph must stay mutable");
+            }
+        });
+
+        runner.expectNoException("GraphBuilder::Build undirected graph", [&]() {
+            auto graph = makeBuilder().buildUndirected();
+            auto v2 = graph.findVertex(2);
+            if (!graph.hasEdge(v2, graph.findVertex(1)) || !graph.hasEdge(graph.findVertex(1), v2)) {
+                throw std::runtime_error("Undirected edge must be visible from both ends");
+            }
+            if (v2->getOutgoingEdges().getLength() != 3 || v2->getIncomingEdges().getLength() != 3) {
+                throw std::runtime_error("Incorrect degree of vertex 2");
+            }
+        });
+
+        runner.expectNoException("GraphBuilder::Build compressed snapshot", [&]() {
+            auto directed = makeBuilder().buildCompressed(true);
+            int v1 = directed.getIndex(1);
+            int v2 = directed.getIndex(2);
+            auto neighbors = directed.getOutNeighbors(v1);
+            if (directed.getEdgeCount() != 4 || neighbors.size() != 2 || directed.getId(neighbors[0]) != 2 ||
+                directed.getOutWeights(v1)[1] != 7 || directed.getInDegree(v2) != 2 ||
+                directed.getOutDegree(directed.getIndex(10)) != 0) {
+                throw std::runtime_error("Incorrect directed snapshot");
+            }
+
+            auto undirected = makeBuilder().buildCompressed(false);
+            if (undirected.getEdgeCount() != 4 || undirected.getArcCount() != 8 ||
+                undirected.getOutDegree(undirected.getIndex(2)) != 3 || undirected.getInDegree(undirected.getIndex(2)) != 3) {
+                throw std::runtime_error("Incorrect undirected snapshot");
+            }
+
+            DirectedGraph<int, int> graph;
+            graph.addEdge(graph.createVertex(1), graph.createVertex(3), 1);
+            graph.addEdge(graph.createVertex(2), graph.createVertex(3), 1);
+            auto copy = CompressedGraph<int, int>::fromGraph(&graph);
+            if (copy.getVertexCount() != 3 || copy.getEdgeCount() != 2 || copy.getInDegree(copy.getIndex(3)) != 2) {
+                throw std::runtime_error("Incorrect snapshot of an existing graph");
+            }
+        });
+
+        runner.expectNoException("GraphBuilder::Parallel build matches sequential", []() {
+            GraphBuilder<int, int> builder;
+            std::mt19937 generator(7);
+            std::uniform_int_distribution<int> vertexDist(0, 999);
+            for (int i = 0; i < 200000; ++i) {
+                builder.addEdge(vertexDist(generator), vertexDist(generator), i);
+            }
+            auto sequential = builder.buildCompressed(true);
+            ThreadPool pool(4);
+            builder.setThreadPool(&pool);
+            auto parallel = builder.buildCompressed(true);
+            if (sequential.getOutOffsets() != parallel.getOutOffsets() || sequential.getOutTargets() != parallel.getOutTargets() ||
+                sequential.getOutWeights() != parallel.getOutWeights() || sequential.getInSources() != parallel.getInSources()) {
+                throw std::runtime_error("Parallel snapshot differs from sequential");
+            }
+            auto graph = builder.buildDirected();
+            auto vertex = graph.findVertex(sequential.getId(0));
+            if (vertex->getOutgoingEdges().getLength() != static_cast<int>(sequential.getOutDegree(0))) {
+                throw std::runtime_error("Parallel graph build has incorrect degree");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("GraphBuilder::Unknown vertex in snapshot", [&]() {
+            makeBuilder().buildCompressed().getIndex(42);
+        });
+    }
+
+    void testBFSAlgorithm() {
+        TestRunner runner;
+
+        // Эталонные расстояния обычной очередью
+        auto referenceDistances = [](const CompressedGraph<int, int>& graph, int source) {
+            std::vector<int> distances(graph.getVertexCount(), -1);
+            std::vector<int> queue{source};
+            distances[source] = 0;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                for (int neighbor : graph.getOutNeighbors(queue[head])) {
+                    if (distances[neighbor] == -1) {
+                        distances[neighbor] = distances[queue[head]] + 1;
+                        queue.push_back(neighbor);
+                    }
+                }
+            }
+            return distances;
+        };
+
+        // Предок каждой достигнутой вершины должен быть на уровень ближе и соединен с ней дугой
+        auto checkParents = [](const CompressedGraph<int, int>& graph, const BFSResult& result, int source) {
+            for (int v = 0; v < graph.getVertexCount(); ++v) {
+                int parent = result.parents[v];
+                if (v == source || result.distances[v] == -1) {
+                    if (parent != -1) throw std::runtime_error("Unexpected parent");
+                    continue;
+                }
+                auto neighbors = graph.getOutNeighbors(parent);
+                if (result.distances[parent] + 1 != result.distances[v] ||
+                    std::find(neighbors.begin(), neighbors.end(), v) == neighbors.end()) {
+                    throw std::runtime_error("Incorrect parent");
+                }
+            }
+        };
+
+        runner.expectNoException("BFSAlgorithm::Distances in directed graph", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            auto v5 = graph.createVertex(5);
+            graph.addEdge(v1, v2, 10);
+            graph.addEdge(v2, v3, 10);
+            graph.addEdge(v1, v3, 100);
+            graph.addEdge(v3, v4, 1);
+            graph.addEdge(v5, v1, 1);
+
+            BFSAlgorithm<int, int> bfs;
+            auto result = bfs.execute(&graph, v1);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            auto distance = [&](int id) { return result->distances[snapshot.getIndex(id)]; };
+            if (distance(1) != 0 || distance(2) != 1 || distance(3) != 1 || distance(4) != 2 || distance(5) != -1) {
+                throw std::runtime_error("Incorrect hop distances");
+            }
+            if (result->parents[snapshot.getIndex(4)] != snapshot.getIndex(3) || result->reachedCount != 4) {
+                throw std::runtime_error("Incorrect BFS tree");
+            }
+        });
+
+        runner.expectNoException("BFSAlgorithm::Undirected graph", []() {
+            UndirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            graph.addEdge(v2, v1, 1);
+            graph.addEdge(v3, v2, 1);
+
+            BFSAlgorithm<int, int> bfs;
+            auto result = bfs.execute(&graph, v1);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            if (result->distances[snapshot.getIndex(3)] != 2 || result->reachedCount != 3) {
+                throw std::runtime_error("Undirected edges must be traversed both ways");
+            }
+        });
+
+        runner.expectNoException("BFSAlgorithm::Direction switch matches plain BFS", [&]() {
+            auto graph = createRandomDirectedGraphForTests(20000, 200000, 11);
+            BFSAlgorithm<int, int> bfs;
+            BFSResult result = bfs.run(graph, 0);
+            if (result.distances != referenceDistances(graph, 0)) {
+                throw std::runtime_error("Direction-optimizing BFS differs from plain BFS");
+            }
+            if (result.bottomUpSteps == 0) {
+                throw std::runtime_error("Dense graph must use bottom-up steps");
+            }
+            checkParents(graph, result, 0);
+        });
+
+        runner.expectNoException("BFSAlgorithm::Parallel BFS matches sequential", [&]() {
+            auto graph = createRandomDirectedGraphForTests(50000, 400000, 3);
+            ThreadPool pool(4);
+            BFSAlgorithm<int, int> sequential;
+            BFSAlgorithm<int, int> parallel(&pool);
+            for (int source : {0, 17, 49999}) {
+                BFSResult expected = sequential.run(graph, source);
+                BFSResult actual = parallel.run(graph, source);
+                if (expected.distances != actual.distances || expected.reachedCount != actual.reachedCount) {
+                    throw std::runtime_error("Parallel BFS differs from sequential");
+                }
+                checkParents(graph, actual, source);
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("BFSAlgorithm::Null start vertex", []() {
+            DirectedGraph<int, int> graph;
+            graph.createVertex(1);
+            BFSAlgorithm<int, int> bfs;
+            bfs.execute(&graph, nullptr);
+        });
+
+        runner.expectException<std::invalid_argument>("BFSAlgorithm::Non-positive switch parameter", []() {
+            BFSAlgorithm<int, int> bfs;
+            bfs.setSwitchParameters(0, 18);
+        });
+    }
+
+    void testPageRankAlgorithm() {
+        TestRunner runner;
+
+        auto checkSum = [](const std::vector<double>& ranks) {
+            double total = 0;
+            for (double rank : ranks) total += rank;
+            if (std::abs(total - 1.0) > 1e-9) {
+                throw std::runtime_error("Ranks must sum to 1");
+            }
+        };
+
+        runner.expectNoException("PageRankAlgorithm::Cycle and dangling vertex", [&]() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            graph.addEdge(v1, v2, 1);
+            graph.addEdge(v2, v3, 1);
+            graph.addEdge(v3, v1, 1);
+            PageRankAlgorithm<int, int> pageRank;
+            auto cycle = pageRank.execute(&graph);
+            for (double rank : cycle->ranks) {
+                if (std::abs(rank - 1.0 / 3) > 1e-9) throw std::runtime_error("Cycle ranks must be equal");
+            }
+
+            // 1 -> 2, вершина 2 висячая: r1 = 0.15 / 2 + 0.85 * r2 / 2, r2 = r1 + 0.85 * r1, то есть r2 = 1.85 * r1
+            DirectedGraph<int, int> chain;
+            auto a = chain.createVertex(1);
+            auto b = chain.createVertex(2);
+            chain.addEdge(a, b, 1);
+            auto result = pageRank.execute(&chain);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&chain);
+            double ra = result->ranks[snapshot.getIndex(1)];
+            double rb = result->ranks[snapshot.getIndex(2)];
+            if (!result->converged || std::abs(rb / ra - 1.85) > 1e-6) {
+                throw std::runtime_error("Incorrect ranks with a dangling vertex");
+            }
+            checkSum(result->ranks);
+        });
+
+        runner.expectNoException("PageRankAlgorithm::Pull matches push on random graph", [&]() {
+            auto graph = createRandomDirectedGraphForTests(5000, 30000, 5);
+            PageRankAlgorithm<int, int> pageRank;
+            pageRank.setTolerance(1e-12);
+            PageRankResult result = pageRank.run(graph);
+            checkSum(result.ranks);
+
+            // Эталон: проталкивание по списку дуг
+            int n = graph.getVertexCount();
+            std::vector<double> rank(n, 1.0 / n);
+            for (int iteration = 0; iteration < 200; ++iteration) {
+                std::vector<double> next(n, 0.0);
+                double danglingMass = 0;
+                for (int u = 0; u < n; ++u) {
+                    if (graph.getOutDegree(u) == 0) {
+                        danglingMass += rank[u];
+                        continue;
+                    }
+                    for (int v : graph.getOutNeighbors(u)) {
+                        next[v] += 0.85 * rank[u] / graph.getOutDegree(u);
+                    }
+                }
+                for (int v = 0; v < n; ++v) {
+                    next[v] += (0.15 + 0.85 * danglingMass) / n;
+                }
+                rank.swap(next);
+            }
+            for (int v = 0; v < n; ++v) {
+                if (std::abs(rank[v] - result.ranks[v]) > 1e-10) {
+                    throw std::runtime_error("Pull PageRank differs from push");
+                }
+            }
+
+            ThreadPool pool(4);
+            PageRankAlgorithm<int, int> parallel(&pool);
+            parallel.setTolerance(1e-12);
+            if (parallel.run(graph).ranks != result.ranks) {
+                throw std::runtime_error("Parallel PageRank must match sequential exactly");
+            }
+        });
+
+        runner.expectNoException("PageRankAlgorithm::Personalized PageRank", [&]() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            graph.addEdge(v1, v2, 1);
+            graph.addEdge(v2, v1, 1);
+            graph.addEdge(v3, v4, 1);
+            graph.addEdge(v4, v3, 1);
+            graph.addEdge(v3, v1, 1);
+            PageRankAlgorithm<int, int> pageRank;
+            auto result = pageRank.execute(&graph, v1);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            if (result->ranks[snapshot.getIndex(3)] != 0 || result->ranks[snapshot.getIndex(4)] != 0 ||
+                result->ranks[snapshot.getIndex(1)] <= result->ranks[snapshot.getIndex(2)]) {
+                throw std::runtime_error("Personalized ranks must stay in the part reachable from the seed");
+            }
+            checkSum(result->ranks);
+
+            // Тематический вектор с единственной ненулевой вершиной совпадает с персонализацией по ней
+            std::vector<double> topic(4, 0.0);
+            topic[snapshot.getIndex(1)] = 2.5;
+            if (pageRank.run(snapshot, topic).ranks != result->ranks) {
+                throw std::runtime_error("Topic-sensitive and personalized PageRank must share the engine");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("PageRankAlgorithm::Invalid damping", []() {
+            PageRankAlgorithm<int, int> pageRank;
+            pageRank.setDamping(1.0);
+        });
+
+        runner.expectException<std::invalid_argument>("PageRankAlgorithm::Negative teleport weight", []() {
+            CompressedGraph<int, int> graph(true, {1, 2}, {0, 1, 1}, {1}, {1}, {0, 0, 1}, {0}, {1});
+            std::vector<double> teleport = {1.0, -1.0};
+            PageRankAlgorithm<int, int>().run(graph, teleport);
+        });
+    }
+
+    void testTriangleCountingAlgorithm() {
+        TestRunner runner;
+
+        runner.expectNoException("TriangleCountingAlgorithm::Complete graph K4", []() {
+            UndirectedGraph<int, int> graph;
+            std::vector<UndirectedGraph<int, int>::VertexType*> vertices;
+            for (int i = 0; i < 4; ++i) {
+                vertices.push_back(graph.createVertex(i));
+            }
+            for (int i = 0; i < 4; ++i) {
+                for (int j = i + 1; j < 4; ++j) {
+                    graph.addEdge(vertices[i], vertices[j], 1);
+                }
+            }
+            TriangleCountingAlgorithm<int, int> counter;
+            auto result = counter.execute(&graph);
+            if (result->totalTriangles != 4 || result->averageClustering != 1.0) {
+                throw std::runtime_error("K4 has 4 triangles and clustering 1");
+            }
+            for (long long triangles : result->triangles) {
+                if (triangles != 3) throw std::runtime_error("Each vertex of K4 is in 3 triangles");
+            }
+        });
+
+        runner.expectNoException("TriangleCountingAlgorithm::Multi-edges, self-loops and leaves", []() {
+            // Треугольник 1-2-3 с кратным ребром и петлей, вершина 4 - лист
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 1);
+            builder.addEdge(2, 1, 1);
+            builder.addEdge(2, 3, 1);
+            builder.addEdge(3, 1, 1);
+            builder.addEdge(3, 3, 1);
+            builder.addEdge(3, 4, 1);
+            auto graph = builder.buildCompressed(false);
+            TriangleCountResult result = TriangleCountingAlgorithm<int, int>().run(graph);
+            if (result.totalTriangles != 1 || result.triangles[graph.getIndex(4)] != 0 ||
+                result.clustering[graph.getIndex(1)] != 1.0 ||
+                std::abs(result.clustering[graph.getIndex(3)] - 1.0 / 3) > 1e-12 ||
+                result.clustering[graph.getIndex(4)] != 0.0) {
+                throw std::runtime_error("Incorrect counts with duplicate edges");
+            }
+        });
+
+        runner.expectNoException("TriangleCountingAlgorithm::Matches brute force with hubs", []() {
+            const int n = 400;
+            std::mt19937 generator(21);
+            std::uniform_int_distribution<int> vertexDist(0, n - 1);
+            std::set<std::pair<int, int>> edges;
+            GraphBuilder<int, int> builder(n);
+            for (int v = 0; v < n; ++v) {
+                builder.addVertex(v);
+            }
+            auto addEdge = [&](int a, int b) {
+                if (a == b || edges.count({std::min(a, b), std::max(a, b)})) return;
+                edges.insert({std::min(a, b), std::max(a, b)});
+                builder.addEdge(a, b, 1);
+            };
+            for (int i = 0; i < 6000; ++i) {
+                addEdge(vertexDist(generator), vertexDist(generator));
+            }
+            // Хабы дают сильно различающиеся длины списков и включают галопирующее пересечение
+            for (int v = 0; v < n; ++v) {
+                addEdge(0, v);
+                addEdge(1, v);
+            }
+            auto graph = builder.buildCompressed(false);
+
+            std::vector<long long> expected(n, 0);
+            for (const auto& [a, b] : edges) {
+                for (int c = b + 1; c < n; ++c) {
+                    if (edges.count({a, c}) && edges.count({b, c})) {
+                        ++expected[a];
+                        ++expected[b];
+                        ++expected[c];
+                    }
+                }
+            }
+
+            TriangleCountResult sequential = TriangleCountingAlgorithm<int, int>().run(graph);
+            for (int v = 0; v < n; ++v) {
+                if (sequential.triangles[graph.getIndex(v)] != expected[v]) {
+                    throw std::runtime_error("Triangle count differs from brute force");
+                }
+            }
+            ThreadPool pool(4);
+            TriangleCountResult parallel = TriangleCountingAlgorithm<int, int>(&pool).run(graph);
+            if (parallel.triangles != sequential.triangles || parallel.clustering != sequential.clustering) {
+                throw std::runtime_error("Parallel triangle count differs from sequential");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("TriangleCountingAlgorithm::Directed graph", []() {
+            DirectedGraph<int, int> graph;
+            graph.createVertex(1);
+            TriangleCountingAlgorithm<int, int>().execute(&graph);
+        });
+    }
+
+    void testKCoreAlgorithm() {
+        TestRunner runner;
+
+        runner.expectNoException("KCoreAlgorithm::Clique with a tail", []() {
+            // K4 на вершинах 1..4, цепочка 4 - 5 - 6 и изолированная вершина 7
+            UndirectedGraph<int, int> graph;
+            std::vector<UndirectedGraph<int, int>::VertexType*> vertices;
+            for (int i = 1; i <= 7; ++i) {
+                vertices.push_back(graph.createVertex(i));
+            }
+            for (int i = 0; i < 4; ++i) {
+                for (int j = i + 1; j < 4; ++j) {
+                    graph.addEdge(vertices[i], vertices[j], 1);
+                }
+            }
+            graph.addEdge(vertices[3], vertices[4], 1);
+            graph.addEdge(vertices[4], vertices[5], 1);
+            graph.addEdge(vertices[5], vertices[5], 1);
+
+            auto result = KCoreAlgorithm<int, int>().execute(&graph);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            std::vector<int> expected = {3, 3, 3, 3, 1, 1, 0};
+            for (int id = 1; id <= 7; ++id) {
+                if (result->coreNumbers[snapshot.getIndex(id)] != expected[id - 1]) {
+                    throw std::runtime_error("Incorrect core number");
+                }
+            }
+            if (result->maxCore != 3 || result->maxCoreVertices.size() != 4) {
+                throw std::runtime_error("Incorrect max core");
+            }
+        });
+
+        runner.expectNoException("KCoreAlgorithm::Parallel peeling matches sequential", []() {
+            const int n = 20000;
+            GraphBuilder<int, int> builder(n);
+            for (int v = 0; v < n; ++v) {
+                builder.addVertex(v);
+            }
+            std::mt19937 generator(33);
+            std::uniform_int_distribution<int> vertexDist(0, n - 1);
+            for (int i = 0; i < 100000; ++i) {
+                builder.addEdge(vertexDist(generator), vertexDist(generator), 1);
+            }
+            // Плотное ядро из 40 вершин
+            for (int a = 0; a < 40; ++a) {
+                for (int b = a + 1; b < 40; ++b) {
+                    builder.addEdge(a, b, 1);
+                }
+            }
+            auto graph = builder.buildCompressed(false);
+
+            KCoreResult sequential = KCoreAlgorithm<int, int>().run(graph);
+            ThreadPool pool(4);
+            KCoreResult parallel = KCoreAlgorithm<int, int>(&pool).run(graph);
+            if (sequential.coreNumbers != parallel.coreNumbers || sequential.maxCoreVertices != parallel.maxCoreVertices) {
+                throw std::runtime_error("Parallel k-core differs from sequential");
+            }
+
+            // Каждая вершина k-ядра имеет не меньше k соседей внутри ядра
+            SortedAdjacency<int, int> adjacency(graph);
+            for (int v = 0; v < n; ++v) {
+                int inside = 0;
+                for (int u : adjacency.getNeighbors(v)) {
+                    inside += sequential.coreNumbers[u] >= sequential.coreNumbers[v] ? 1 : 0;
+                }
+                if (inside < sequential.coreNumbers[v]) {
+                    throw std::runtime_error("Vertex has too few neighbors in its core");
+                }
+            }
+            if (sequential.maxCore < 39) {
+                throw std::runtime_error("Dense block must be in the max core");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("KCoreAlgorithm::Directed graph", []() {
+            DirectedGraph<int, int> graph;
+            graph.createVertex(1);
+            KCoreAlgorithm<int, int>().execute(&graph);
+        });
+    }
+
+    void testBetweennessCentralityAlgorithm() {
+        TestRunner runner;
+
+        runner.expectNoException("BetweennessCentralityAlgorithm::Undirected path", []() {
+            UndirectedGraph<int, int> graph;
+            std::vector<UndirectedGraph<int, int>::VertexType*> vertices;
+            for (int i = 0; i < 5; ++i) {
+                vertices.push_back(graph.createVertex(i));
+            }
+            for (int i = 0; i + 1 < 5; ++i) {
+                graph.addEdge(vertices[i], vertices[i + 1], 1);
+            }
+            auto result = BetweennessCentralityAlgorithm<int, int>().execute(&graph);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            std::vector<double> expected = {0, 3, 4, 3, 0};
+            for (int id = 0; id < 5; ++id) {
+                if (std::abs(result->centrality[snapshot.getIndex(id)] - expected[id]) > 1e-12) {
+                    throw std::runtime_error("Incorrect betweenness on a path");
+                }
+            }
+        });
+
+        runner.expectNoException("BetweennessCentralityAlgorithm::Directed graph with weights", []() {
+            // 1 -> 2 -> 4 короче, чем 1 -> 3 -> 4; без весов пути делились бы поровну
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            graph.addEdge(v1, v2, 1);
+            graph.addEdge(v2, v4, 1);
+            graph.addEdge(v1, v3, 2);
+            graph.addEdge(v3, v4, 2);
+            auto result = BetweennessCentralityAlgorithm<int, int>().execute(&graph);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            if (result->centrality[snapshot.getIndex(2)] != 1.0 || result->centrality[snapshot.getIndex(3)] != 0.0) {
+                throw std::runtime_error("Weighted shortest paths must be used");
+            }
+
+            DirectedGraph<int, int> unweighted;
+            auto u1 = unweighted.createVertex(1);
+            auto u2 = unweighted.createVertex(2);
+            auto u3 = unweighted.createVertex(3);
+            auto u4 = unweighted.createVertex(4);
+            unweighted.addEdge(u1, u2, 7);
+            unweighted.addEdge(u2, u4, 7);
+            unweighted.addEdge(u1, u3, 7);
+            unweighted.addEdge(u3, u4, 7);
+            auto split = BetweennessCentralityAlgorithm<int, int>().execute(&unweighted);
+            auto splitSnapshot = CompressedGraph<int, int>::fromGraph(&unweighted);
+            if (split->centrality[splitSnapshot.getIndex(2)] != 0.5 || split->centrality[splitSnapshot.getIndex(3)] != 0.5) {
+                throw std::runtime_error("Equal shortest paths must share the dependency");
+            }
+        });
+
+        runner.expectNoException("BetweennessCentralityAlgorithm::Parallel matches sequential", [&]() {
+            ThreadPool pool(4);
+            for (bool weighted : {false, true}) {
+                auto graph = createRandomUndirectedGraphForTests(600, 2400, 9, weighted ? 4 : 1);
+                BetweennessResult sequential = BetweennessCentralityAlgorithm<int, int>().run(graph);
+                BetweennessResult parallel = BetweennessCentralityAlgorithm<int, int>(&pool).run(graph);
+                for (int v = 0; v < graph.getVertexCount(); ++v) {
+                    if (std::abs(sequential.centrality[v] - parallel.centrality[v]) > 1e-6 * (1 + sequential.centrality[v])) {
+                        throw std::runtime_error("Parallel betweenness differs from sequential");
+                    }
+                }
+            }
+        });
+
+        runner.expectNoException("BetweennessCentralityAlgorithm::Sampling stays within error bound", [&]() {
+            auto graph = createRandomUndirectedGraphForTests(500, 1500, 4);
+            BetweennessResult exact = BetweennessCentralityAlgorithm<int, int>().run(graph);
+            BetweennessCentralityAlgorithm<int, int> sampler;
+            sampler.setSampleCount(400);
+            sampler.setSeed(12);
+            BetweennessResult approximate = sampler.run(graph);
+            if (approximate.exact || approximate.sourceCount != 400 || !(approximate.errorBound > 0)) {
+                throw std::runtime_error("Incorrect approximation metadata");
+            }
+            for (int v = 0; v < graph.getVertexCount(); ++v) {
+                if (std::abs(exact.centrality[v] - approximate.centrality[v]) > approximate.errorBound) {
+                    throw std::runtime_error("Sampled betweenness is outside the error bound");
+                }
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("BetweennessCentralityAlgorithm::Negative weight", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            graph.addEdge(v1, v2, 1);
+            graph.addEdge(v2, v1, -1);
+            BetweennessCentralityAlgorithm<int, int>().execute(&graph);
+        });
+
+        // Одинаковые неположительные веса не должны молча сводиться к обходу в ширину
+        runner.expectException<std::invalid_argument>("BetweennessCentralityAlgorithm::Uniform zero weights", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            graph.addEdge(v1, v2, 0);
+            graph.addEdge(v2, v3, 0);
+            BetweennessCentralityAlgorithm<int, int>().execute(&graph);
+        });
+
+        runner.expectException<std::invalid_argument>("BetweennessCentralityAlgorithm::Uniform negative weights", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            graph.addEdge(v1, v2, -2);
+            graph.addEdge(v2, v1, -2);
+            BetweennessCentralityAlgorithm<int, int>().execute(&graph);
+        });
+    }
+
+    void testFloydWarshallAlgorithm() {
+        TestRunner runner;
+
+        // Эталон: обычный Флойд-Уоршелл по матрице
+        auto referenceDistances = [](const CompressedGraph<int, int>& graph) {
+            int n = graph.getVertexCount();
+            const int infinity = DistanceMatrix<int>::infinity();
+            std::vector<std::vector<int>> distance(n, std::vector<int>(n, infinity));
+            for (int u = 0; u < n; ++u) {
+                distance[u][u] = 0;
+                auto neighbors = graph.getOutNeighbors(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    distance[u][neighbors[i]] = std::min(distance[u][neighbors[i]], graph.getOutWeights(u)[i]);
+                }
+            }
+            for (int k = 0; k < n; ++k) {
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        if (distance[i][k] < infinity && distance[k][j] < infinity) {
+                            distance[i][j] = std::min(distance[i][j], distance[i][k] + distance[k][j]);
+                        }
+                    }
+                }
+            }
+            return distance;
+        };
+
+        runner.expectNoException("FloydWarshallAlgorithm::Small directed graph", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            graph.addEdge(v1, v2, 4);
+            graph.addEdge(v1, v3, 1);
+            graph.addEdge(v3, v2, -2);
+            graph.addEdge(v2, v4, 3);
+            auto matrix = FloydWarshallAlgorithm<int, int>().execute(&graph);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            auto distance = [&](int from, int to) { return matrix->get(snapshot.getIndex(from), snapshot.getIndex(to)); };
+            if (distance(1, 2) != -1 || distance(1, 4) != 2 || distance(3, 4) != 1 || distance(2, 2) != 0) {
+                throw std::runtime_error("Incorrect shortest distances");
+            }
+            if (matrix->isReachable(snapshot.getIndex(4), snapshot.getIndex(1))) {
+                throw std::runtime_error("Vertex 1 must be unreachable from 4");
+            }
+        });
+
+        runner.expectNoException("FloydWarshallAlgorithm::Blocked matches reference", [&]() {
+            // 150 вершин - несколько блоков и неполный последний блок
+            auto graph = createRandomPotentialGraphForTests(150, 1200, 17);
+            auto expected = referenceDistances(graph);
+            DistanceMatrix<int> sequential = FloydWarshallAlgorithm<int, int>().run(graph);
+            ThreadPool pool(4);
+            DistanceMatrix<int> parallel = FloydWarshallAlgorithm<int, int>(&pool).run(graph);
+            for (int i = 0; i < graph.getVertexCount(); ++i) {
+                for (int j = 0; j < graph.getVertexCount(); ++j) {
+                    if (sequential.get(i, j) != expected[i][j] || parallel.get(i, j) != expected[i][j]) {
+                        throw std::runtime_error("Blocked Floyd-Warshall differs from reference");
+                    }
+                }
+            }
+        });
+
+        runner.expectNoException("FloydWarshallAlgorithm::Double weights and binary export", []() {
+            GraphBuilder<double, int> builder;
+            builder.addEdge(1, 2, 0.5);
+            builder.addEdge(2, 3, 0.25);
+            builder.addVertex(4);
+            DistanceMatrix<double> matrix = FloydWarshallAlgorithm<double, int>().run(builder.buildCompressed(true));
+            if (matrix.get(0, 2) != 0.75 || matrix.isReachable(0, 3)) {
+                throw std::runtime_error("Incorrect double distances");
+            }
+
+            std::string path = (std::filesystem::temp_directory_path() / "floyd_warshall_test.bin").string();
+            matrix.writeBinary(path);
+            DistanceMatrix<double> loaded = DistanceMatrix<double>::readBinary(path);
+            std::filesystem::remove(path);
+            for (int i = 0; i < 4; ++i) {
+                for (int j = 0; j < 4; ++j) {
+                    if (loaded.get(i, j) != matrix.get(i, j)) {
+                        throw std::runtime_error("Exported matrix differs after reading back");
+                    }
+                }
+            }
+        });
+
+        runner.expectException<std::runtime_error>("FloydWarshallAlgorithm::Negative cycle", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 1);
+            builder.addEdge(2, 3, -3);
+            builder.addEdge(3, 1, 1);
+            FloydWarshallAlgorithm<int, int>().run(builder.buildCompressed(true));
+        });
+
+        runner.expectException<std::runtime_error>("FloydWarshallAlgorithm::Reading matrix of another type", []() {
+            std::string path = (std::filesystem::temp_directory_path() / "floyd_warshall_type.bin").string();
+            DistanceMatrix<int>(3).writeBinary(path);
+            try {
+                DistanceMatrix<double>::readBinary(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+        });
+    }
+
+    void testBellmanFordAlgorithm() {
+        TestRunner runner;
+        using BellmanFord = BellmanFordAlgorithm<int, int>;
+
+        // Расстояние из FW переводится в соглашение Беллмана-Форда о недостижимых вершинах
+        auto expectedDistance = [](const DistanceMatrix<int>& matrix, int from, int to) {
+            return matrix.isReachable(from, to) ? matrix.get(from, to) : BellmanFordResult<int, int>::unreachable();
+        };
+
+        runner.expectNoException("BellmanFordAlgorithm::Negative weights and path", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            graph.createVertex(5);
+            graph.addEdge(v1, v2, 4);
+            graph.addEdge(v1, v3, 1);
+            graph.addEdge(v3, v2, -2);
+            graph.addEdge(v2, v4, 3);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+
+            for (auto mode : {BellmanFord::Mode::BellmanFord, BellmanFord::Mode::Spfa}) {
+                BellmanFord algorithm;
+                algorithm.setMode(mode);
+                auto result = algorithm.execute(&graph, v1, v4);
+                auto distance = [&](int id) { return result->distances[snapshot.getIndex(id)]; };
+                if (result->hasNegativeCycle || distance(2) != -1 || distance(4) != 2 ||
+                    distance(5) != BellmanFordResult<int, int>::unreachable()) {
+                    throw std::runtime_error("Incorrect shortest distances");
+                }
+                std::vector<int> expectedPath = {1, 3, 2, 4};
+                if (result->path.getLength() != expectedPath.size()) {
+                    throw std::runtime_error("Incorrect shortest path length");
+                }
+                for (size_t i = 0; i < expectedPath.size(); ++i) {
+                    if (result->path.getVertices().get(i)->getId() != expectedPath[i]) {
+                        throw std::runtime_error("Incorrect vertex in shortest path");
+                    }
+                }
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Variants match Floyd-Warshall", [&]() {
+            auto graph = createRandomPotentialGraphForTests(300, 2400, 23);
+            DistanceMatrix<int> matrix = FloydWarshallAlgorithm<int, int>().run(graph);
+            ThreadPool pool(4);
+            BellmanFord sequential;
+            BellmanFord parallel(&pool);
+            BellmanFord spfa;
+            spfa.setMode(BellmanFord::Mode::Spfa);
+            for (int source : {0, 57, 299}) {
+                for (const BellmanFord* algorithm : {&sequential, &parallel, &spfa}) {
+                    auto result = algorithm->run(graph, source);
+                    if (result.hasNegativeCycle) {
+                        throw std::runtime_error("False negative cycle");
+                    }
+                    for (int v = 0; v < graph.getVertexCount(); ++v) {
+                        if (result.distances[v] != expectedDistance(matrix, source, v)) {
+                            throw std::runtime_error("Bellman-Ford distance differs from Floyd-Warshall");
+                        }
+                        // Дерево предков согласовано с расстояниями
+                        int parent = result.parents[v];
+                        if (parent != -1 && result.distances[parent] > result.distances[v]) {
+                            bool tight = false;
+                            auto neighbors = graph.getOutNeighbors(parent);
+                            for (size_t i = 0; i < neighbors.size(); ++i) {
+                                tight = tight || (neighbors[i] == v &&
+                                                  result.distances[parent] + graph.getOutWeights(parent)[i] ==
+                                                      result.distances[v]);
+                            }
+                            if (!tight) {
+                                throw std::runtime_error("Parent arc is not tight");
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Negative cycle as GraphPath", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            auto v3 = graph.createVertex(3);
+            auto v4 = graph.createVertex(4);
+            auto v5 = graph.createVertex(5);
+            graph.addEdge(v1, v2, 1);
+            graph.addEdge(v2, v3, 2);
+            graph.addEdge(v3, v4, -4);
+            graph.addEdge(v4, v2, 1);
+            graph.addEdge(v4, v5, 7);
+            ThreadPool pool(2);
+            for (int variant = 0; variant < 3; ++variant) {
+                BellmanFord algorithm(variant == 1 ? &pool : nullptr);
+                if (variant == 2) {
+                    algorithm.setMode(BellmanFord::Mode::Spfa);
+                }
+                auto result = algorithm.execute(&graph, v1, v5);
+                const auto& cycle = result->negativeCycle;
+                if (!result->hasNegativeCycle || cycle.getLength() != 4 ||
+                    cycle.getStartVertex()->getId() != cycle.getEndVertex()->getId()) {
+                    throw std::runtime_error("Negative cycle is not reported");
+                }
+                if (!cycle.containsVertex(v2) || !cycle.containsVertex(v3) || !cycle.containsVertex(v4)) {
+                    throw std::runtime_error("Incorrect negative cycle vertices");
+                }
+                // Соседние вершины цикла соединены дугами графа
+                for (size_t i = 0; i + 1 < cycle.getLength(); ++i) {
+                    auto from = cycle.getVertices().get(i);
+                    auto to = cycle.getVertices().get(i + 1);
+                    if (!graph.hasEdge(from, to)) {
+                        throw std::runtime_error("Negative cycle is not a path in the graph");
+                    }
+                }
+                if (result->path.getLength() != 0) {
+                    throw std::runtime_error("Path must be empty when a negative cycle is reachable");
+                }
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Zero-weight parent cycle does not hide a negative one", []() {
+            // Вершины 0 и 1 - цикл нулевого веса, 2 -> 3 -> 4 -> 2 - отрицательный. Цикл нулевого веса
+            // идет первым по индексам, но отрицательный все равно должен быть найден
+            GraphBuilder<int, int> builder;
+            for (int v = 0; v < 5; ++v) {
+                builder.addVertex(v);
+            }
+            builder.addEdge(0, 1, 3);
+            builder.addEdge(1, 0, -3);
+            builder.addEdge(2, 3, 1);
+            builder.addEdge(3, 4, 1);
+            builder.addEdge(4, 2, -5);
+            builder.addEdge(1, 2, 0);
+            auto graph = builder.buildCompressed(true);
+            std::vector<int> parents{1, 0, 4, 2, 3};
+            auto cycle = BellmanFord::findNegativeParentCycle(graph, parents);
+            if (cycle.size() != 4 || cycle.front() != cycle.back() ||
+                std::set<int>(cycle.begin(), cycle.end()) != std::set<int>{2, 3, 4}) {
+                throw std::runtime_error("Negative parent cycle behind a zero-weight one is not found");
+            }
+            if (!BellmanFord::findNegativeParentCycle(graph, {1, 0, -1, 2, 3}).empty()) {
+                throw std::runtime_error("Zero-weight parent cycle reported as negative");
+            }
+
+            ThreadPool pool(2);
+            for (int variant = 0; variant < 3; ++variant) {
+                BellmanFord algorithm(variant == 1 ? &pool : nullptr);
+                if (variant == 2) {
+                    algorithm.setMode(BellmanFord::Mode::Spfa);
+                }
+                auto result = algorithm.run(graph, 0);
+                if (!result.hasNegativeCycle ||
+                    std::set<int>(result.cycle.begin(), result.cycle.end()) != std::set<int>{2, 3, 4}) {
+                    throw std::runtime_error("Negative cycle next to a zero-weight cycle is not reported");
+                }
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Unreachable negative cycle is ignored", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 5);
+            builder.addEdge(3, 4, -2);
+            builder.addEdge(4, 3, 1);
+            auto result = BellmanFord().run(builder.buildCompressed(true), 0);
+            if (result.hasNegativeCycle || result.distances[1] != 5) {
+                throw std::runtime_error("Unreachable cycle must not affect the result");
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Johnson reweighting", [&]() {
+            auto graph = createRandomPotentialGraphForTests(200, 1600, 29);
+            DistanceMatrix<int> matrix = FloydWarshallAlgorithm<int, int>().run(graph);
+            JohnsonReweighting<int, int> johnson(graph);
+            const auto& reweighted = johnson.getReweightedGraph();
+            for (int weight : reweighted.getOutWeights()) {
+                if (weight < 0) {
+                    throw std::runtime_error("Reweighted graph has a negative weight");
+                }
+            }
+            for (int source = 0; source < graph.getVertexCount(); source += 13) {
+                auto distances = johnson.distancesFrom(source);
+                for (int v = 0; v < graph.getVertexCount(); ++v) {
+                    if (distances[v] != expectedDistance(matrix, source, v)) {
+                        throw std::runtime_error("Johnson distance differs from Floyd-Warshall");
+                    }
+                }
+            }
+
+            // Перевзвешенный снимок, собранный в DirectedGraph, годится для DijkstraAlgorithm
+            GraphBuilder<int, int> builder(reweighted.getVertexCount());
+            for (int v = 0; v < reweighted.getVertexCount(); ++v) {
+                builder.addVertex(reweighted.getId(v));
+            }
+            for (int u = 0; u < reweighted.getVertexCount(); ++u) {
+                auto neighbors = reweighted.getOutNeighbors(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    builder.addEdge(reweighted.getId(u), reweighted.getId(neighbors[i]), reweighted.getOutWeights(u)[i]);
+                }
+            }
+            auto directed = builder.buildDirected();
+            const auto& potentials = johnson.getPotentials();
+            auto dijkstra = DijkstraAlgorithm<int, int>().execute(&directed, directed.getVertexById(0), nullptr);
+            auto vertices = directed.getVertices();
+            for (int i = 0; i < vertices.getLength(); ++i) {
+                int v = graph.getIndex(vertices.get(i)->getId());
+                int reduced = dijkstra->first.get(i);
+                int restored = reduced == std::numeric_limits<int>::max() ? BellmanFordResult<int, int>::unreachable()
+                                                                          : reduced - potentials[0] + potentials[v];
+                if (restored != expectedDistance(matrix, 0, v)) {
+                    throw std::runtime_error("Dijkstra on reweighted graph differs from Floyd-Warshall");
+                }
+            }
+        });
+
+        runner.expectNoException("BellmanFordAlgorithm::Johnson on undirected graph", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 4);
+            builder.addEdge(2, 3, 1);
+            builder.addEdge(1, 3, 7);
+            builder.addVertex(4);
+            auto graph = builder.buildCompressed(false);
+            auto distances = JohnsonReweighting<int, int>(graph).distancesFrom(graph.getIndex(3));
+            if (distances[graph.getIndex(1)] != 5 || distances[graph.getIndex(2)] != 1 || distances[graph.getIndex(3)] != 0 ||
+                distances[graph.getIndex(4)] != JohnsonReweighting<int, int>::unreachable()) {
+                throw std::runtime_error("Incorrect undirected Johnson distances");
+            }
+        });
+
+        runner.expectException<std::runtime_error>("BellmanFordAlgorithm::Johnson rejects negative cycle", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 1);
+            builder.addEdge(2, 3, -3);
+            builder.addEdge(3, 1, 1);
+            JohnsonReweighting<int, int> johnson(builder.buildCompressed(true));
+        });
+
+        runner.expectException<std::invalid_argument>("BellmanFordAlgorithm::Missing start vertex", []() {
+            DirectedGraph<int, int> graph;
+            graph.createVertex(1);
+            BellmanFord().execute(&graph, nullptr, nullptr);
+        });
+    }
+
+    void testMaxFlowAlgorithm() {
+        TestRunner runner;
+
+        // Эталон - Эдмондс-Карп по матрице пропускных способностей
+        auto referenceFlow = [](const CompressedGraph<int, int>& graph, int source, int sink) {
+            int n = graph.getVertexCount();
+            std::vector<std::vector<long long>> capacity(n, std::vector<long long>(n, 0));
+            for (int u = 0; u < n; ++u) {
+                auto neighbors = graph.getOutNeighbors(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    if (neighbors[i] != u) capacity[u][neighbors[i]] += graph.getOutWeights(u)[i];
+                }
+            }
+            long long total = 0;
+            while (true) {
+                std::vector<int> parent(n, -1);
+                parent[source] = source;
+                std::vector<int> queue{source};
+                for (size_t head = 0; head < queue.size() && parent[sink] == -1; ++head) {
+                    for (int v = 0; v < n; ++v) {
+                        if (parent[v] == -1 && capacity[queue[head]][v] > 0) {
+                            parent[v] = queue[head];
+                            queue.push_back(v);
+                        }
+                    }
+                }
+                if (parent[sink] == -1) return total;
+                long long delta = std::numeric_limits<long long>::max();
+                for (int v = sink; v != source; v = parent[v]) {
+                    delta = std::min(delta, capacity[parent[v]][v]);
+                }
+                for (int v = sink; v != source; v = parent[v]) {
+                    capacity[parent[v]][v] -= delta;
+                    capacity[v][parent[v]] += delta;
+                }
+                total += delta;
+            }
+        };
+
+        // Поток допустим, сохраняется в вершинах, и разрез насыщен
+        auto checkFlow = [](const CompressedGraph<int, int>& graph, const MaxFlowResult<int>& result, int source, int sink) {
+            int n = graph.getVertexCount();
+            std::vector<long long> balance(n, 0);
+            const auto& offsets = graph.getOutOffsets();
+            const auto& targets = graph.getOutTargets();
+            const auto& capacities = graph.getOutWeights();
+            for (int u = 0; u < n; ++u) {
+                for (size_t k = offsets[u]; k < offsets[u + 1]; ++k) {
+                    if (result.flows[k] < 0 || result.flows[k] > capacities[k]) {
+                        throw std::runtime_error("Flow violates capacity");
+                    }
+                    balance[u] -= result.flows[k];
+                    balance[targets[k]] += result.flows[k];
+                }
+            }
+            for (int v = 0; v < n; ++v) {
+                long long expected = v == sink ? result.flowValue : v == source ? -result.flowValue : 0;
+                if (balance[v] != expected) {
+                    throw std::runtime_error("Flow is not conserved at vertex " + std::to_string(v));
+                }
+            }
+
+            std::vector<char> inSource(n, 0);
+            for (int v : result.sourceSide) {
+                inSource[v] = 1;
+            }
+            if (!inSource[source] || inSource[sink]) {
+                throw std::runtime_error("Cut does not separate source and sink");
+            }
+            long long cut = 0;
+            for (int k : result.cutArcs) {
+                cut += capacities[k];
+            }
+            if (cut != result.flowValue) {
+                throw std::runtime_error("Cut capacity differs from flow value");
+            }
+        };
+
+        runner.expectNoException("MaxFlowAlgorithm::Textbook network", [&]() {
+            DirectedGraph<int, int> graph;
+            std::vector<IVertex<int, int>*> v;
+            for (int i = 0; i < 6; ++i) {
+                v.push_back(graph.createVertex(i));
+            }
+            graph.addEdge(v[0], v[1], 16);
+            graph.addEdge(v[0], v[2], 13);
+            graph.addEdge(v[2], v[1], 4);
+            graph.addEdge(v[1], v[3], 12);
+            graph.addEdge(v[3], v[2], 9);
+            graph.addEdge(v[2], v[4], 14);
+            graph.addEdge(v[4], v[3], 7);
+            graph.addEdge(v[3], v[5], 20);
+            graph.addEdge(v[4], v[5], 4);
+            auto result = MaxFlowAlgorithm<int, int>().execute(&graph, v[0], v[5]);
+            if (result->flowValue != 23) {
+                throw std::runtime_error("Incorrect max flow value: " + std::to_string(result->flowValue));
+            }
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            checkFlow(snapshot, *result, snapshot.getIndex(0), snapshot.getIndex(5));
+            std::set<int> sourceSide;
+            for (int index : result->sourceSide) {
+                sourceSide.insert(snapshot.getId(index));
+            }
+            if (sourceSide != std::set<int>{0, 1, 2, 4}) {
+                throw std::runtime_error("Incorrect min-cut source side");
+            }
+        });
+
+        runner.expectNoException("MaxFlowAlgorithm::Random networks match Edmonds-Karp", [&]() {
+            for (unsigned seed = 1; seed <= 20; ++seed) {
+                std::mt19937 generator(seed);
+                int n = 10 + static_cast<int>(seed) * 4;
+                std::uniform_int_distribution<int> vertexDist(0, n - 1);
+                std::uniform_int_distribution<int> capacityDist(0, 30);
+                GraphBuilder<int, int> builder(n);
+                for (int v = 0; v < n; ++v) {
+                    builder.addVertex(v);
+                }
+                for (int i = 0; i < n * 5; ++i) {
+                    builder.addEdge(vertexDist(generator), vertexDist(generator), capacityDist(generator));
+                }
+                auto graph = builder.buildCompressed(true);
+                for (double frequency : {0.5, 0.0}) {
+                    MaxFlowAlgorithm<int, int> maxFlow;
+                    maxFlow.setGlobalRelabelFrequency(frequency);
+                    auto result = maxFlow.run(graph, 0, n - 1);
+                    if (result.flowValue != referenceFlow(graph, 0, n - 1)) {
+                        throw std::runtime_error("Max flow differs from Edmonds-Karp for seed " + std::to_string(seed));
+                    }
+                    checkFlow(graph, result, 0, n - 1);
+                }
+            }
+        });
+
+        runner.expectNoException("MaxFlowAlgorithm::Undirected graph", [&]() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, 3);
+            builder.addEdge(2, 3, 5);
+            builder.addEdge(1, 3, 2);
+            builder.addEdge(3, 4, 4);
+            auto graph = builder.buildCompressed(false);
+            auto result = MaxFlowAlgorithm<int, int>().run(graph, graph.getIndex(1), graph.getIndex(4));
+            if (result.flowValue != 4 || result.flowValue != referenceFlow(graph, graph.getIndex(1), graph.getIndex(4))) {
+                throw std::runtime_error("Incorrect undirected max flow");
+            }
+        });
+
+        runner.expectException<std::runtime_error>("MaxFlowAlgorithm::Negative capacity", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(1, 2, -1);
+            MaxFlowAlgorithm<int, int>().run(builder.buildCompressed(true), 0, 1);
+        });
+
+        runner.expectException<std::invalid_argument>("MaxFlowAlgorithm::Source equals sink", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            MaxFlowAlgorithm<int, int>().execute(&graph, v1, v1);
+        });
+    }
+
+    void testBipartiteMatchingAlgorithm() {
+        TestRunner runner;
+
+        // Эталон - алгоритм Куна: увеличивающий путь из каждой вершины доли 0
+        auto referenceMatching = [](const CompressedGraph<int, int>& graph, const std::vector<int>& side) {
+            int n = graph.getVertexCount();
+            std::vector<int> mate(n, -1);
+            std::vector<int> visited(n, -1);
+            std::function<bool(int, int)> tryKuhn = [&](int u, int stamp) {
+                for (int v : graph.getOutNeighbors(u)) {
+                    if (visited[v] == stamp) continue;
+                    visited[v] = stamp;
+                    if (mate[v] == -1 || tryKuhn(mate[v], stamp)) {
+                        mate[v] = u;
+                        mate[u] = v;
+                        return true;
+                    }
+                }
+                return false;
+            };
+            int size = 0;
+            for (int u = 0; u < n; ++u) {
+                if (side[u] == 0 && tryKuhn(u, u)) ++size;
+            }
+            return size;
+        };
+
+        // Паросочетание согласовано, проходит по ребрам графа и соединяет разные доли
+        auto checkMatching = [](const CompressedGraph<int, int>& graph, const BipartiteMatchingResult& result) {
+            int matched = 0;
+            for (int u = 0; u < graph.getVertexCount(); ++u) {
+                int v = result.mate[u];
+                if (v == -1) continue;
+                auto neighbors = graph.getOutNeighbors(u);
+                if (result.mate[v] != u || result.side[u] == result.side[v] ||
+                    std::find(neighbors.begin(), neighbors.end(), v) == neighbors.end()) {
+                    throw std::runtime_error("Invalid matching");
+                }
+                ++matched;
+            }
+            if (matched != 2 * result.matchingSize) {
+                throw std::runtime_error("Matching size is inconsistent");
+            }
+        };
+
+        runner.expectNoException("BipartiteMatchingAlgorithm::Jobs and workers", [&]() {
+            UndirectedGraph<int, int> graph;
+            std::vector<IVertex<int, int>*> workers;
+            std::vector<IVertex<int, int>*> jobs;
+            for (int i = 0; i < 4; ++i) {
+                workers.push_back(graph.createVertex(i));
+                jobs.push_back(graph.createVertex(10 + i));
+            }
+            // Жадный выбор 0-10 мешает; максимум - 4
+            graph.addEdge(workers[0], jobs[0], 1);
+            graph.addEdge(workers[0], jobs[1], 1);
+            graph.addEdge(workers[1], jobs[0], 1);
+            graph.addEdge(workers[2], jobs[1], 1);
+            graph.addEdge(workers[2], jobs[2], 1);
+            graph.addEdge(workers[3], jobs[2], 1);
+            graph.addEdge(workers[3], jobs[3], 1);
+            auto result = BipartiteMatchingAlgorithm<int, int>().execute(&graph);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            if (!result->bipartite || result->matchingSize != 4) {
+                throw std::runtime_error("Incorrect maximum matching size");
+            }
+            checkMatching(snapshot, *result);
+        });
+
+        runner.expectNoException("BipartiteMatchingAlgorithm::Random graphs match Kuhn", [&]() {
+            for (unsigned seed = 1; seed <= 20; ++seed) {
+                std::mt19937 generator(seed);
+                int leftCount = 20 + static_cast<int>(seed) * 7;
+                int rightCount = 15 + static_cast<int>(seed) * 9;
+                std::uniform_int_distribution<int> leftDist(0, leftCount - 1);
+                std::uniform_int_distribution<int> rightDist(leftCount, leftCount + rightCount - 1);
+                GraphBuilder<int, int> builder(leftCount + rightCount);
+                for (int v = 0; v < leftCount + rightCount; ++v) {
+                    builder.addVertex(v);
+                }
+                for (int i = 0; i < 2 * (leftCount + rightCount); ++i) {
+                    builder.addEdge(leftDist(generator), rightDist(generator), 1);
+                }
+                auto graph = builder.buildCompressed(false);
+                for (bool greedy : {true, false}) {
+                    BipartiteMatchingAlgorithm<int, int> matching;
+                    matching.setGreedyInitialization(greedy);
+                    auto result = matching.run(graph);
+                    if (!result.bipartite || result.matchingSize != referenceMatching(graph, result.side)) {
+                        throw std::runtime_error("Matching differs from Kuhn for seed " + std::to_string(seed));
+                    }
+                    checkMatching(graph, result);
+                }
+            }
+        });
+
+        runner.expectNoException("BipartiteMatchingAlgorithm::Odd cycle is reported", []() {
+            // Цикл длины 5 и хвост; раскраска начинается с хвоста
+            GraphBuilder<int, int> builder;
+            builder.addEdge(0, 1, 1);
+            builder.addEdge(1, 2, 1);
+            builder.addEdge(2, 3, 1);
+            builder.addEdge(3, 4, 1);
+            builder.addEdge(4, 5, 1);
+            builder.addEdge(5, 1, 1);
+            builder.addEdge(5, 6, 1);
+            auto graph = builder.buildCompressed(false);
+            auto result = BipartiteMatchingAlgorithm<int, int>().run(graph);
+            const auto& cycle = result.oddCycle;
+            if (result.bipartite || cycle.size() < 2 || cycle.size() % 2 != 0 || cycle.front() != cycle.back()) {
+                throw std::runtime_error("Odd cycle is not reported");
+            }
+            for (size_t i = 0; i + 1 < cycle.size(); ++i) {
+                auto neighbors = graph.getOutNeighbors(cycle[i]);
+                if (std::find(neighbors.begin(), neighbors.end(), cycle[i + 1]) == neighbors.end()) {
+                    throw std::runtime_error("Odd cycle is not a cycle in the graph");
+                }
+            }
+            if (std::set<int>(cycle.begin(), cycle.end()) != std::set<int>{1, 2, 3, 4, 5}) {
+                throw std::runtime_error("Incorrect odd cycle vertices");
+            }
+        });
+
+        runner.expectNoException("BipartiteMatchingAlgorithm::Self-loop is an odd cycle", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(0, 1, 1);
+            builder.addEdge(1, 1, 1);
+            auto result = BipartiteMatchingAlgorithm<int, int>().run(builder.buildCompressed(false));
+            if (result.bipartite || result.oddCycle != std::vector<int>{1, 1}) {
+                throw std::runtime_error("Self-loop must be reported as an odd cycle");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("BipartiteMatchingAlgorithm::Directed graph", []() {
+            DirectedGraph<int, int> graph;
+            BipartiteMatchingAlgorithm<int, int>().execute(&graph);
+        });
+    }
+
+    void testGraphColoringAlgorithm() {
+        TestRunner runner;
+        using Coloring = GraphColoringAlgorithm<int, int>;
+        const std::vector<Coloring::Strategy> strategies = {
+            Coloring::Strategy::LargestFirst, Coloring::Strategy::SmallestLast, Coloring::Strategy::Dsatur,
+            Coloring::Strategy::Speculative, Coloring::Strategy::JonesPlassmann
+        };
+
+        // Соседи раскрашены в разные цвета, цвета лежат в [0, colorCount)
+        auto checkColoring = [](const CompressedGraph<int, int>& graph, const ColoringResult& result) {
+            for (int u = 0; u < graph.getVertexCount(); ++u) {
+                if (result.colors[u] < 0 || result.colors[u] >= result.colorCount) {
+                    throw std::runtime_error("Color is out of range");
+                }
+                for (int v : graph.getOutNeighbors(u)) {
+                    if (u != v && result.colors[u] == result.colors[v]) {
+                        throw std::runtime_error("Adjacent vertices share a color");
+                    }
+                }
+            }
+        };
+
+        runner.expectNoException("GraphColoringAlgorithm::Odd cycle and bipartite graph", [&]() {
+            // Цикл из 5 вершин требует 3 цвета, DSATUR находит ровно 2 для четного цикла
+            UndirectedGraph<int, int> cycle;
+            std::vector<IVertex<int, int>*> v;
+            for (int i = 0; i < 5; ++i) {
+                v.push_back(cycle.createVertex(i));
+            }
+            for (int i = 0; i < 5; ++i) {
+                cycle.addEdge(v[i], v[(i + 1) % 5], 1);
+            }
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&cycle);
+            for (auto strategy : strategies) {
+                Coloring coloring;
+                coloring.setStrategy(strategy);
+                auto result = coloring.execute(&cycle);
+                checkColoring(snapshot, *result);
+                if (result->colorCount != 3) {
+                    throw std::runtime_error("Odd cycle must use 3 colors");
+                }
+            }
+
+            GraphBuilder<int, int> builder;
+            for (int i = 0; i < 8; ++i) {
+                builder.addEdge(i, (i + 1) % 8, 1);
+            }
+            Coloring dsatur;
+            dsatur.setStrategy(Coloring::Strategy::Dsatur);
+            if (dsatur.run(builder.buildCompressed(false)).colorCount != 2) {
+                throw std::runtime_error("DSATUR must color an even cycle with 2 colors");
+            }
+        });
+
+        runner.expectNoException("GraphColoringAlgorithm::Random graph, all strategies", [&]() {
+            auto graph = createRandomUndirectedGraphForTests(3000, 3000 * 8, 31);
+            int degeneracy = KCoreAlgorithm<int, int>().run(graph).maxCore;
+
+            ThreadPool pool(4);
+            for (auto strategy : strategies) {
+                for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+                    Coloring coloring(threads);
+                    coloring.setStrategy(strategy);
+                    auto result = coloring.run(graph);
+                    checkColoring(graph, result);
+                    if (strategy == Coloring::Strategy::SmallestLast && result.colorCount > degeneracy + 1) {
+                        throw std::runtime_error("Smallest-last must use at most degeneracy + 1 colors");
+                    }
+                }
+            }
+
+            // Jones-Plassmann не зависит от числа потоков
+            Coloring sequential;
+            Coloring parallel(&pool);
+            sequential.setStrategy(Coloring::Strategy::JonesPlassmann);
+            parallel.setStrategy(Coloring::Strategy::JonesPlassmann);
+            if (sequential.run(graph).colors != parallel.run(graph).colors) {
+                throw std::runtime_error("Jones-Plassmann depends on the number of threads");
+            }
+        });
+
+        runner.expectNoException("GraphColoringAlgorithm::Complete graph and isolated vertices", [&]() {
+            GraphBuilder<int, int> builder;
+            for (int u = 0; u < 6; ++u) {
+                for (int v = u + 1; v < 6; ++v) {
+                    builder.addEdge(u, v, 1);
+                }
+            }
+            builder.addVertex(100);
+            builder.addEdge(101, 101, 1);
+            auto graph = builder.buildCompressed(false);
+            for (auto strategy : strategies) {
+                Coloring coloring;
+                coloring.setStrategy(strategy);
+                auto result = coloring.run(graph);
+                checkColoring(graph, result);
+                if (result.colorCount != 6 || result.colors[graph.getIndex(100)] != 0 ||
+                    result.colors[graph.getIndex(101)] != 0) {
+                    throw std::runtime_error("Incorrect coloring of complete graph");
+                }
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("GraphColoringAlgorithm::Directed graph", []() {
+            DirectedGraph<int, int> graph;
+            Coloring().execute(&graph);
+        });
+    }
+
+    void testLouvainAlgorithm() {
+        TestRunner runner;
+        using Louvain = LouvainAlgorithm<double, int>;
+
+        // Модулярность по определению: сумма по сообществам L(c) / m - (d(c) / 2m)^2
+        auto referenceModularity = [](const CompressedGraph<double, int>& graph, const std::vector<int>& community) {
+            std::map<int, double> inside;
+            std::map<int, double> degree;
+            double total = 0;
+            for (int u = 0; u < graph.getVertexCount(); ++u) {
+                auto neighbors = graph.getOutNeighbors(u);
+                auto weights = graph.getOutWeights(u);
+                for (size_t i = 0; i < neighbors.size(); ++i) {
+                    degree[community[u]] += weights[i];
+                    total += weights[i];
+                    if (community[neighbors[i]] == community[u]) {
+                        inside[community[u]] += weights[i];
+                    }
+                }
+            }
+            double q = 0;
+            for (const auto& [c, d] : degree) {
+                q += inside[c] / total - (d / total) * (d / total);
+            }
+            return q;
+        };
+
+        runner.expectNoException("LouvainAlgorithm::Two cliques joined by an edge", [&]() {
+            UndirectedGraph<double, int> graph;
+            std::vector<IVertex<double, int>*> v;
+            for (int i = 0; i < 10; ++i) {
+                v.push_back(graph.createVertex(i));
+            }
+            for (int group = 0; group < 2; ++group) {
+                for (int a = 0; a < 5; ++a) {
+                    for (int b = a + 1; b < 5; ++b) {
+                        graph.addEdge(v[group * 5 + a], v[group * 5 + b], 1.0);
+                    }
+                }
+            }
+            graph.addEdge(v[4], v[5], 1.0);
+
+            auto result = Louvain().execute(&graph);
+            auto snapshot = CompressedGraph<double, int>::fromGraph(&graph);
+            if (result->communityCount != 2 || result->levels.empty()) {
+                throw std::runtime_error("Two cliques must form two communities");
+            }
+            for (int i = 0; i < 10; ++i) {
+                int expected = result->communities[snapshot.getIndex(i < 5 ? 0 : 5)];
+                if (result->communities[snapshot.getIndex(i)] != expected) {
+                    throw std::runtime_error("Clique is split between communities");
+                }
+            }
+            // 2 * (10 / 21 - (21 / 42)^2) = 0.45238...
+            if (std::abs(result->modularity - referenceModularity(snapshot, result->communities)) > 1e-9 ||
+                std::abs(result->modularity - (20.0 / 21.0 - 0.5)) > 1e-9) {
+                throw std::runtime_error("Incorrect modularity");
+            }
+        });
+
+        runner.expectNoException("LouvainAlgorithm::Planted partition, levels", [&]() {
+            const int groups = 8;
+            const int groupSize = 50;
+            std::mt19937 generator(17);
+            std::uniform_real_distribution<double> chance(0.0, 1.0);
+            std::uniform_real_distribution<double> weight(1.0, 2.0);
+            GraphBuilder<double, int> builder;
+            for (int u = 0; u < groups * groupSize; ++u) {
+                for (int v = u + 1; v < groups * groupSize; ++v) {
+                    bool same = u / groupSize == v / groupSize;
+                    if (chance(generator) < (same ? 0.3 : 0.005)) {
+                        builder.addEdge(u, v, weight(generator));
+                    }
+                }
+            }
+            auto graph = builder.buildCompressed(false);
+
+            ThreadPool pool(4);
+            for (ThreadPool* threads : {static_cast<ThreadPool*>(nullptr), &pool}) {
+                auto result = Louvain(threads).run(graph);
+                if (result.communityCount != groups) {
+                    throw std::runtime_error("Planted communities are not recovered");
+                }
+                for (int u = 0; u < graph.getVertexCount(); ++u) {
+                    int first = graph.getIndex(graph.getId(u) / groupSize * groupSize);
+                    if (result.communities[u] != result.communities[first]) {
+                        throw std::runtime_error("Planted community is split");
+                    }
+                }
+                // Каждый уровень укрупняет предыдущий, модулярность растет и совпадает с расчетом по определению
+                for (size_t level = 0; level < result.levels.size(); ++level) {
+                    double expected = referenceModularity(graph, result.levels[level]);
+                    if (std::abs(result.levelModularity[level] - expected) > 1e-9) {
+                        throw std::runtime_error("Level modularity mismatch");
+                    }
+                    if (level == 0) continue;
+                    if (!(result.levelModularity[level] > result.levelModularity[level - 1])) {
+                        throw std::runtime_error("Modularity must grow between levels");
+                    }
+                    std::map<int, int> coarser;
+                    for (int u = 0; u < graph.getVertexCount(); ++u) {
+                        auto [it, inserted] = coarser.emplace(result.levels[level - 1][u], result.levels[level][u]);
+                        if (it->second != result.levels[level][u]) {
+                            throw std::runtime_error("Level does not refine the next one");
+                        }
+                    }
+                }
+            }
+        });
+
+        runner.expectNoException("LouvainAlgorithm::Graph without edges", [&]() {
+            GraphBuilder<double, int> builder;
+            for (int v = 0; v < 4; ++v) {
+                builder.addVertex(v);
+            }
+            auto result = Louvain().run(builder.buildCompressed(false));
+            if (result.communityCount != 4 || !result.levels.empty() || result.modularity != 0 ||
+                result.communities != std::vector<int>{0, 1, 2, 3}) {
+                throw std::runtime_error("Isolated vertices must stay in their own communities");
+            }
+        });
+
+        runner.expectException<std::runtime_error>("LouvainAlgorithm::Negative weight", []() {
+            GraphBuilder<double, int> builder;
+            builder.addEdge(0, 1, -1.0);
+            Louvain().run(builder.buildCompressed(false));
+        });
+
+        runner.expectException<std::invalid_argument>("LouvainAlgorithm::Directed graph", []() {
+            DirectedGraph<double, int> graph;
+            Louvain().execute(&graph);
+        });
+    }
+
+    void testReachabilityIndex() {
+        TestRunner runner;
+        using Index = ReachabilityIndex<int, int>;
+
+        // Достижимость обходом в ширину из каждой вершины
+        auto checkAllPairs = [](const CompressedGraph<int, int>& graph, const Index& index) {
+            int n = graph.getVertexCount();
+            for (int source = 0; source < n; ++source) {
+                std::vector<char> reached(n, 0);
+                std::vector<int> queue{source};
+                reached[source] = 1;
+                for (size_t head = 0; head < queue.size(); ++head) {
+                    for (int w : graph.getOutNeighbors(queue[head])) {
+                        if (!reached[w]) {
+                            reached[w] = 1;
+                            queue.push_back(w);
+                        }
+                    }
+                }
+                for (int target = 0; target < n; ++target) {
+                    if (index.reaches(source, target) != static_cast<bool>(reached[target])) {
+                        throw std::runtime_error("Reachability mismatch");
+                    }
+                }
+            }
+        };
+
+        runner.expectNoException("ReachabilityIndex::Cycles and condensation", [&]() {
+            // {0, 1, 2} -> {3, 4} -> 5, отдельно 6 -> 5
+            DirectedGraph<int, int> graph;
+            std::vector<IVertex<int, int>*> v;
+            for (int i = 0; i < 7; ++i) {
+                v.push_back(graph.createVertex(i));
+            }
+            graph.addEdge(v[0], v[1], 1);
+            graph.addEdge(v[1], v[2], 1);
+            graph.addEdge(v[2], v[0], 1);
+            graph.addEdge(v[2], v[3], 1);
+            graph.addEdge(v[3], v[4], 1);
+            graph.addEdge(v[4], v[3], 1);
+            graph.addEdge(v[4], v[5], 1);
+            graph.addEdge(v[6], v[5], 1);
+            auto snapshot = CompressedGraph<int, int>::fromGraph(&graph);
+            Index index(snapshot);
+            if (index.getComponentCount() != 4 || index.getCondensationArcCount() != 3 ||
+                index.getComponent(snapshot.getIndex(3)) != index.getComponent(snapshot.getIndex(4))) {
+                throw std::runtime_error("Incorrect condensation");
+            }
+            if (!index.reaches(snapshot.getIndex(1), snapshot.getIndex(5)) ||
+                index.reaches(snapshot.getIndex(6), snapshot.getIndex(0)) ||
+                index.reaches(snapshot.getIndex(5), snapshot.getIndex(4))) {
+                throw std::runtime_error("Incorrect reachability");
+            }
+            checkAllPairs(snapshot, index);
+        });
+
+        runner.expectNoException("ReachabilityIndex::Random graphs, all pairs", [&]() {
+            std::mt19937 generator(43);
+            for (int labelings : {1, 2, 5}) {
+                // Почти ацикличный граф: ребра в основном вперед, немного обратных
+                const int n = 400;
+                std::uniform_int_distribution<int> vertexDist(0, n - 1);
+                std::uniform_int_distribution<int> percent(0, 99);
+                GraphBuilder<int, int> builder(n);
+                for (int i = 0; i < n; ++i) {
+                    builder.addVertex(i);
+                }
+                for (int i = 0; i < n * 2; ++i) {
+                    int a = vertexDist(generator);
+                    int b = vertexDist(generator);
+                    if ((a < b) == (percent(generator) < 97)) {
+                        builder.addEdge(a, b, 1);
+                    }
+                }
+                auto graph = builder.buildCompressed(true);
+                Index index(graph, labelings, 7 + labelings);
+                checkAllPairs(graph, index);
+
+                const auto& statistics = index.getStatistics();
+                if (statistics.queries != static_cast<size_t>(n) * n ||
+                    statistics.labelAnswers + statistics.searches != statistics.queries) {
+                    throw std::runtime_error("Incorrect query statistics");
+                }
+                if (index.getIndexSize() == 0 || index.getBuildSeconds() < 0) {
+                    throw std::runtime_error("Incorrect index metrics");
+                }
+            }
+        });
+
+        runner.expectNoException("ReachabilityIndex::Undirected graph", [&]() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(0, 1, 1);
+            builder.addEdge(1, 2, 1);
+            builder.addEdge(3, 4, 1);
+            auto graph = builder.buildCompressed(false);
+            Index index(graph);
+            if (index.getComponentCount() != 2) {
+                throw std::runtime_error("Undirected components must be strongly connected");
+            }
+            checkAllPairs(graph, index);
+        });
+
+        runner.expectException<std::invalid_argument>("ReachabilityIndex::Vertex out of range", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(0, 1, 1);
+            Index(builder.buildCompressed(true)).reaches(0, 2);
+        });
+
+        runner.expectException<std::invalid_argument>("ReachabilityIndex::No labelings", []() {
+            GraphBuilder<int, int> builder;
+            builder.addEdge(0, 1, 1);
+            Index(builder.buildCompressed(true), 0);
+        });
+    }
+
+    void testGraphGenerators() {
+        TestRunner runner;
+        using Sampler = ErdosRenyiSampler<int>;
+
+        auto flatten = [](const std::vector<std::vector<Sampler::Edge>>& chunks) {
+            std::vector<std::pair<size_t, size_t>> edges;
+            for (const auto& chunk : chunks) {
+                for (const auto& edge : chunk) {
+                    if (edge.weight < 1 || edge.weight > 10) {
+                        throw std::runtime_error("Weight is out of range");
+                    }
+                    edges.push_back({edge.from, edge.to});
+                }
+            }
+            return edges;
+        };
+
+        runner.expectNoException("ErdosRenyiSampler::Complete and empty graphs", [&]() {
+            for (bool directed : {true, false}) {
+                auto full = flatten(Sampler(50, 1.0, directed, 1).sample());
+                std::set<std::pair<size_t, size_t>> unique(full.begin(), full.end());
+                if (full.size() != (directed ? 50u * 49 : 50u * 49 / 2) || unique.size() != full.size()) {
+                    throw std::runtime_error("p = 1 must produce every pair once");
+                }
+                for (const auto& [from, to] : full) {
+                    if (from == to || from >= 50 || to >= 50 || (!directed && to > from)) {
+                        throw std::runtime_error("Invalid pair");
+                    }
+                }
+                if (!Sampler(50, 0.0, directed, 1).sample()[0].empty()) {
+                    throw std::runtime_error("p = 0 must produce no edges");
+                }
+            }
+        });
+
+        runner.expectNoException("ErdosRenyiSampler::Edge count and chunked pair space", [&]() {
+            // 3000 вершин - несколько блоков пар; число ребер в пределах 5 стандартных отклонений
+            const size_t n = 3000;
+            const double p = 0.002;
+            for (bool directed : {true, false}) {
+                Sampler sampler(n, p, directed, 5);
+                auto edges = flatten(sampler.sample());
+                double pairs = directed ? double(n) * (n - 1) : double(n) * (n - 1) / 2;
+                double deviation = std::sqrt(pairs * p * (1 - p));
+                if (std::abs(double(edges.size()) - pairs * p) > 5 * deviation) {
+                    throw std::runtime_error("Edge count deviates from n * p");
+                }
+                if (!std::is_sorted(edges.begin(), edges.end()) ||
+                    std::adjacent_find(edges.begin(), edges.end()) != edges.end()) {
+                    throw std::runtime_error("Edges must be distinct and ordered");
+                }
+                if (directed && sampler.getChunkCount() < 2) {
+                    throw std::runtime_error("Pair space must be split into several chunks");
+                }
+            }
+        });
+
+        runner.expectNoException("ErdosRenyiSampler::Same edges with thread pool", [&]() {
+            ThreadPool pool(4);
+            Sampler sampler(4000, 0.001, true, 11);
+            auto sequential = flatten(sampler.sample());
+            if (sequential != flatten(sampler.sample(&pool))) {
+                throw std::runtime_error("Parallel sampling depends on the number of threads");
+            }
+            if (sequential == flatten(Sampler(4000, 0.001, true, 12).sample())) {
+                throw std::runtime_error("Different seeds must produce different graphs");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::Directed and undirected generators", [&]() {
+            ThreadPool pool(2);
+            DirectedGraphGenerator<int, int> directed(200, 1.0);
+            directed.setThreadPool(&pool);
+            UniquePtr<IGraph<int, int>> directedGraph(directed.generate());
+            UndirectedGraphGenerator<int, int> undirected(200, 1.0);
+            UniquePtr<IGraph<int, int>> undirectedGraph(undirected.generate());
+            if (CompressedGraph<int, int>::fromGraph(directedGraph.get()).getEdgeCount() != 200u * 199 ||
+                CompressedGraph<int, int>::fromGraph(undirectedGraph.get()).getEdgeCount() != 200u * 199 / 2) {
+                throw std::runtime_error("Complete graph has wrong number of edges");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::Seeded generation is reproducible", [&]() {
+            auto arcs = [](const CompressedGraph<int, int>& graph) {
+                return std::make_pair(graph.getOutOffsets(), graph.getOutTargets());
+            };
+            DirectedGraphGenerator<int, int> random(300, 0.05);
+            DirectedGraphGenerator<int, int> repeated(300, 0.05, random.getSeed());
+            auto graph = random.generateCompressed();
+            auto same = repeated.generateCompressed();
+            if (arcs(graph) != arcs(same) || graph.getOutWeights() != same.getOutWeights()) {
+                throw std::runtime_error("Same seed must produce the same graph");
+            }
+            if (arcs(graph) == arcs(DirectedGraphGenerator<int, int>(300, 0.05, random.getSeed() + 1).generateCompressed())) {
+                throw std::runtime_error("Different seeds must produce different graphs");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::Weight distributions", [&]() {
+            CounterRandom random(3, 0);
+            std::set<int> seen;
+            for (int i = 0; i < 1000; ++i) {
+                int weight = WeightDistribution<int>::uniform(2, 5).sample(random);
+                if (weight < 2 || weight > 5) throw std::runtime_error("Uniform weight out of range");
+                seen.insert(weight);
+                if (WeightDistribution<int>::exponential(0.1).sample(random) < 1) {
+                    throw std::runtime_error("Integer exponential weight must be at least 1");
+                }
+            }
+            if (seen.size() != 4 || WeightDistribution<int>::constant(7).sample(random) != 7) {
+                throw std::runtime_error("Incorrect integer weights");
+            }
+            double sum = 0;
+            auto exponential = WeightDistribution<double>::exponential(3.0);
+            for (int i = 0; i < 100000; ++i) {
+                sum += exponential.sample(random);
+            }
+            if (std::abs(sum / 100000 - 3.0) > 0.1) {
+                throw std::runtime_error("Exponential mean mismatch");
+            }
+
+            GridGraphGenerator<int, int> grid(5, 5, 1, 1);
+            grid.setWeightDistribution(WeightDistribution<int>::constant(4));
+            auto graph = grid.generateCompressed();
+            for (int weight : graph.getOutWeights()) {
+                if (weight != 4) throw std::runtime_error("Generator ignores weight distribution");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::R-MAT", [&]() {
+            RMatGraphGenerator<int, int> rmat(10, 8, 21);
+            auto graph = rmat.generateCompressed();
+            if (graph.getVertexCount() != 1024 || graph.getArcCount() != 8192) {
+                throw std::runtime_error("R-MAT must produce edgeFactor * 2^scale edges");
+            }
+            ThreadPool pool(4);
+            rmat.setThreadPool(&pool);
+            if (graph.getOutTargets() != rmat.generateCompressed().getOutTargets()) {
+                throw std::runtime_error("Parallel R-MAT depends on the number of threads");
+            }
+
+            // Без перестановки самая тяжелая четверть - левая верхняя, то есть вершина 0
+            rmat.setPermutation(false);
+            auto plain = rmat.generateCompressed();
+            size_t maxDegree = 0;
+            for (int v = 0; v < plain.getVertexCount(); ++v) {
+                maxDegree = std::max(maxDegree, plain.getOutDegree(v));
+            }
+            if (plain.getOutDegree(plain.getIndex(0)) != maxDegree || maxDegree < 10 * 8) {
+                throw std::runtime_error("R-MAT degrees must be skewed");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("GraphGenerators::R-MAT probabilities", []() {
+            RMatGraphGenerator<int, int>(10, 8, 1).setProbabilities(0.6, 0.3, 0.2);
+        });
+
+        runner.expectNoException("GraphGenerators::Barabasi-Albert", [&]() {
+            const size_t n = 2000;
+            const size_t m = 3;
+            auto graph = BarabasiAlbertGraphGenerator<int, int>(n, m, 5).generateCompressed();
+            if (graph.getEdgeCount() != m * (m + 1) / 2 + (n - m - 1) * m) {
+                throw std::runtime_error("Incorrect number of edges");
+            }
+            int maxDegree = 0;
+            for (int v = 0; v < graph.getVertexCount(); ++v) {
+                auto neighbors = graph.getOutNeighbors(v);
+                std::set<int> unique(neighbors.begin(), neighbors.end());
+                if (unique.size() != neighbors.size() || unique.count(v) || neighbors.size() < m) {
+                    throw std::runtime_error("Barabasi-Albert graph must be simple with degree at least m");
+                }
+                maxDegree = std::max(maxDegree, static_cast<int>(neighbors.size()));
+            }
+            if (maxDegree < 40) {
+                throw std::runtime_error("Preferential attachment must produce hubs");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::Grids", [&]() {
+            auto flat = GridGraphGenerator<int, int>(10, 7, 1, 1).generateCompressed();
+            if (flat.getEdgeCount() != 9u * 7 + 10 * 6 || flat.getOutDegree(flat.getIndex(0)) != 2 ||
+                flat.getOutDegree(flat.getIndex(11)) != 4) {
+                throw std::runtime_error("Incorrect 2D grid");
+            }
+            auto cube = GridGraphGenerator<int, int>(4, 4, 4, 1, true).generateCompressed();
+            if (!cube.isDirected() || cube.getArcCount() != 2u * 3 * 3 * 16 ||
+                cube.getOutDegree(cube.getIndex(1 + 4 + 16)) != 6) {
+                throw std::runtime_error("Incorrect 3D grid");
+            }
+        });
+
+        runner.expectNoException("GraphGenerators::Random geometric graph", [&]() {
+            for (int dimensions : {2, 3}) {
+                const size_t n = 1500;
+                const double radius = dimensions == 2 ? 0.04 : 0.1;
+                RandomGeometricGraphGenerator<int, int> generator(n, radius, dimensions, 9);
+                generator.setDistanceWeights(1000);
+                auto graph = generator.generateCompressed();
+
+                // Перебор всех пар по тем же точкам
+                size_t expected = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    for (size_t j = i + 1; j < n; ++j) {
+                        double distance = 0;
+                        for (int axis = 0; axis < dimensions; ++axis) {
+                            double delta = generator.getPoint(i)[axis] - generator.getPoint(j)[axis];
+                            distance += delta * delta;
+                        }
+                        if (distance <= radius * radius) ++expected;
+                    }
+                }
+                if (graph.getEdgeCount() != expected || expected == 0) {
+                    throw std::runtime_error("Random geometric graph misses pairs");
+                }
+                for (int weight : graph.getOutWeights()) {
+                    if (weight < 1 || weight > std::ceil(1000 * radius)) {
+                        throw std::runtime_error("Distance weight out of range");
+                    }
+                }
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("GraphGenerators::Invalid probability", []() {
+            DirectedGraphGenerator<int, int> generator(10, 1.5);
+        });
+    }
+
+    void testEdgeStreaming() {
+        TestRunner runner;
+        using Edges = std::vector<GeneratedEdge<int>>;
 
-            IVertex<int, int> *startVertex = graph.getVertexById(1);
-            IVertex<int, int> *endVertex = graph.getVertexById(5);
+        auto collect = [](IStreamingGraphGenerator<int>& generator, size_t bufferEdges) {
+            Edges edges;
+            CallbackEdgeSink<int> sink([&](std::span<const GeneratedEdge<int>> chunk) {
+                if (chunk.empty() || chunk.size() > bufferEdges) {
+                    throw std::runtime_error("Chunk exceeds buffer capacity");
+                }
+                edges.insert(edges.end(), chunk.begin(), chunk.end());
+            });
+            generator.generateTo(sink, bufferEdges);
+            return edges;
+        };
+        // Граф из потока в том же порядке, в каком генератор пишет ребра в сборщик
+        auto sameGraph = [](const Edges& edges, size_t n, const CompressedGraph<int, int>& expected) {
+            GraphBuilder<int, int> builder;
+            for (size_t i = 0; i < n; ++i) {
+                builder.addVertex(static_cast<int>(i));
+            }
+            for (const auto& edge : edges) {
+                builder.addEdge(static_cast<int>(edge.from), static_cast<int>(edge.to), edge.weight);
+            }
+            auto graph = builder.buildCompressed(expected.isDirected());
+            return graph.getOutOffsets() == expected.getOutOffsets() &&
+                   graph.getOutTargets() == expected.getOutTargets() &&
+                   graph.getOutWeights() == expected.getOutWeights();
+        };
+
+        runner.expectNoException("EdgeStreaming::Stream matches in-memory generation", [&]() {
+            DirectedGraphGenerator<int, int> directed(3000, 0.002, 4);
+            UndirectedGraphGenerator<int, int> undirected(3000, 0.002, 4);
+            RMatGraphGenerator<int, int> rmat(12, 20, 4);
+            GridGraphGenerator<int, int> grid(30, 20, 3, 4, true);
+            if (!sameGraph(collect(directed, 1000), 3000, directed.generateCompressed()) ||
+                !sameGraph(collect(undirected, 1000), 3000, undirected.generateCompressed()) ||
+                !sameGraph(collect(rmat, 777), rmat.getVertexCount(), rmat.generateCompressed()) ||
+                !sameGraph(collect(grid, 100), grid.getVertexCount(), grid.generateCompressed())) {
+                throw std::runtime_error("Streamed edges differ from generated graph");
+            }
+        });
 
-            if (!startVertex || !endVertex) {
-                throw std::runtime_error("Start or end vertex not found in graph.");
+        runner.expectNoException("EdgeStreaming::Sharded writers", [&]() {
+            ThreadPool pool(4);
+            RMatGraphGenerator<int, int> rmat(14, 40, 8);
+            Edges expected = collect(rmat, 4096);
+            std::vector<Edges> parts(5);
+            rmat.generateSharded(parts.size(), [&](size_t writer) {
+                return UniquePtr<IEdgeSink<int>>(new CallbackEdgeSink<int>([&parts, writer](std::span<const GeneratedEdge<int>> chunk) {
+                    parts[writer].insert(parts[writer].end(), chunk.begin(), chunk.end());
+                }));
+            }, &pool);
+            Edges joined;
+            for (const auto& part : parts) {
+                if (part.empty()) throw std::runtime_error("Writer got no shards");
+                joined.insert(joined.end(), part.begin(), part.end());
+            }
+            if (joined != expected) {
+                throw std::runtime_error("Joined shards differ from sequential stream");
             }
+        });
 
-            auto dijkstraResult = dijkstra.execute(&graph, startVertex, endVertex);
-            if (!dijkstraResult) {
-                throw std::runtime_error("Dijkstra's algorithm returned nullptr.");
+        runner.expectNoException("EdgeStreaming::Binary and text files", [&]() {
+            std::string binaryPath = (std::filesystem::temp_directory_path() / "edge_stream_test.bin").string();
+            std::string textPath = (std::filesystem::temp_directory_path() / "edge_stream_test.txt").string();
+            UndirectedGraphGenerator<int, int> generator(2000, 0.003, 6);
+            Edges expected = collect(generator, 1 << 16);
+            BinaryEdgeSink<int> binary(binaryPath);
+            generator.generateTo(binary, 500);
+            TextEdgeListSink<int> text(textPath);
+            generator.generateTo(text);
+
+            Edges loaded;
+            BinaryEdgeReader<int>(binaryPath).forEachChunk([&](std::span<const GeneratedEdge<int>> chunk) {
+                loaded.insert(loaded.end(), chunk.begin(), chunk.end());
+            }, 300);
+            std::ifstream lines(textPath);
+            Edges parsed;
+            GeneratedEdge<int> edge{};
+            while (lines >> edge.from >> edge.to >> edge.weight) {
+                parsed.push_back(edge);
             }
-            auto distances = dijkstraResult->first;
-            auto path = dijkstraResult->second;
+            lines.close();
+            std::filesystem::remove(binaryPath);
+            std::filesystem::remove(textPath);
+            if (loaded != expected || parsed != expected || expected.empty()) {
+                throw std::runtime_error("Edge files differ from the stream");
+            }
+        });
 
-            std::map<int, int> expectedDistances = {
-            {1, 0}, {2, 8}, {3, 8}, {4, 5}, {5, 7}
+        runner.expectNoException("EdgeStreaming::Concatenated binary shards", [&]() {
+            RMatGraphGenerator<int, int> rmat(12, 20, 5);
+            Edges expected = collect(rmat, 4096);
+            auto shardPath = [](size_t writer) {
+                return (std::filesystem::temp_directory_path() / ("edge_shard_test_" + std::to_string(writer) + ".bin")).string();
             };
-            std::vector<int> expectedPath = {1, 4, 5};
-
+            size_t writers = 3;
+            rmat.generateSharded(writers, [&](size_t writer) {
+                return UniquePtr<IEdgeSink<int>>(new BinaryEdgeSink<int>(shardPath(writer), writer == 0));
+            });
 
-            auto vertices = graph.getVertices();
-            for (size_t i = 0; i < vertices.getLength(); ++i) {
-                int vertexId = vertices.get(i)->getId();
-                if (distances.get(i) != expectedDistances[vertexId]){
-                    throw std::runtime_error("Incorrect shortest path distance for vertex " + std::to_string(vertexId) +
-                                             ", expected: " + std::to_string(expectedDistances[vertexId]) +
-                                             ", actual: " + std::to_string(distances.get(i)));
+            std::string joinedPath = (std::filesystem::temp_directory_path() / "edge_shard_test.bin").string();
+            {
+                std::ofstream joined(joinedPath, std::ios::binary | std::ios::trunc);
+                for (size_t writer = 0; writer < writers; ++writer) {
+                    std::ifstream shard(shardPath(writer), std::ios::binary);
+                    joined << shard.rdbuf();
                 }
             }
-
-            if (path.getLength() != expectedPath.size()) {
-                throw std::runtime_error("Shortest path length is incorrect.");
+            Edges loaded;
+            BinaryEdgeReader<int>(joinedPath).forEachChunk([&](std::span<const GeneratedEdge<int>> chunk) {
+                loaded.insert(loaded.end(), chunk.begin(), chunk.end());
+            });
+            for (size_t writer = 0; writer < writers; ++writer) {
+                std::filesystem::remove(shardPath(writer));
             }
-            for (size_t i = 0; i < path.getLength(); ++i) {
-                if (path.getVertices().get(i)->getId() != expectedPath[i]) {
-                    throw std::runtime_error("Incorrect vertex in shortest path at position " + std::to_string(i));
-                }
+            std::filesystem::remove(joinedPath);
+            if (loaded != expected || expected.empty()) {
+                throw std::runtime_error("Concatenated shards differ from the stream");
             }
         });
-    }
 
-    void testMSTAlgorithm() {
-        TestRunner runner;
-        runner.expectNoException("MSTAlgorithm::Find MST", []() {
-            UndirectedGraph<int, int> graph = createUndirectedGraphForTests();
-            MSTAlgorithm<int, int> mstAlgo;
-            auto mstEdges = mstAlgo.execute(&graph);
-            if (!mstEdges) {
-                throw std::runtime_error("MST Algorithm returned nullptr");
+        runner.expectException<std::runtime_error>("EdgeStreaming::Reading edges of another type", []() {
+            std::string path = (std::filesystem::temp_directory_path() / "edge_stream_type.bin").string();
+            BinaryEdgeSink<int> sink(path);
+            GridGraphGenerator<int, int>(3, 3, 1, 1).generateTo(sink);
+            try {
+                BinaryEdgeReader<double> reader(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
             }
+            std::filesystem::remove(path);
         });
     }
 
-    void testConnectedComponentsAlgorithm() {
+    void testMappedGraph() {
         TestRunner runner;
-        runner.expectNoException("ConnectedComponentsAlgorithm::Find CC", []() {
-            UndirectedGraph<int, int> graph = createUndirectedGraphForTests();
-            ConnectedComponentsAlgorithm<int, int> ccAlgo;
-            auto components = ccAlgo.execute(&graph);
-            if (!components) {
-                throw std::runtime_error("Connected Components Algorithm returned nullptr");
+        auto tempPath = [](const std::string& name) {
+            return (std::filesystem::temp_directory_path() / name).string();
+        };
+        auto sameArrays = [](const auto& mapped, const auto& graph) {
+            auto equal = [](auto span, const auto& vector) { return std::equal(span.begin(), span.end(), vector.begin(), vector.end()); };
+            return mapped.isDirected() == graph.isDirected() && mapped.getVertexCount() == graph.getVertexCount() &&
+                   equal(mapped.getOutOffsets(), graph.getOutOffsets()) &&
+                   equal(mapped.getOutTargets(), graph.getOutTargets()) &&
+                   equal(mapped.getOutWeights(), graph.getOutWeights()) &&
+                   equal(mapped.getInOffsets(), graph.getInOffsets()) &&
+                   equal(mapped.getInSources(), graph.getInSources()) &&
+                   equal(mapped.getInWeights(), graph.getInWeights());
+        };
+
+        runner.expectNoException("MappedGraph::Directed and undirected round trip", [&]() {
+            std::string path = tempPath("mapped_graph_test.csr");
+            for (bool directed : {true, false}) {
+                // Идентификаторы не подряд и не по возрастанию
+                GraphBuilder<double, long long> builder;
+                for (long long i = 0; i < 500; ++i) {
+                    builder.addVertex((i * 7919) % 500 * 3 - 700);
+                }
+                std::mt19937 random(directed ? 1 : 2);
+                for (int i = 0; i < 3000; ++i) {
+                    builder.addEdge(((random() % 500) * 7919) % 500 * 3 - 700, ((random() % 500) * 7919) % 500 * 3 - 700,
+                                    (random() % 1000) / 8.0);
+                }
+                auto graph = builder.buildCompressed(directed);
+                MappedGraph<double, long long>::write(graph, path);
+                auto mapped = MappedGraph<double, long long>::open(path, true);
+                if (!sameArrays(mapped, graph) || mapped.getEdgeCount() != graph.getEdgeCount()) {
+                    throw std::runtime_error("Mapped arrays differ from the snapshot");
+                }
+                for (int v = 0; v < graph.getVertexCount(); ++v) {
+                    long long id = graph.getId(v);
+                    if (mapped.getId(v) != id || mapped.getIndex(id) != v || !mapped.hasVertex(id) ||
+                        mapped.getOutNeighbors(v).size() != graph.getOutNeighbors(v).size()) {
+                        throw std::runtime_error("Mapped vertex lookup differs from the snapshot");
+                    }
+                }
+                if (mapped.hasVertex(-701) || mapped.hasVertex(800)) {
+                    throw std::runtime_error("Missing identifier reported as present");
+                }
+                if (!sameArrays(mapped, mapped.toCompressed())) {
+                    throw std::runtime_error("Copied snapshot differs from the mapped graph");
+                }
             }
+            std::filesystem::remove(path);
+        });
+
+        runner.expectNoException("MappedGraph::Empty graph", [&]() {
+            std::string path = tempPath("mapped_graph_empty.csr");
+            MappedGraph<int, int>::write(CompressedGraph<int, int>(), path);
+            auto mapped = MappedGraph<int, int>::open(path, true);
+            std::filesystem::remove(path);
+            if (mapped.getVertexCount() != 0 || mapped.getArcCount() != 0 || mapped.hasVertex(0)) {
+                throw std::runtime_error("Empty graph is not empty after mapping");
+            }
+        });
+
+        // Порча одного байта в секции дуг: открытие без проверки проходит, проверка сумм - нет
+        runner.expectException<std::runtime_error>("MappedGraph::Corrupted section", [&]() {
+            std::string path = tempPath("mapped_graph_corrupt.csr");
+            MappedGraph<int, int>::write(GridGraphGenerator<int, int>(20, 20, 1, 3, true).generateCompressed(), path);
+            {
+                std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+                file.seekp(-5, std::ios::end);
+                file.put('\x7F');
+            }
+            try {
+                auto mapped = MappedGraph<int, int>::open(path);
+                mapped.verifyChecksums();
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+            std::filesystem::remove(path);
+        });
+
+        runner.expectException<std::runtime_error>("MappedGraph::Reading graph of another type", [&]() {
+            std::string path = tempPath("mapped_graph_type.csr");
+            MappedGraph<int, int>::write(GridGraphGenerator<int, int>(3, 3, 1, 1).generateCompressed(), path);
+            try {
+                MappedGraph<double, int>::open(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+            std::filesystem::remove(path);
+        });
+
+        runner.expectException<std::runtime_error>("MappedGraph::Truncated file", [&]() {
+            std::string path = tempPath("mapped_graph_truncated.csr");
+            MappedGraph<int, int>::write(GridGraphGenerator<int, int>(10, 10, 1, 1).generateCompressed(), path);
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+            try {
+                MappedGraph<int, int>::open(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+            std::filesystem::remove(path);
         });
     }
 
-    void testStronglyConnectedComponentsAlgorithm() {
+    void testGraphLoader() {
         TestRunner runner;
-        runner.expectNoException("StronglyConnectedComponentsAlgorithm::Find SCC", []() {
-            DirectedGraph<int, int> graph = createDirectedGraphForTests();
-            StronglyConnectedComponentsAlgorithm<int, int> sccAlgo;
-            auto components = sccAlgo.execute(&graph);
-            if(!components) {
-                throw std::runtime_error("Strongly Connected Components Algorithm returned nullptr");
+        auto writeFile = [](const std::string& name, const std::string& text) {
+            std::string path = (std::filesystem::temp_directory_path() / name).string();
+            std::ofstream(path, std::ios::binary) << text;
+            return path;
+        };
+        // Соседи вершины id как пары (идентификатор соседа, вес)
+        auto neighbors = [](const auto& graph, auto id) {
+            using Weight = typename std::decay_t<decltype(graph.getOutWeights())>::value_type;
+            std::vector<std::pair<decltype(id), Weight>> result;
+            int v = graph.getIndex(id);
+            for (size_t i = 0; i < graph.getOutDegree(v); ++i) {
+                result.push_back({graph.getId(graph.getOutNeighbors(v)[i]), graph.getOutWeights(v)[i]});
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        };
+
+        runner.expectNoException("GraphLoader::Edge list", [&]() {
+            std::string path = writeFile("loader_test.txt", "# comment\n10 20 5\r\n20\t30\n\n% other comment\n30 10 2.0\n-4 10 7");
+            auto graph = GraphLoader<int, int>().load(path);
+            std::filesystem::remove(path);
+            using Neighbors = std::vector<std::pair<int, int>>;
+            if (!graph.isDirected() || graph.getVertexCount() != 4 || graph.getArcCount() != 4 ||
+                neighbors(graph, 10) != Neighbors{{20, 5}} || neighbors(graph, 20) != Neighbors{{30, 1}} ||
+                neighbors(graph, 30) != Neighbors{{10, 2}} || neighbors(graph, -4) != Neighbors{{10, 7}}) {
+                throw std::runtime_error("Incorrect edge list graph");
             }
+        });
 
-            // Проверяем количество компонент
-            if (components->getLength() != 2) {
-                throw std::runtime_error("Incorrect number of strongly connected components. Expected 2, got " +
-                                         std::to_string(components->getLength()));
+        runner.expectNoException("GraphLoader::Parallel chunks match sequential parsing", [&]() {
+            std::string path = (std::filesystem::temp_directory_path() / "loader_chunks.txt").string();
+            RMatGraphGenerator<int, int> rmat(10, 8, 3);
+            TextEdgeListSink<int> sink(path);
+            rmat.generateTo(sink);
+
+            ThreadPool pool(4);
+            GraphLoader<int, int> sequential;
+            GraphLoader<int, int> parallel(&pool);
+            parallel.setChunkBytes(100);
+            auto expected = sequential.load(path, GraphLoader<int, int>::Format::EdgeList);
+            auto graph = parallel.load(path, GraphLoader<int, int>::Format::EdgeList);
+            std::filesystem::remove(path);
+            if (expected.getArcCount() != rmat.getEdgeCount() || graph.getOutOffsets() != expected.getOutOffsets() ||
+                graph.getOutTargets() != expected.getOutTargets() || graph.getOutWeights() != expected.getOutWeights()) {
+                throw std::runtime_error("Chunked parsing changes the graph");
             }
+        });
 
-            // Проверяем состав компонент.
-            std::set<int> component1;
-            std::set<int> component2;
+        runner.expectNoException("GraphLoader::DIMACS", [&]() {
+            std::string path = writeFile("loader_test.gr", "c 9th DIMACS\np sp 5 3\nc arcs\na 1 2 7\na 2 3 4\na 3 1 9\n");
+            GraphLoader<long long, int> loader;
+            loader.setChunkBytes(8);
+            auto graph = loader.load(path);
+            std::filesystem::remove(path);
+            if (!graph.isDirected() || graph.getVertexCount() != 5 || graph.getArcCount() != 3 ||
+                neighbors(graph, 2) != std::vector<std::pair<int, long long>>{{3, 4}} || graph.getOutDegree(graph.getIndex(5)) != 0) {
+                throw std::runtime_error("Incorrect DIMACS graph");
+            }
+        });
 
-            // Заполняем наборы из результата алгоритма
-            for (size_t i = 0; i < components->getLength(); ++i) {
-                auto& component = components->get(i); // component - ссылка на MutableArraySequence<IVertex<int, int>*>
+        runner.expectNoException("GraphLoader::Matrix Market", [&]() {
+            std::string symmetric = writeFile("loader_symmetric.mtx",
+                "%%MatrixMarket matrix coordinate real symmetric\n% comment\n4 4 3\n2 1 0.5\n3 1 1e-1\n4 3 -2\n");
+            auto graph = GraphLoader<double, int>().load(symmetric);
+            std::filesystem::remove(symmetric);
+            if (graph.isDirected() || graph.getEdgeCount() != 3 ||
+                neighbors(graph, 1) != std::vector<std::pair<int, double>>{{2, 0.5}, {3, 0.1}}) {
+                throw std::runtime_error("Incorrect symmetric Matrix Market graph");
+            }
+            std::string pattern = writeFile("loader_pattern.mtx",
+                "%%MatrixMarket matrix coordinate pattern general\n3 5 2\n1 5\n3 2\n");
+            auto directed = GraphLoader<int, int>().load(pattern);
+            std::filesystem::remove(pattern);
+            if (!directed.isDirected() || directed.getVertexCount() != 5 ||
+                neighbors(directed, 1) != std::vector<std::pair<int, int>>{{5, 1}}) {
+                throw std::runtime_error("Incorrect pattern Matrix Market graph");
+            }
+        });
 
-                if (component.getLength() == 1)
-                {
-                    IVertex<int, int>* vertex = component.get(0);
-                    if (!vertex) {
-                        throw std::runtime_error("component.get(0) returned nullptr");
-                    }
-                    component1.insert(vertex->getId());
+        runner.expectNoException("GraphLoader::METIS", [&]() {
+            // Вершина 4 изолирована; ребра с весами, у вершин по одному весу (fmt 011)
+            std::string path = writeFile("loader_test.graph",
+                "% METIS\n5 4 011\n1 2 3 3 8\n1 1 3 3 1\n1 1 8 2 1 5 6\n1\n1 3 6\n");
+            ThreadPool pool(2);
+            GraphLoader<int, int> loader(&pool);
+            loader.setChunkBytes(6);
+            auto graph = loader.load(path);
+            std::filesystem::remove(path);
+            if (graph.isDirected() || graph.getVertexCount() != 5 || graph.getEdgeCount() != 4 ||
+                neighbors(graph, 3) != std::vector<std::pair<int, int>>{{1, 8}, {2, 1}, {5, 6}} ||
+                graph.getOutDegree(graph.getIndex(4)) != 0) {
+                throw std::runtime_error("Incorrect METIS graph");
+            }
+        });
+
+        runner.expectNoException("GraphLoader::Error reports line number", [&]() {
+            std::string path = writeFile("loader_error.txt", "1 2\n2 3\n3 x\n");
+            std::string message;
+            try {
+                GraphLoader<int, int>().load(path);
+            } catch (const std::runtime_error& error) {
+                message = error.what();
+            }
+            std::filesystem::remove(path);
+            if (message.find("line 3, column 3") == std::string::npos) {
+                throw std::runtime_error("Parse error must name the line and column: " + message);
+            }
+        });
+
+        runner.expectNoException("GraphLoader::Fractional integer weight is an error", [&]() {
+            std::string path = writeFile("loader_fraction.txt", "1 2 3\n2 3 2e1\n3 1 2.5\n");
+            std::string message;
+            try {
+                GraphLoader<int, int>().load(path);
+            } catch (const std::runtime_error& error) {
+                message = error.what();
+            }
+            std::filesystem::remove(path);
+            if (message.find("Weight is not an integer at line 3, column 5") == std::string::npos) {
+                throw std::runtime_error("Fractional weight must be reported: " + message);
+            }
+        });
+
+        runner.expectException<std::runtime_error>("GraphLoader::Out of range integer weight", [&]() {
+            std::string path = writeFile("loader_range.txt", "1 2 3e9\n");
+            try {
+                GraphLoader<int, int>().load(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+            std::filesystem::remove(path);
+        });
+
+        runner.expectException<std::runtime_error>("GraphLoader::DIMACS arc count mismatch", [&]() {
+            std::string path = writeFile("loader_count.gr", "p sp 3 3\na 1 2 1\n");
+            try {
+                GraphLoader<int, int>().load(path);
+            } catch (...) {
+                std::filesystem::remove(path);
+                throw;
+            }
+            std::filesystem::remove(path);
+        });
+    }
+
+    void testDurableGraph() {
+        TestRunner runner;
+        using Durable = DurableGraph<int, int>;
+        auto tempDirectory = [](const std::string& name) {
+            auto path = std::filesystem::temp_directory_path() / name;
+            std::filesystem::remove_all(path);
+            return path.string();
+        };
+        // Граф как множество вершин и мультимножество дуг (откуда, куда, вес)
+        using Summary = std::pair<std::set<int>, std::multiset<std::tuple<int, int, int>>>;
+        auto summarize = [](const DirectedGraph<int, int>& graph) {
+            auto compressed = CompressedGraph<int, int>::fromGraph(&graph);
+            Summary summary;
+            for (int v = 0; v < compressed.getVertexCount(); ++v) {
+                summary.first.insert(compressed.getId(v));
+                for (size_t i = 0; i < compressed.getOutNeighbors(v).size(); ++i) {
+                    summary.second.insert({compressed.getId(v), compressed.getId(compressed.getOutNeighbors(v)[i]),
+                                           compressed.getOutWeights(v)[i]});
                 }
-                else if(component.getLength() == 4)
-                {
-                    for(size_t j = 0; j < component.getLength(); j++)
-                    {
-                        IVertex<int, int>* vertex = component.get(j);
-                         if (!vertex) {
-                            throw std::runtime_error("component.get(" + std::to_string(j) + ") returned nullptr");
-                         }
-                          component2.insert(vertex->getId());
+            }
+            return summary;
+        };
+        // Одинаковые случайные изменения применяются к сохраняемому и к обычному графу
+        auto mutate = [](Durable& durable, DirectedGraph<int, int>& reference, std::mt19937& random, int count) {
+            for (int i = 0; i < count; ++i) {
+                int from = static_cast<int>(random() % 60);
+                int to = static_cast<int>(random() % 60);
+                switch (random() % 8) {
+                    case 0:
+                        durable.addVertex(from);
+                        reference.createVertex(from);
+                        break;
+                    case 1:
+                        durable.removeVertex(from);
+                        reference.removeVertex(reference.findVertex(from));
+                        break;
+                    case 2:
+                    case 3:
+                        durable.removeEdge(from, to);
+                        reference.removeEdge(reference.findVertex(from), reference.findVertex(to));
+                        break;
+                    default: {
+                        int weight = static_cast<int>(random() % 100);
+                        durable.addEdge(from, to, weight);
+                        reference.addEdge(reference.createVertex(from), reference.createVertex(to), weight);
                     }
                 }
-                else
-                   throw std::runtime_error("Incorrect component size");
             }
+        };
+        auto lastLog = [](const std::string& directory) {
+            std::string last;
+            for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+                if (entry.path().extension() == ".wal" && entry.path().string() > last) {
+                    last = entry.path().string();
+                }
+            }
+            return last;
+        };
+
+        runner.expectNoException("DurableGraph::Reopen replays the log", [&]() {
+            std::string directory = tempDirectory("durable_graph_reopen");
+            DirectedGraph<int, int> reference;
+            std::mt19937 random(1);
+            uint64_t sequence;
+            {
+                Durable graph(directory);
+                mutate(graph, reference, random, 2000);
+                if (summarize(graph.getGraph()) != summarize(reference)) {
+                    throw std::runtime_error("Durable graph differs from the reference");
+                }
+                sequence = graph.getSequence();
+            }
+            Durable reopened(directory);
+            const auto& info = reopened.getRecoveryInfo();
+            if (summarize(reopened.getGraph()) != summarize(reference) || reopened.getSequence() != sequence ||
+                info.snapshotSequence != 0 || info.replayedRecords != sequence || info.tornTail) {
+                throw std::runtime_error("Recovered graph differs from the graph before closing");
+            }
+            std::filesystem::remove_all(directory);
+        });
 
+        runner.expectNoException("DurableGraph::Snapshot plus log tail", [&]() {
+            std::string directory = tempDirectory("durable_graph_snapshot");
+            DirectedGraph<int, int> reference;
+            std::mt19937 random(2);
+            uint64_t snapshotSequence;
+            uint64_t sequence;
+            {
+                Durable graph(directory, SyncPolicy::None);
+                graph.setGroupSize(16);
+                mutate(graph, reference, random, 1500);
+                graph.checkpoint();
+                snapshotSequence = graph.getSequence();
+                mutate(graph, reference, random, 300);
+                graph.commit();
+                sequence = graph.getSequence();
+            }
+            Durable reopened(directory);
+            const auto& info = reopened.getRecoveryInfo();
+            if (summarize(reopened.getGraph()) != summarize(reference) || info.snapshotSequence != snapshotSequence ||
+                info.replayedRecords != sequence - snapshotSequence) {
+                throw std::runtime_error("Snapshot recovery lost or repeated changes");
+            }
+            // Автоматические снимки: после каждого остаются один снимок и журналы после него
+            reopened.setSnapshotInterval(100);
+            mutate(reopened, reference, random, 1000);
+            size_t files = std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+            if (files != 2) {
+                throw std::runtime_error("Old snapshots and logs were not removed");
+            }
+            std::filesystem::remove_all(directory);
+        });
 
-            // Ожидаемые компоненты
-            std::set<int> expectedComponent1 = {1};
-            std::set<int> expectedComponent2 = {2, 3, 4, 5};
+        runner.expectNoException("DurableGraph::Torn log tail is discarded", [&]() {
+            std::string directory = tempDirectory("durable_graph_torn");
+            DirectedGraph<int, int> reference;
+            std::mt19937 random(3);
+            {
+                Durable graph(directory);
+                mutate(graph, reference, random, 500);
+            }
+            // Недописанная запись, как при падении во время write
+            std::ofstream(lastLog(directory), std::ios::binary | std::ios::app) << std::string(13, '\x5a');
+            uint64_t sequence;
+            {
+                Durable graph(directory);
+                if (!graph.getRecoveryInfo().tornTail || summarize(graph.getGraph()) != summarize(reference)) {
+                    throw std::runtime_error("Torn record was not discarded");
+                }
+                mutate(graph, reference, random, 200);
+                sequence = graph.getSequence();
+            }
+            Durable reopened(directory);
+            if (reopened.getRecoveryInfo().tornTail || reopened.getSequence() != sequence ||
+                summarize(reopened.getGraph()) != summarize(reference)) {
+                throw std::runtime_error("Changes after a torn tail were lost");
+            }
+            std::filesystem::remove_all(directory);
+        });
 
+        runner.expectNoException("DurableGraph::Corrupted record stops replay", [&]() {
+            std::string directory = tempDirectory("durable_graph_corrupted");
+            {
+                Durable graph(directory);
+                for (int i = 0; i < 10; ++i) {
+                    graph.addEdge(i, i + 1, i);
+                }
+            }
+            // Порча пятой записи: восстанавливаются только первые четыре
+            std::string log = lastLog(directory);
+            std::fstream file(log, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(MutationLog<int, int>::kHeaderSize + 4 * MutationLog<int, int>::kRecordSize + 16);
+            file.put('\x7f');
+            file.close();
+            Durable reopened(directory);
+            if (reopened.getSequence() != 4 || !reopened.getRecoveryInfo().tornTail ||
+                reopened.getGraph().getVertexCount() != 5) {
+                throw std::runtime_error("Replay did not stop at the corrupted record");
+            }
+            std::filesystem::remove_all(directory);
+        });
 
-            if (component1 != expectedComponent1) {
-               throw std::runtime_error("Incorrect component 1.  Expected {1}");
+        runner.expectNoException("DurableGraph::Stray files are ignored", [&]() {
+            std::string directory = tempDirectory("durable_graph_stray");
+            {
+                Durable graph(directory);
+                graph.addEdge(1, 2, 3);
+                graph.checkpoint();
+                graph.addEdge(2, 3, 4);
+            }
+            // Совпадают с шаблоном имени по префиксу, суффиксу и длине, но номер не из цифр
+            std::ofstream(std::filesystem::path(directory) / "log-0000000000000000000x.wal") << "backup";
+            std::ofstream(std::filesystem::path(directory) / "snapshot-copy-of-snapshot-001.csr") << "backup";
+            Durable reopened(directory);
+            if (reopened.getSequence() != 2 || reopened.getGraph().getVertexCount() != 3) {
+                throw std::runtime_error("Stray files broke recovery");
             }
+            std::filesystem::remove_all(directory);
+        });
 
-             if (component2 != expectedComponent2) {
-               throw std::runtime_error("Incorrect component 2.  Expected {2, 3, 4, 5}");
+        runner.expectException<std::runtime_error>("DurableGraph::Different weight type", [&]() {
+            std::string directory = tempDirectory("durable_graph_types");
+            {
+                Durable graph(directory);
+                graph.addEdge(1, 2, 3);
+            }
+            try {
+                DurableGraph<double, int> reopened(directory);
+            } catch (...) {
+                std::filesystem::remove_all(directory);
+                throw;
+            }
+            std::filesystem::remove_all(directory);
+        });
+    }
+
+    void testVersionedGraph() {
+        TestRunner runner;
+        using Versioned = VersionedGraph<int, int>;
+        // Граф как множество вершин и мультимножество дуг (откуда, куда, вес)
+        using Summary = std::pair<std::set<int>, std::multiset<std::tuple<int, int, int>>>;
+        auto summarize = [](const CompressedGraph<int, int>& graph) {
+            Summary summary;
+            for (int v = 0; v < graph.getVertexCount(); ++v) {
+                summary.first.insert(graph.getId(v));
+                for (size_t i = 0; i < graph.getOutNeighbors(v).size(); ++i) {
+                    summary.second.insert({graph.getId(v), graph.getId(graph.getOutNeighbors(v)[i]), graph.getOutWeights(v)[i]});
+                }
+            }
+            return summary;
+        };
+        auto reverse = [](const CompressedGraph<int, int>& graph) {
+            std::multiset<std::tuple<int, int, int>> arcs;
+            for (int v = 0; v < graph.getVertexCount(); ++v) {
+                for (size_t i = 0; i < graph.getInNeighbors(v).size(); ++i) {
+                    arcs.insert({graph.getId(graph.getInNeighbors(v)[i]), graph.getId(v), graph.getInWeights(v)[i]});
+                }
+            }
+            return arcs;
+        };
+        auto mutate = [](Versioned& versioned, DirectedGraph<int, int>& reference, std::mt19937& random, int count,
+                         int idRange) {
+            for (int i = 0; i < count; ++i) {
+                int from = static_cast<int>(random() % idRange);
+                int to = static_cast<int>(random() % idRange);
+                switch (random() % 10) {
+                    case 0:
+                        versioned.addVertex(from);
+                        reference.createVertex(from);
+                        break;
+                    case 1:
+                        versioned.removeVertex(from);
+                        reference.removeVertex(reference.findVertex(from));
+                        break;
+                    case 2:
+                    case 3:
+                        versioned.removeEdge(from, to);
+                        reference.removeEdge(reference.findVertex(from), reference.findVertex(to));
+                        break;
+                    default: {
+                        int weight = static_cast<int>(random() % 5);
+                        versioned.addEdge(from, to, weight);
+                        reference.addEdge(reference.createVertex(from), reference.createVertex(to), weight);
+                    }
+                }
+            }
+        };
+
+        runner.expectNoException("VersionedGraph::Versions match the reference graph", [&]() {
+            Versioned graph;
+            DirectedGraph<int, int> reference;
+            std::mt19937 random(1);
+            // Небольшой диапазон идентификаторов дает вершины со степенью больше 64 (дерево в списке смежности)
+            for (int round = 0; round < 40; ++round) {
+                mutate(graph, reference, random, 500, round % 2 ? 30 : 300);
+                graph.commit();
+                auto snapshot = graph.snapshot();
+                auto compressed = snapshot.toCompressed();
+                auto expected = summarize(CompressedGraph<int, int>::fromGraph(&reference));
+                if (summarize(compressed) != expected || reverse(compressed) != expected.second ||
+                    snapshot.getEdgeCount() != expected.second.size() ||
+                    snapshot.getVertexCount() != static_cast<int>(expected.first.size())) {
+                    throw std::runtime_error("Snapshot differs from the reference graph");
+                }
+                auto copy = snapshot.toGraph();
+                if (summarize(CompressedGraph<int, int>::fromGraph(&copy)) != expected) {
+                    throw std::runtime_error("Snapshot copy differs from the reference graph");
+                }
+            }
+        });
+
+        runner.expectNoException("VersionedGraph::Pinned snapshots do not change", [&]() {
+            Versioned graph;
+            DirectedGraph<int, int> reference;
+            std::mt19937 random(2);
+            std::vector<Versioned::Snapshot> snapshots;
+            std::vector<Summary> expected;
+            for (int round = 0; round < 20; ++round) {
+                mutate(graph, reference, random, 300, 100);
+                uint64_t version = graph.commit();
+                snapshots.push_back(graph.snapshot());
+                expected.push_back(summarize(CompressedGraph<int, int>::fromGraph(&reference)));
+                if (snapshots.back().getVersion() != version) {
+                    throw std::runtime_error("Snapshot does not pin the committed version");
+                }
+            }
+            // Неопубликованные изменения снимкам не видны
+            graph.addEdge(1000, 1001, 1);
+            if (graph.snapshot().hasVertex(1000) || graph.getVertexCount() != static_cast<int>(reference.getVertexCount()) + 2) {
+                throw std::runtime_error("Uncommitted change is visible");
+            }
+            for (size_t i = 0; i < snapshots.size(); ++i) {
+                if (summarize(snapshots[i].toCompressed()) != expected[i]) {
+                    throw std::runtime_error("Pinned snapshot changed after later commits");
+                }
+            }
+            if (graph.getRetiredCount() == 0) {
+                throw std::runtime_error("Nodes read by pinned snapshots were not retained");
+            }
+            snapshots.clear();
+            graph.commit();
+            if (graph.getRetiredCount() != 0) {
+                throw std::runtime_error("Retired nodes were not reclaimed after snapshots were released");
+            }
+        });
+
+        runner.expectNoException("VersionedGraph::Lookups in a snapshot", [&]() {
+            Versioned graph;
+            graph.addEdge(1, 2, 5);
+            graph.addEdge(2, 3, 7);
+            graph.commit();
+            auto before = graph.snapshot();
+            graph.removeVertex(2);
+            graph.addVertex(4);
+            graph.commit();
+            auto after = graph.snapshot();
+            if (!before.hasVertex(2) || !before.hasEdge(1, 2) || before.getOutDegree(before.getIndex(2)) != 1 ||
+                after.hasVertex(2) || after.hasEdge(1, 2) || !after.hasVertex(4) || before.hasVertex(4) ||
+                after.getEdgeCount() != 0 || after.getVertexCount() != 3) {
+                throw std::runtime_error("Snapshot lookups see the wrong version");
+            }
+            // Повторно добавленная вершина возвращается на свой индекс
+            int index = before.getIndex(2);
+            graph.addEdge(2, 1, 9);
+            graph.commit();
+            auto again = graph.snapshot();
+            if (again.getIndex(2) != index || !again.hasEdge(2, 1) || again.getInDegree(again.getIndex(1)) != 1) {
+                throw std::runtime_error("Re-added vertex lost its index");
+            }
+        });
+
+        runner.expectNoException("VersionedGraph::Concurrent readers see consistent versions", [&]() {
+            // Каждая версия - цепочка 0 -> 1 -> ... -> k с весами, равными номеру версии
+            Versioned graph;
+            std::atomic<bool> done{false};
+            std::atomic<int> errors{0};
+            std::vector<std::thread> readers;
+            for (int r = 0; r < 3; ++r) {
+                readers.emplace_back([&]() {
+                    uint64_t lastVersion = 0;
+                    while (!done.load()) {
+                        auto snapshot = graph.snapshot();
+                        if (snapshot.getVersion() < lastVersion) ++errors;
+                        lastVersion = snapshot.getVersion();
+                        size_t edges = 0;
+                        for (int v = 0; v < snapshot.getIndexBound(); ++v) {
+                            snapshot.forEachOutArc(v, [&](int target, int weight) {
+                                edges += target == v + 1 && weight == static_cast<int>(lastVersion);
+                            });
+                        }
+                        if (edges != snapshot.getEdgeCount()) ++errors;
+                    }
+                });
+            }
+            for (int version = 1; version <= 300; ++version) {
+                for (int v = 0; v + 1 < version; ++v) {
+                    graph.removeEdge(v, v + 1);
+                    graph.addEdge(v, v + 1, version);
+                }
+                graph.addEdge(version - 1, version, version);
+                graph.commit();
             }
+            done.store(true);
+            for (auto& reader : readers) reader.join();
+            if (errors.load() != 0) {
+                throw std::runtime_error("Reader saw a torn or older version");
+            }
+        });
+
+        runner.expectException<std::invalid_argument>("VersionedGraph::Missing vertex", [&]() {
+            Versioned graph;
+            graph.addVertex(1);
+            graph.commit();
+            graph.snapshot().getIndex(2);
         });
     }
 
@@ -830,6 +3835,21 @@ namespace internal_tests {
             if (array.getByIndex(1) != 5) throw std::runtime_error("Incorrect element at index 1 after insertion.");
         });
 
+        // Тест геометрического роста при добавлении в конец
+        runner.expectNoException("testDynamicArray::Appending many elements", []() {
+            DynamicArray<int> array;
+            for (int i = 0; i < 100000; ++i) {
+                array.insertAt(array.getSize(), i);
+            }
+            if (array.getSize() != 100000 || array.getByIndex(99999) != 99999 || array.getCapacity() > 2 * 100000) {
+                throw std::runtime_error("Incorrect array after appends.");
+            }
+            array.reserve(200000);
+            if (array.getCapacity() != 200000 || array.getByIndex(12345) != 12345) {
+                throw std::runtime_error("Incorrect array after reserve.");
+            }
+        });
+
         // Тест исключений
         runner.expectException<std::invalid_argument>("testDynamicArray::Creation with negative size", []() {
             DynamicArray<int> array(-1);
@@ -1439,6 +4459,123 @@ namespace internal_tests {
         });
     }
 
+    void testObjectPool() {
+        TestRunner runner;
+
+        // 1. Создание и уничтожение объектов
+        runner.expectNoException("ObjectPool::create and destroy", []() {
+            ObjectPool<Student> pool;
+            const int dateOfBirth[] = {1, 1, 2000};
+            Student* student = pool.create("Ivan", "Ivanov", 1, dateOfBirth, 2);
+            if (student->getFirstName() != "Ivan" || pool.getCount() != 1) {
+                throw std::runtime_error("Object was not constructed in the pool.");
+            }
+            pool.destroy(student);
+            if (pool.getCount() != 0) {
+                throw std::runtime_error("Object was not returned to the pool.");
+            }
+        });
+
+        // 2. Освобожденные ячейки переиспользуются
+        runner.expectNoException("ObjectPool::free list reuse", []() {
+            ObjectPool<Vertex<int, int>> pool;
+            auto first = pool.create(1);
+            pool.destroy(first);
+            auto second = pool.create(2);
+            if (first != second) {
+                throw std::runtime_error("Freed slot was not reused.");
+            }
+            pool.destroy(second);
+        });
+
+        // 3. Рост слабов
+        runner.expectNoException("ObjectPool::slab growth", []() {
+            ObjectPool<Edge<int, int>> pool;
+            std::vector<Edge<int, int>*> edges;
+            for (int i = 0; i < 1000; ++i) {
+                edges.push_back(pool.create(nullptr, nullptr, i));
+            }
+            for (int i = 0; i < 1000; ++i) {
+                if (edges[i]->getWeight() != i) {
+                    throw std::runtime_error("Pooled object was overwritten.");
+                }
+            }
+            if (pool.getCount() != 1000 || pool.getCapacity() < 1000) {
+                throw std::runtime_error("Incorrect pool state.");
+            }
+        });
+
+        // 4. Граф владеет вершинами из createVertex
+        runner.expectNoException("ObjectPool::graph createVertex", []() {
+            DirectedGraph<int, int> graph;
+            auto v1 = graph.createVertex(1);
+            auto v2 = graph.createVertex(2);
+            graph.addVertex(new Vertex<int, int>(3));
+            graph.addEdge(v1, v2, 5);
+            graph.addEdge(v2, graph.getVertexById(3), 7);
+            if (!v1->isPooled() || graph.findVertex(3)->isPooled()) {
+                throw std::runtime_error("Only createVertex vertices should be pooled.");
+            }
+            if (graph.createVertex(1) != v1) {
+                throw std::runtime_error("createVertex should return the existing vertex.");
+            }
+            graph.removeEdge(v1, v2);
+            graph.removeVertex(v1);
+            if (graph.getVertices().getLength() != 2 || !graph.hasEdge(v2, graph.getVertexById(3))) {
+                throw std::runtime_error("Incorrect graph state after removal.");
+            }
+        });
+
+        // 5. Перемещение графа забирает вершины и пулы, исходный граф остается пустым и рабочим
+        runner.expectNoException("ObjectPool::graph move", []() {
+            DirectedGraph<int, int> source;
+            auto v1 = source.createVertex(1);
+            source.addEdge(v1, source.createVertex(2), 5);
+            source.addVertex(new Vertex<int, int>(3));
+            DirectedGraph<int, int> moved(std::move(source));
+            if (moved.getVertexCount() != 3 || moved.findVertex(1) != v1 || !moved.hasEdge(v1, moved.findVertex(2))) {
+                throw std::runtime_error("Moved graph lost its vertices.");
+            }
+            if (source.getVertexCount() != 0 || source.findVertex(1)) {
+                throw std::runtime_error("Moved-from graph should be empty.");
+            }
+            source.createVertex(7);
+            if (source.getVertexCount() != 1) {
+                throw std::runtime_error("Moved-from graph is not reusable.");
+            }
+        });
+    }
+
+    void testThreadPool() {
+        TestRunner runner;
+
+        runner.expectNoException("ThreadPool::parallelFor covers range once", []() {
+            ThreadPool pool(4);
+            std::vector<std::atomic<int>> hits(10000);
+            for (int round = 0; round < 3; ++round) {
+                pool.parallelFor(0, hits.size(), [&](size_t lo, size_t hi) {
+                    for (size_t i = lo; i < hi; ++i) {
+                        hits[i].fetch_add(1);
+                    }
+                }, 16);
+            }
+            for (auto& hit : hits) {
+                if (hit.load() != 3) {
+                    throw std::runtime_error("Index was not visited exactly once per round.");
+                }
+            }
+        });
+
+        runner.expectException<std::runtime_error>("ThreadPool::exception is propagated", []() {
+            ThreadPool pool(4);
+            pool.parallelFor(0, 1000, [](size_t lo, size_t hi) {
+                if (lo <= 500 && 500 < hi) {
+                    throw std::runtime_error("failure in block");
+                }
+            });
+        });
+    }
+
     void testGraphPath() {
         TestRunner runner;
 
@@ -20,6 +20,26 @@ namespace internal_tests {
     void testMSTAlgorithm();
     void testConnectedComponentsAlgorithm();
     void testStronglyConnectedComponentsAlgorithm();
+    void testIncrementalTopologicalOrder();
+    void testGraphBuilder();
+    void testBFSAlgorithm();
+    void testPageRankAlgorithm();
+    void testTriangleCountingAlgorithm();
+    void testKCoreAlgorithm();
+    void testBetweennessCentralityAlgorithm();
+    void testFloydWarshallAlgorithm();
+    void testBellmanFordAlgorithm();
+    void testMaxFlowAlgorithm();
+    void testBipartiteMatchingAlgorithm();
+    void testGraphColoringAlgorithm();
+    void testLouvainAlgorithm();
+    void testReachabilityIndex();
+    void testGraphGenerators();
+    void testEdgeStreaming();
+    void testMappedGraph();
+    void testGraphLoader();
+    void testDurableGraph();
+    void testVersionedGraph();
     void testHashTableDictionary();
     void testMutableArraySequence();
     void testDynamicArray();
@@ -28,5 +48,7 @@ namespace internal_tests {
     void testSharedPtr();
     void testUniquePtr();
     void testWeakPtr();
+    void testObjectPool();
+    void testThreadPool();
     void testGraphPath();
 }
\ No newline at end of file
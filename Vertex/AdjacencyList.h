@@ -0,0 +1,203 @@
+#ifndef ADJACENCYLIST_H
+#define ADJACENCYLIST_H
+
+#include "IEdge.h"
+#include "IVertex.h"
+#include "HashTable.h"
+#include "MutableArraySequence.h"
+
+template <typename TWeight, typename TIdentifier>
+class Edge;
+
+// Список инцидентных ребер одной вершины с одной стороны (исходящие или входящие).
+// Ребра всегда лежат подряд в массиве, поэтому обход не зависит от представления.
+// Каждое ребро (всегда Edge, как и в графах) помнит свою ячейку в списке, поэтому
+// удаление известного ребра - O(1) без поиска.
+// Пока ребер мало, поиск по соседу - линейный проход по массиву. Начиная с kIndexThreshold
+// ребер строится хеш-индекс "идентификатор соседа -> ячейка", и поиск/удаление становятся O(1)
+// в среднем. Удаление из проиндексированного списка переставляет на место удаленного ребра
+// последнее, поэтому порядок ребер после удалений не гарантируется.
+template <typename TWeight, typename TIdentifier>
+class AdjacencyList {
+private:
+    static constexpr int kIndexThreshold = 32;
+
+    // Ячейка одного из ребер к соседу и число ребер к нему (кратные ребра)
+    struct IndexEntry {
+        int slot = -1;
+        int count = 0;
+    };
+
+    using EdgePtr = IEdge<TWeight, TIdentifier>*;
+    using Index = HashTable<TIdentifier, IndexEntry>;
+
+    MutableArraySequence<EdgePtr> edges_;
+    Index* index_ = nullptr;
+    bool outgoing_; // соседом исходящего ребра является конец, входящего - начало
+
+    TIdentifier neighborId(EdgePtr edge) const {
+        return outgoing_ ? edge->getTo()->getId() : edge->getFrom()->getId();
+    }
+
+    int slotOf(EdgePtr edge) const {
+        return static_cast<Edge<TWeight, TIdentifier>*>(edge)->getSlot(outgoing_);
+    }
+
+    void place(int slot, EdgePtr edge) {
+        static_cast<Edge<TWeight, TIdentifier>*>(edge)->setSlot(outgoing_, slot);
+    }
+
+    void indexEdge(int slot) {
+        TIdentifier id = neighborId(edges_.get(slot));
+        if (index_->containsKey(id)) {
+            ++index_->get(id).count;
+        } else {
+            index_->add(id, IndexEntry{slot, 1});
+        }
+    }
+
+    void buildIndex() {
+        index_ = new Index(edges_.getLength() * 4);
+        for (int slot = 0; slot < edges_.getLength(); ++slot) {
+            indexEdge(slot);
+        }
+    }
+
+    void dropIndex() {
+        delete index_;
+        index_ = nullptr;
+    }
+
+    int scanSlot(TIdentifier id) const {
+        for (int slot = 0; slot < edges_.getLength(); ++slot) {
+            if (neighborId(edges_.get(slot)) == id) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    // Ячейка ребра к соседу с данным идентификатором, -1 если такого ребра нет
+    int findSlot(TIdentifier id) const {
+        if (index_) {
+            return index_->containsKey(id) ? index_->get(id).slot : -1;
+        }
+        return scanSlot(id);
+    }
+
+    void removeSlot(int slot) {
+        if (!index_) {
+            // Короткий список сохраняет порядок ребер
+            edges_.removeAt(slot);
+            for (int shifted = slot; shifted < edges_.getLength(); ++shifted) {
+                place(shifted, edges_.get(shifted));
+            }
+            return;
+        }
+
+        TIdentifier id = neighborId(edges_.get(slot));
+        int last = edges_.getLength() - 1;
+        if (slot != last) {
+            EdgePtr moved = edges_.get(last);
+            edges_.set(slot, moved);
+            place(slot, moved);
+            IndexEntry& movedEntry = index_->get(neighborId(moved));
+            if (movedEntry.slot == last) {
+                movedEntry.slot = slot;
+            }
+        }
+        edges_.removeAt(last);
+
+        IndexEntry& entry = index_->get(id);
+        if (--entry.count == 0) {
+            index_->remove(id);
+        } else if (entry.slot == slot && (slot == last || neighborId(edges_.get(slot)) != id)) {
+            // Удалено проиндексированное из кратных ребер - запоминаем оставшееся
+            entry.slot = scanSlot(id);
+        }
+
+        // Гистерезис, чтобы список на границе порога не перестраивал индекс на каждой операции
+        if (edges_.getLength() < kIndexThreshold / 2) {
+            dropIndex();
+        }
+    }
+
+public:
+    explicit AdjacencyList(bool outgoing) : outgoing_(outgoing) {}
+
+    AdjacencyList(const AdjacencyList& other) : edges_(other.edges_), outgoing_(other.outgoing_) {
+        if (other.index_) {
+            index_ = new Index(*other.index_);
+        }
+    }
+
+    AdjacencyList& operator=(const AdjacencyList& other) {
+        if (this != &other) {
+            edges_ = other.edges_;
+            outgoing_ = other.outgoing_;
+            dropIndex();
+            if (other.index_) {
+                index_ = new Index(*other.index_);
+            }
+        }
+        return *this;
+    }
+
+    ~AdjacencyList() {
+        dropIndex();
+    }
+
+    const MutableArraySequence<EdgePtr>& getEdges() const {
+        return edges_;
+    }
+
+    int getLength() const {
+        return edges_.getLength();
+    }
+
+    bool isIndexed() const {
+        return index_ != nullptr;
+    }
+
+    void reserve(int capacity) {
+        edges_.reserve(capacity);
+    }
+
+    void append(EdgePtr edge) {
+        place(edges_.getLength(), edge);
+        edges_.append(edge);
+        if (index_) {
+            indexEdge(edges_.getLength() - 1);
+        } else if (edges_.getLength() >= kIndexThreshold) {
+            buildIndex();
+        }
+    }
+
+    // Первое найденное ребро к соседу или nullptr
+    EdgePtr find(TIdentifier neighbor) const {
+        int slot = findSlot(neighbor);
+        return slot == -1 ? nullptr : edges_.get(slot);
+    }
+
+    bool contains(TIdentifier neighbor) const {
+        return findSlot(neighbor) != -1;
+    }
+
+    // Удаляет ребро по его ячейке, O(1) для проиндексированного списка
+    bool remove(EdgePtr edge) {
+        int slot = slotOf(edge);
+        if (slot < 0 || slot >= edges_.getLength() || edges_.get(slot) != edge) {
+            return false;
+        }
+        removeSlot(slot);
+        return true;
+    }
+
+    // Забывает все ребра разом; сами ребра и списки соседей не трогает
+    void clear() {
+        edges_.clear();
+        dropIndex();
+    }
+};
+
+#endif // ADJACENCYLIST_H
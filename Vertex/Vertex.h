@@ -3,31 +3,64 @@
 
 #include "IVertex.h"
 #include "IEdge.h"
+#include "AdjacencyList.h"
 
 template <typename TWeight, typename TIdentifier>
 class Vertex : public IVertex<TWeight, TIdentifier> {
 private:
     TIdentifier id_;
-    MutableArraySequence<IEdge<TWeight, TIdentifier>*> incomingEdges_;
-    MutableArraySequence<IEdge<TWeight, TIdentifier>*> outgoingEdges_;
+    AdjacencyList<TWeight, TIdentifier> incomingEdges_;
+    AdjacencyList<TWeight, TIdentifier> outgoingEdges_;
+    bool pooled_ = false; // создана в пуле графа (GraphBase::createVertex), а не через new
 
 public:
-    explicit Vertex(TIdentifier id) : id_(id) {}
+    explicit Vertex(TIdentifier id) : id_(id), incomingEdges_(false), outgoingEdges_(true) {}
     Vertex(const Vertex& other) : id_(other.id_), incomingEdges_(other.incomingEdges_), outgoingEdges_(other.outgoingEdges_) {}
     ~Vertex() override = default;
 
     TIdentifier getId() const override { return id_; }
     void setId(TIdentifier id) override { id_ = id; }
 
+    // Копия вершины в пул не попадает, поэтому флаг не копируется
+    bool isPooled() const { return pooled_; }
+    void markPooled() { pooled_ = true; }
+
 
     MutableArraySequence<IEdge<TWeight, TIdentifier>*> getIncomingEdges() const override {
-        return incomingEdges_;
+        return incomingEdges_.getEdges();
     }
 
     MutableArraySequence<IEdge<TWeight, TIdentifier>*> getOutgoingEdges() const override {
+        return outgoingEdges_.getEdges();
+    }
+
+    // Доступ к спискам без копирования
+    const AdjacencyList<TWeight, TIdentifier>& getIncomingList() const {
+        return incomingEdges_;
+    }
+
+    const AdjacencyList<TWeight, TIdentifier>& getOutgoingList() const {
         return outgoingEdges_;
     }
 
+    // Ребро в вершину / из вершины с данным идентификатором или nullptr
+    IEdge<TWeight, TIdentifier>* findOutgoingEdge(TIdentifier toId) const {
+        return outgoingEdges_.find(toId);
+    }
+
+    IEdge<TWeight, TIdentifier>* findIncomingEdge(TIdentifier fromId) const {
+        return incomingEdges_.find(fromId);
+    }
+
+    // Резервирование под известную степень, используется при пакетной сборке графа
+    void reserveIncomingEdges(int count) {
+        incomingEdges_.reserve(count);
+    }
+
+    void reserveOutgoingEdges(int count) {
+        outgoingEdges_.reserve(count);
+    }
+
     void addIncomingEdge(IEdge<TWeight, TIdentifier>* edge) {
         incomingEdges_.append(edge);
     }
@@ -36,28 +69,17 @@ public:
         outgoingEdges_.append(edge);
     }
 
-
     void removeIncomingEdge(IEdge<TWeight, TIdentifier>* edge) {
-        for (int i = 0; i < incomingEdges_.getLength(); i++)
-        {
-            if(incomingEdges_.get(i) == edge)
-            {
-                incomingEdges_.removeAt(i);
-                return;
-            }
-        }
+        incomingEdges_.remove(edge);
     }
 
-
     void removeOutgoingEdge(IEdge<TWeight, TIdentifier>* edge) {
-        for (int i = 0; i < outgoingEdges_.getLength(); i++)
-        {
-            if(outgoingEdges_.get(i) == edge)
-            {
-                outgoingEdges_.removeAt(i);
-                return;
-            }
-        }
+        outgoingEdges_.remove(edge);
+    }
+
+    void clearEdges() {
+        incomingEdges_.clear();
+        outgoingEdges_.clear();
     }
 };
 
@@ -18,7 +18,6 @@ private:
         TKey key;
         TElement element;
         bool occupied;
-        bool wasDeleted;
         Entry() : occupied(false) {}
     };
 
@@ -27,8 +26,15 @@ private:
     int capacity_;
     Hash hash_;
 
+    // std::hash для целых - тождественное отображение, и плотные идентификаторы вершин
+    // складывались бы в один сплошной кластер, по которому линейное пробирование идет до конца.
+    // Перемешивание битов (финализатор MurmurHash3) разбивает такие кластеры.
     int hashKey(const TKey& key) const {
-        return hash_(key) % capacity_;
+        unsigned long long mixed = static_cast<unsigned long long>(hash_(key));
+        mixed ^= mixed >> 33;
+        mixed *= 0xff51afd7ed558ccdULL;
+        mixed ^= mixed >> 33;
+        return static_cast<int>(mixed % static_cast<unsigned long long>(capacity_));
     }
 
     void resizeTable(int newCapacity) {
@@ -41,7 +47,7 @@ private:
         table_ = new Entry[capacity_];
 
         for (int i = 0; i < oldCapacity; ++i) {
-            if (oldTable[i].occupied && !oldTable[i].wasDeleted) {
+            if (oldTable[i].occupied) {
                 add(oldTable[i].key, oldTable[i].element);
             }
         }
@@ -52,8 +58,8 @@ private:
         int index = hashKey(key);
         int originalIndex = index;
 
-        while (table_[index].occupied || table_[index].wasDeleted) {
-            if (table_[index].occupied && table_[index].key == key) {
+        while (table_[index].occupied) {
+            if (table_[index].key == key) {
                 return index;
             }
             index = (index + 1) % capacity_;
@@ -101,6 +107,14 @@ public:
         delete[] table_;
     }
 
+    // Обмен содержимым без копирования элементов
+    void swap(HashTable& other) noexcept {
+        std::swap(table_, other.table_);
+        std::swap(count_, other.count_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(hash_, other.hash_);
+    }
+
     int getCount() const { return count_; }
     int getCapacity() const { return capacity_; }
     Entry* getTable() const { return table_; }
@@ -121,23 +135,26 @@ public:
         return table_[index].element;
     }
 
+    // Один проход пробирования вместо пары containsKey + get; nullptr, если ключа нет
+    const TElement* find(const TKey& key) const {
+        int index = findNode(key);
+        return index == -1 ? nullptr : &table_[index].element;
+    }
+
     void add(const TKey& key, const TElement& element) {
-        if (count_ >= capacity_ * 0.75) {
-            resizeTable(capacity_ * 2);
+        int index = findNode(key);
+        if (index != -1) {
+            table_[index].element = element;
+            return;
         }
 
-        int index = hashKey(key);
-        int originalIndex = index;
+        if (count_ + 1 > capacity_ * 0.75) {
+            resizeTable(capacity_ * 2);
+        }
 
+        index = hashKey(key);
         while (table_[index].occupied) {
-            if (table_[index].key == key) {
-                table_[index].element = element;
-                return;
-            }
             index = (index + 1) % capacity_;
-            if (index == originalIndex) {
-                resizeTable(capacity_ * 2);
-            }
         }
 
         table_[index].key = key;
@@ -152,21 +169,29 @@ public:
             throw std::runtime_error("Element not found");
         }
 
-        if (table_[index].occupied) {
-            table_[index].occupied = false;
-            table_[index].wasDeleted = true;
-            --count_;
+        // Удаление обратным сдвигом, без надгробий: записи из той же цепочки, которые могут
+        // стоять раньше, переносятся в освободившуюся ячейку. Иначе поиск отсутствующего ключа
+        // проходил бы через все надгробия кластера.
+        int hole = index;
+        int next = (hole + 1) % capacity_;
+        while (table_[next].occupied) {
+            int home = hashKey(table_[next].key);
+            bool homeAfterHole = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+            if (!homeAfterHole) {
+                table_[hole] = std::move(table_[next]);
+                hole = next;
+            }
+            next = (next + 1) % capacity_;
         }
+        table_[hole].occupied = false;
+        --count_;
     }
 
     void removeAll() {
         for (int i = 0; i < capacity_; ++i) {
-            if (table_[i].occupied && !table_[i].wasDeleted) {
-                table_[i].occupied = false;
-                table_[i].wasDeleted = true;
-                --count_;
-            }
+            table_[i].occupied = false;
         }
+        count_ = 0;
     }
 
     bool containsKey(const TKey& key) const {
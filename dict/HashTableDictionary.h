@@ -21,6 +21,8 @@ public:
     TElement get(const TKey& key) const override { return hashTable_.get(key); }
     TElement& get(const TKey& key) override { return hashTable_.get(key); }
 
+    const TElement* find(const TKey& key) const { return hashTable_.find(key); }
+
     void add(const TKey& key, const TElement& element) override {
         hashTable_.add(key, element);
     }
@@ -51,6 +53,16 @@ public:
 
     // Добавлен конструктор копирования
     HashTableDictionary(const HashTableDictionary& other) : hashTable_(other.hashTable_) {}
+
+    // Присваивание через копию и обмен: временный словарь (prvalue) забирается без копирования
+    HashTableDictionary& operator=(HashTableDictionary other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(HashTableDictionary& other) noexcept {
+        hashTable_.swap(other.hashTable_);
+    }
 };
 
 #endif // HASHTABLEDICTIONARY_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <InternalTests.h>
 #include <iostream>
 #include <TestRunner.h>
+#include <GraphBenchmarks.h>
 #include "GUI.h"
 
 void runAllTests() {
@@ -15,6 +16,12 @@ void runAllTests() {
     runner.runTestGroup("WeakPtr Tests", {
         internal_tests::testWeakPtr
     });
+    runner.runTestGroup("ObjectPool Tests", {
+        internal_tests::testObjectPool
+    });
+    runner.runTestGroup("ThreadPool Tests", {
+        internal_tests::testThreadPool
+    });
 
     runner.runTestGroup("LinkedList Tests", {
         internal_tests::testLinkedList
@@ -53,6 +60,26 @@ void runAllTests() {
         internal_tests::testDijkstraAlgorithm,
         internal_tests::testConnectedComponentsAlgorithm,
         internal_tests::testStronglyConnectedComponentsAlgorithm,
+        internal_tests::testIncrementalTopologicalOrder,
+        internal_tests::testGraphBuilder,
+        internal_tests::testBFSAlgorithm,
+        internal_tests::testPageRankAlgorithm,
+        internal_tests::testTriangleCountingAlgorithm,
+        internal_tests::testKCoreAlgorithm,
+        internal_tests::testBetweennessCentralityAlgorithm,
+        internal_tests::testFloydWarshallAlgorithm,
+        internal_tests::testBellmanFordAlgorithm,
+        internal_tests::testMaxFlowAlgorithm,
+        internal_tests::testBipartiteMatchingAlgorithm,
+        internal_tests::testGraphColoringAlgorithm,
+        internal_tests::testLouvainAlgorithm,
+        internal_tests::testReachabilityIndex,
+        internal_tests::testGraphGenerators,
+        internal_tests::testEdgeStreaming,
+        internal_tests::testMappedGraph,
+        internal_tests::testGraphLoader,
+        internal_tests::testDurableGraph,
+        internal_tests::testVersionedGraph,
     });
 
     runner.runTestGroup("HashTable Tests", {
@@ -66,10 +93,37 @@ void runAllTests() {
     runner.printResults();
 }
 
+void runAllBenchmarks() {
+    graph_benchmarks::benchmarkGraphConstruction();
+    graph_benchmarks::benchmarkEdgeInsertion();
+    graph_benchmarks::benchmarkBulkBuild();
+    graph_benchmarks::benchmarkHubEdges();
+    graph_benchmarks::benchmarkBFS();
+    graph_benchmarks::benchmarkPageRank();
+    graph_benchmarks::benchmarkTriangleCounting();
+    graph_benchmarks::benchmarkKCore();
+    graph_benchmarks::benchmarkBetweenness();
+    graph_benchmarks::benchmarkAllPairs();
+    graph_benchmarks::benchmarkNegativeWeights();
+    graph_benchmarks::benchmarkMaxFlow();
+    graph_benchmarks::benchmarkBipartiteMatching();
+    graph_benchmarks::benchmarkColoring();
+    graph_benchmarks::benchmarkLouvain();
+    graph_benchmarks::benchmarkReachability();
+    graph_benchmarks::benchmarkGeneration();
+    graph_benchmarks::benchmarkStreaming();
+    graph_benchmarks::benchmarkGraphFile();
+    graph_benchmarks::benchmarkGraphLoading();
+    graph_benchmarks::benchmarkDurableGraph();
+    graph_benchmarks::benchmarkVersionedGraph();
+}
+
 int main(int argc, char* argv[]) {
     int testMode = 1;
     if (testMode == 1) {
         runAllTests();
+    } else if (testMode == 2) {
+        runAllBenchmarks();
     } else {
         QApplication app(argc, argv);
         GraphVisualizer visualizer;